@@ -41,6 +41,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -146,6 +147,10 @@ public:
             0u, NP - 2u); // to generate a random index for the second decision vector
 
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                return pop;
+            }
             // 1 - Employed bees phase
             std::vector<unsigned>::size_type mi = 0u;
             for (decltype(NP) i = 1u; i < NP; ++i) {
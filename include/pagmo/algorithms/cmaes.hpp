@@ -45,6 +45,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -312,6 +313,13 @@ public:
         // ----------------------------------------------//
         Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(_(dim));
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- stop requested" << std::endl;
+                }
+                return pop;
+            }
             // 1 - We generate and evaluate lam new individuals
             for (decltype(lam) i = 0u; i < lam; ++i) {
                 // 1a - we create a randomly normal distributed vector
@@ -42,6 +42,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -176,6 +177,7 @@ public:
 
         // Some vectors used during evolution are declared.
         vector_double tmp(dim);                              // contains the mutated candidate
+        vector_double newfitness(prob.get_nf());             // contains the fitness of the mutated candidate
         std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
         std::uniform_int_distribution<vector_double::size_type> c_idx(
             0u, dim - 1u); // to generate a random index for the chromosome
@@ -196,6 +198,13 @@ public:
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- stop requested" << std::endl;
+                }
+                return pop;
+            }
             // Start of the loop through the population
             for (decltype(NP) i = 0u; i < NP; ++i) {
                 /*-----We select at random 5 indexes from the population---------------------------------*/
@@ -338,8 +347,8 @@ public:
                 // detail::force_bounds_reflection(tmp, lb, ub); // TODO: check if this choice is better
                 detail::force_bounds_random(tmp, lb, ub, m_e);
                 // b) how good?
-                auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
-                if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
+                prob.fitness(tmp, newfitness);    /* Evaluates tmp[] */
+                if (newfitness[0] <= fit[i][0]) { /* improved objective function value ? */
                     fit[i] = newfitness;
                     popnew[i] = tmp;
                     // updates the individual in pop (avoiding to recompute the objective function)
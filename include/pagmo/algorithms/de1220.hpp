@@ -42,6 +42,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -285,6 +286,13 @@ public:
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- stop requested" << std::endl;
+                }
+                return pop;
+            }
             // Start of the loop through the population
             for (decltype(NP) i = 0u; i < NP; ++i) {
                 /*-----We select at random 5 indexes from the population---------------------------------*/
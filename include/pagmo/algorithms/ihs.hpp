@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/types.hpp>                 // vector_double
 #include <pagmo/utils/generic.hpp>         // force_bounds_reflection
 #include <pagmo/utils/multi_objective.hpp> // select_best_N_mo
@@ -208,6 +209,10 @@ public:
 
         // Main loop
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                return pop;
+            }
             // 1 - We adjust the algorithm parameters (parameter control)
             const double ppar_cur = m_ppar_min + ((m_ppar_max - m_ppar_min) * gen) / m_gen;
             const double bw_cur = m_bw_max * std::exp(c * gen);
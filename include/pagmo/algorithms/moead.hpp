@@ -43,6 +43,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/decompose.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>         // kNN
 #include <pagmo/utils/multi_objective.hpp> // ideal
 
@@ -226,6 +227,10 @@ public:
 
         // Main MOEA/D loop --------------------------------------------------------------------------------------------
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                return pop;
+            }
             // 0 - Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
             if (m_verbosity > 0u) {
                 // Every m_verbosity generations print a log line
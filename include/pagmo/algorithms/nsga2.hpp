@@ -43,6 +43,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/decompose.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>         // uniform_real_from_range
 #include <pagmo/utils/multi_objective.hpp> // crowding_distance, etc..
 
@@ -163,12 +164,17 @@ public:
         std::vector<vector_double::size_type> best_idx(NP), shuffle1(NP), shuffle2(NP);
         vector_double::size_type parent1_idx, parent2_idx;
         vector_double child1(dim), child2(dim);
+        vector_double f1(prob.get_nf()), f2(prob.get_nf());
 
         std::iota(shuffle1.begin(), shuffle1.end(), 0u);
         std::iota(shuffle2.begin(), shuffle2.end(), 0u);
 
         // Main NSGA-II loop
         for (decltype(m_gen) gen = 1u; gen <= m_gen; gen++) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                return pop;
+            }
             // 0 - Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
             if (m_verbosity > 0u) {
                 // Every m_verbosity generations print a log line
@@ -244,8 +250,8 @@ public:
                 mutate(child2, pop);
                 // we use prob to evaluate the fitness so
                 // that its feval counter is correctly updated
-                auto f1 = prob.fitness(child1);
-                auto f2 = prob.fitness(child2);
+                prob.fitness(child1, f1);
+                prob.fitness(child2, f2);
                 popnew.push_back(child1, f1);
                 popnew.push_back(child2, f2);
 
@@ -257,8 +263,8 @@ public:
                 mutate(child2, pop);
                 // we use prob to evaluate the fitness so
                 // that its feval counter is correctly updated
-                f1 = prob.fitness(child1);
-                f2 = prob.fitness(child2);
+                prob.fitness(child1, f1);
+                prob.fitness(child2, f2);
                 popnew.push_back(child1, f1);
                 popnew.push_back(child2, f2);
             } // popnew now contains 2NP individuals
@@ -42,6 +42,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -326,7 +327,14 @@ public:
         /* --- Main PSO loop ---
          */
         // For each generation
+        // Set to true in case of cooperative cancellation.
+        bool stopped = false;
         for (decltype(m_max_gen) gen = 1u; gen <= m_max_gen; ++gen) {
+            // Cooperative cancellation: stop, and return the current positions.
+            if (stop_requested()) {
+                stopped = true;
+                break;
+            }
             best_fit_improved = false;
             // For each particle in the swarm
             for (decltype(swarm_size) p = 0u; p < swarm_size; ++p) {
@@ -458,7 +466,7 @@ public:
                 }
                 // We evaluate here the new individual fitness
                 // as to be able to update the global best in real time
-                fit[p] = prob.fitness(X[p]);
+                prob.fitness(X[p], fit[p]);
 
                 if (fit[p] <= lbfit[p]) {
                     // update the particle's previous best position
@@ -535,7 +543,11 @@ public:
             }
         } // end of main PSO loop
         if (m_verbosity) {
-            std::cout << "Exit condition -- generations = " << m_max_gen << std::endl;
+            if (stopped) {
+                std::cout << "Exit condition -- stop requested" << std::endl;
+            } else {
+                std::cout << "Exit condition -- generations = " << m_max_gen << std::endl;
+            }
         }
 
         // copy particles' positions & velocities back to the main population
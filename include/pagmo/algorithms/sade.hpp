@@ -41,6 +41,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -210,6 +211,7 @@ public:
 
         // Some vectors used during evolution are declared.
         vector_double tmp(dim);                              // contains the mutated candidate
+        vector_double newfitness(prob.get_nf());             // contains the fitness of the mutated candidate
         std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
         std::normal_distribution<double> n_dist(0., 1.);     // to generate a normally distributed number
         std::uniform_int_distribution<vector_double::size_type> c_idx(
@@ -255,6 +257,13 @@ public:
 
         // Main DE iterations
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- stop requested" << std::endl;
+                }
+                return pop;
+            }
             // Start of the loop through the population
             for (decltype(NP) i = 0u; i < NP; ++i) {
                 /*-----We select at random 5 indexes from the population---------------------------------*/
@@ -597,8 +606,8 @@ public:
                     }
                 }
                 // b) how good?
-                auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
-                if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
+                prob.fitness(tmp, newfitness);    /* Evaluates tmp[] */
+                if (newfitness[0] <= fit[i][0]) { /* improved objective function value ? */
                     fit[i] = newfitness;
                     popnew[i] = tmp;
                     // updates the individual in pop (avoiding to recompute the objective function)
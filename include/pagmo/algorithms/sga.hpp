@@ -48,6 +48,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp> // detail::force_bounds_stick
 
 namespace pagmo
@@ -330,6 +331,10 @@ public:
         double improvement; // stores the difference in fitness between parents and offsprings
         std::uniform_int_distribution<unsigned int> urng;
         for (decltype(m_gen) i = 1u; i <= m_gen; ++i) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                return pop;
+            }
             // 1 - if the problem is stochastic we change seed and re-evaluate the entire population
             if (prob.is_stochastic()) {
                 pop.get_problem().set_seed(urng(m_e));
@@ -45,6 +45,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/utils/generic.hpp>
 
 namespace pagmo
@@ -299,6 +300,13 @@ public:
         // HERE WE START THE JUICE OF THE ALGORITHM      //
         // ----------------------------------------------//
         for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
+            // Cooperative cancellation: return the current population.
+            if (stop_requested()) {
+                if (m_verbosity) {
+                    std::cout << "Exit condition -- stop requested" << std::endl;
+                }
+                return pop;
+            }
             // 0 -If the problem is stochastic change seed first
             if (prob.is_stochastic()) {
                 // change the problem seed. This is done via the population_set_seed method as prob.set_seed
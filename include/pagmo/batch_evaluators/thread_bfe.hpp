@@ -0,0 +1,290 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_BATCH_EVALUATORS_THREAD_BFE_HPP
+#define PAGMO_BATCH_EVALUATORS_THREAD_BFE_HPP
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pagmo/detail/make_unique.hpp>
+#include <pagmo/detail/thread_pool.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// The persistent state of a thread_bfe: the copies of the problem
+// the chunks of a batch are evaluated on.
+struct thread_bfe_state {
+    // Make sure that we have at least n up-to-date copies of p.
+    void setup(const problem &p, vector_double::size_type n)
+    {
+        const auto id = udp_id(p);
+        if (m_probs.size() && m_udp_id != id) {
+            // The problem has changed since the last evaluation, drop the stale copies.
+            m_probs.clear();
+        }
+        m_udp_id = id;
+        while (m_probs.size() < n) {
+            m_probs.push_back(p);
+        }
+    }
+    std::mutex m_mutex;
+    std::vector<problem> m_probs;
+    unsigned long long m_udp_id = 0;
+};
+} // namespace detail
+
+/// Threaded batch fitness evaluator.
+/**
+ * This class evaluates a batch of decision vectors (see problem::batch_fitness()) in parallel on multiple
+ * threads of execution. The batch is split into contiguous chunks, one per thread: the first chunk
+ * is evaluated on the input problem, the other chunks on copies of the input problem. The chunks are
+ * evaluated by the calling thread together with the worker threads of a thread pool: if the evaluator is
+ * invoked from within an island evolution, the pool running the evolution is used (so that evaluations
+ * nest into the same bounded set of threads), otherwise the pool shared process-wide by the islands is used.
+ * Since the calling thread takes part in the evaluation, the call never blocks waiting for busy workers.
+ *
+ * The copies of the problem are created on demand, and they are kept across calls
+ * to the evaluator: the copies are refreshed only when the input problem changes (that is, when a different
+ * problem is passed to the evaluator, or when the UDP of the input problem might have been modified via
+ * problem::extract() or problem::set_seed()). Copying a pagmo::thread_bfe does not copy the problem copies.
+ *
+ * Parallel evaluation is performed only if the problem provides at least the thread_safety::basic
+ * guarantee (see problem::get_thread_safety()). Otherwise, the batch is evaluated serially in the
+ * calling thread. Since each decision vector is evaluated independently, the output of the
+ * parallel evaluation is identical to the output of the serial evaluation.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    Concurrent invocations of the call operator on the same :cpp:class:`pagmo::thread_bfe` object
+ *    are safe, but they will be serialised.
+ *
+ * \endverbatim
+ */
+class thread_bfe
+{
+public:
+    /// Constructor.
+    /**
+     * @param n_threads the maximum number of threads that will be used in a batch evaluation (including
+     * the calling thread). If zero, the number of threads will be determined by
+     * <tt>std::thread::hardware_concurrency()</tt>.
+     *
+     * @throws unspecified any exception thrown by memory errors.
+     */
+    explicit thread_bfe(unsigned n_threads = 0u)
+        : m_n_threads(n_threads), m_state(detail::make_unique<detail::thread_bfe_state>())
+    {
+    }
+    /// Copy constructor.
+    /**
+     * Only the number of threads is copied: the new object starts with an empty pool.
+     *
+     * @param other the object to be copied.
+     *
+     * @throws unspecified any exception thrown by memory errors.
+     */
+    thread_bfe(const thread_bfe &other) : thread_bfe(other.m_n_threads) {}
+    /// Move constructor.
+    /**
+     * @param other the object to be moved.
+     *
+     * @throws unspecified any exception thrown by memory errors.
+     */
+    thread_bfe(thread_bfe &&other) : thread_bfe(other.m_n_threads) {}
+    /// Copy assignment.
+    /**
+     * Only the number of threads is copied: the pool of \p this is left untouched.
+     *
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     */
+    thread_bfe &operator=(const thread_bfe &other)
+    {
+        m_n_threads = other.m_n_threads;
+        return *this;
+    }
+    /// Move assignment.
+    /**
+     * Equivalent to the copy assignment operator.
+     *
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     */
+    thread_bfe &operator=(thread_bfe &&other)
+    {
+        return *this = static_cast<const thread_bfe &>(other);
+    }
+    /// Call operator.
+    /**
+     * This operator will compute the fitnesses of the decision vectors stored contiguously in \p dvs,
+     * with the same semantics as problem::batch_fitness(). If \p p provides at least the thread_safety::basic
+     * guarantee and the batch contains more than one decision vector, the evaluation will be split in chunks
+     * among the calling thread and the worker threads (the first chunk is evaluated on \p p, each other chunk on
+     * its own copy of \p p). The fitness evaluation counter of \p p is increased by the number of decision vectors
+     * in \p dvs once all the threads have finished. If an exception is raised, the fitness evaluation counter of \p p
+     * will account only for the first chunk of \p dvs (if its evaluation succeeded).
+     *
+     * @param p the problem that will be used to evaluate \p dvs.
+     * @param dvs the input batch of decision vectors.
+     *
+     * @return the fitnesses of the decision vectors in \p dvs.
+     *
+     * @throws std::invalid_argument if the length of \p dvs is not a multiple of the dimension of \p p,
+     * or if the total length of the fitness vectors would overflow.
+     * @throws unspecified any exception thrown by:
+     * - problem::batch_fitness() (if an exception is raised by multiple threads, only one of the
+     *   exceptions will be re-thrown),
+     * - the copy constructor of pagmo::problem,
+     * - threading primitives,
+     * - memory errors in standard containers.
+     */
+    vector_double operator()(problem &p, const vector_double &dvs) const
+    {
+        vector_double retval;
+        (*this)(p, dvs, retval);
+        return retval;
+    }
+    /// Call operator (in-place version).
+    /**
+     * This operator is equivalent to the other call operator, but the fitnesses are written into the
+     * caller-owned vector \p fvs (which will be resized to the number of decision vectors in \p dvs times
+     * the fitness dimension of \p p), with the same semantics as
+     * problem::batch_fitness(const vector_double &, vector_double &) const. The decision vectors are read
+     * directly from \p dvs, and each thread writes directly into its own portion of \p fvs.
+     *
+     * @param p the problem that will be used to evaluate \p dvs.
+     * @param dvs the input batch of decision vectors.
+     * @param fvs the output batch of fitness vectors.
+     *
+     * @throws unspecified any exception thrown by the other call operator.
+     */
+    void operator()(problem &p, const vector_double &dvs, vector_double &fvs) const
+    {
+        using size_type = vector_double::size_type;
+        const auto nx = p.get_nx();
+        const auto nf = p.get_nf();
+        const auto n_dvs = detail::check_batch_dvs(dvs, nx, nf);
+        const auto n_workers = std::min(static_cast<size_type>(get_n_threads()), n_dvs);
+        if (p.get_thread_safety() == thread_safety::none || n_workers < 2u) {
+            // Serial evaluation in the calling thread.
+            p.batch_fitness(dvs, fvs);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_state->m_mutex);
+        // Create or refresh the copies of the problem in the calling thread,
+        // so that p itself is never accessed concurrently.
+        m_state->setup(p, n_workers - 1u);
+        fvs.resize(n_dvs * nf);
+        // Chunk i contains the decision vectors in the range [begin, end), with the chunk sizes
+        // differing at most by one.
+        const auto chunk_size = n_dvs / n_workers, chunk_rem = n_dvs % n_workers;
+        // Each chunk is evaluated directly from dvs into its own portion of fvs.
+        auto eval_chunk = [&dvs, &fvs, nx, nf, chunk_size, chunk_rem](const problem &prob, size_type i) {
+            const auto begin = i * chunk_size + std::min(i, chunk_rem);
+            const auto size = chunk_size + (i < chunk_rem ? 1u : 0u);
+            detail::batch_fitness_range(prob, dvs.data() + begin * nx, size, fvs.data() + begin * nf);
+        };
+        // NOTE: nest into the pool of the calling thread, if any.
+        auto pool = detail::thread_pool::current();
+        if (!pool) {
+            pool = detail::thread_pool::shared().get();
+        }
+        auto &probs = m_state->m_probs;
+        pool->run_batch(
+            n_workers, [&p, &probs, &eval_chunk](size_type i) { eval_chunk(i ? probs[i - 1u] : p, i); },
+            n_workers - 1u);
+        // Account for the evaluations performed by the workers.
+        p.increment_fevals(n_dvs - chunk_size - (chunk_rem ? 1u : 0u));
+    }
+    /// Number of threads.
+    /**
+     * @return the maximum number of threads that will be used in a batch evaluation, as established
+     * upon construction (or by <tt>std::thread::hardware_concurrency()</tt>, if zero was passed to the
+     * constructor). The return value is never zero.
+     */
+    unsigned get_n_threads() const
+    {
+        if (m_n_threads) {
+            return m_n_threads;
+        }
+        const auto hc = std::thread::hardware_concurrency();
+        return hc ? hc : 1u;
+    }
+    /// Name of the evaluator.
+    /**
+     * @return <tt>"Multi-threaded batch fitness evaluator"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Multi-threaded batch fitness evaluator";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the maximum number of threads used by the evaluator.
+     */
+    std::string get_extra_info() const
+    {
+        return "\tNumber of threads: " + std::to_string(get_n_threads());
+    }
+    /// Object serialization
+    /**
+     * This method will save/load \p this into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the number of threads.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_n_threads);
+    }
+
+private:
+    unsigned m_n_threads;
+    std::unique_ptr<detail::thread_bfe_state> m_state;
+};
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,88 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_BATCH_KERNEL_HPP
+#define PAGMO_DETAIL_BATCH_KERNEL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+namespace detail
+{
+
+// Number of decision vectors processed at the same time by the batch fitness kernels of the
+// test problems. With 8 doubles per block, the innermost loops of the kernels map onto
+// full AVX-512 registers (or onto two AVX2/four SSE2 registers).
+constexpr std::size_t batch_kernel_width = 8u;
+
+// Batch fitness driver for single-objective problems. The decision vectors in dvs (stored contiguously,
+// nx components each) are processed in blocks of batch_kernel_width: each block is transposed into a
+// structure-of-arrays tile, in which the i-th components of all the decision vectors of the block are
+// contiguous, and the kernel k is invoked as
+//
+// k(tile, nx, out)
+//
+// writing the batch_kernel_width fitness values of the block into out. The kernels are written as loops over
+// the components, containing loops over the block which the compiler can vectorize for the target
+// instruction set. The last block is padded with copies of its last decision vector.
+//
+// NOTE: the kernels must perform, for each decision vector, the same floating-point operations in the same order
+// as the scalar fitness() of their problems, so that the results of the two paths are bitwise identical.
+// Only value-changing optimisations (e.g., -ffast-math or contraction into FMAs performed differently
+// in the two paths) can break this guarantee.
+template <typename Kernel>
+inline vector_double batch_kernel_fitness(const vector_double &dvs, vector_double::size_type nx, const Kernel &k)
+{
+    constexpr auto w = batch_kernel_width;
+    assert(nx && dvs.size() % nx == 0u);
+    const auto n_dvs = dvs.size() / nx;
+    vector_double retval(n_dvs), tile(nx * w);
+    double out[w];
+    for (decltype(dvs.size()) b = 0; b < n_dvs; b += w) {
+        const auto n_block = std::min<decltype(dvs.size())>(w, n_dvs - b);
+        for (std::size_t l = 0; l < w; ++l) {
+            const auto src = dvs.data() + (b + std::min<decltype(dvs.size())>(l, n_block - 1u)) * nx;
+            for (decltype(dvs.size()) i = 0; i < nx; ++i) {
+                tile[i * w + l] = src[i];
+            }
+        }
+        k(tile.data(), nx, out);
+        std::copy(out, out + n_block, retval.data() + b);
+    }
+    return retval;
+}
+
+} // namespace detail
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,75 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_CEC_TABLES_HPP
+#define PAGMO_DETAIL_CEC_TABLES_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+namespace detail
+{
+
+// The constant data of a CEC problem instance: the rotation matrices, the shift vectors and,
+// for the hybrid and composition functions, the shuffle vectors.
+struct cec_tables {
+    vector_double rotation;
+    vector_double shift;
+    std::vector<int> shuffle;
+};
+
+// Get the tables of the instance (prob_id, dim) of the test suite identified by Tag. The tables
+// are built with f() only if they are not already in use by another instance: all the instances with
+// the same id and dimension (and, in particular, all the copies of an instance) share the same read-only
+// tables, which are released when the last instance referring to them is destroyed.
+template <typename Tag, typename F>
+inline std::shared_ptr<const cec_tables> cec_shared_tables(unsigned prob_id, unsigned dim, F &&f)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<unsigned, unsigned>, std::weak_ptr<const cec_tables>> store;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &wp = store[std::make_pair(prob_id, dim)];
+    auto retval = wp.lock();
+    if (!retval) {
+        retval = std::make_shared<const cec_tables>(std::forward<F>(f)());
+        wp = retval;
+    }
+    return retval;
+}
+
+} // namespace detail
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,129 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_CEC_WORKSPACE_HPP
+#define PAGMO_DETAIL_CEC_WORKSPACE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace pagmo
+{
+namespace detail
+{
+
+// Scratch memory for the evaluation of the functions of the CEC test suites (which, in the original
+// C code, is stored in global variables). A workspace is created for each fitness evaluation (or batch of
+// fitness evaluations), so that the evaluation does not modify the state of the problem.
+//
+// The workspace can also carry the precomputed result of the first rotation performed by an evaluation
+// (see set_hint()). The hint is checked (and consumed) by the next rotation: it is used only if the matrix and
+// the input vector of the rotation are bitwise identical to the ones of the hint, so that a wrong hint can only
+// cost performance.
+struct cec_workspace {
+    explicit cec_workspace(unsigned nx) : y(nx), z(nx) {}
+    // Set the hint: the rotation of the vector in (of size nx) by the matrix mr is out.
+    void set_hint(const double *mr, const double *in, const double *out)
+    {
+        hint_mr = mr;
+        hint_in = in;
+        hint_out = out;
+    }
+    // Consume the hint, if any, for the rotation of x by mr. If the hint matches, its result is
+    // written to xrot and true is returned.
+    bool use_hint(const double *x, double *xrot, unsigned nx, const double *mr)
+    {
+        if (!hint_mr) {
+            return false;
+        }
+        const bool match = mr == hint_mr && !std::memcmp(x, hint_in, nx * sizeof(double));
+        hint_mr = nullptr;
+        if (match) {
+            std::copy(hint_out, hint_out + nx, xrot);
+        }
+        return match;
+    }
+    std::vector<double> y;
+    std::vector<double> z;
+    const double *hint_mr = nullptr;
+    const double *hint_in = nullptr;
+    const double *hint_out = nullptr;
+};
+
+// Number of decision vectors rotated together in the batch fitness evaluation of the CEC test suites.
+constexpr unsigned cec_rotation_block = 16u;
+
+// Rotate the n_p vectors (of size nx) stored contiguously in in by the row-major matrix mr, writing the result
+// into out. This is the matrix-matrix product out = in * mr^T, blocked so that a tile of 4 rows of mr stays in cache
+// while it is applied to all the vectors, and computed in register tiles of 4 vectors by 4 rows of mr so that each
+// element loaded from memory is used 4 times. Each element of the result is accumulated over the columns in
+// increasing order starting from zero, exactly as in the scalar rotation of the CEC codes, so that the results are
+// bitwise identical.
+inline void cec_rotate_block(const double *in, double *out, unsigned nx, unsigned n_p, const double *mr)
+{
+    constexpr unsigned t = 4u;
+    for (unsigned i0 = 0; i0 < nx; i0 += t) {
+        const auto ni = std::min(t, nx - i0);
+        for (unsigned p0 = 0; p0 < n_p; p0 += t) {
+            const auto np = std::min(t, n_p - p0);
+            if (ni == t && np == t) {
+                const double *x0 = in + p0 * nx, *x1 = x0 + nx, *x2 = x1 + nx, *x3 = x2 + nx;
+                const double *m0 = mr + i0 * nx, *m1 = m0 + nx, *m2 = m1 + nx, *m3 = m2 + nx;
+                double acc[t][t] = {};
+                for (unsigned j = 0; j < nx; ++j) {
+                    const double xs[t] = {x0[j], x1[j], x2[j], x3[j]}, ms[t] = {m0[j], m1[j], m2[j], m3[j]};
+                    for (unsigned a = 0; a < t; ++a) {
+                        for (unsigned b = 0; b < t; ++b) {
+                            acc[a][b] = acc[a][b] + xs[a] * ms[b];
+                        }
+                    }
+                }
+                for (unsigned a = 0; a < t; ++a) {
+                    std::copy(acc[a], acc[a] + t, out + (p0 + a) * nx + i0);
+                }
+            } else {
+                for (unsigned a = 0; a < np; ++a) {
+                    for (unsigned b = 0; b < ni; ++b) {
+                        double acc = 0;
+                        for (unsigned j = 0; j < nx; ++j) {
+                            acc = acc + in[(p0 + a) * nx + j] * mr[(i0 + b) * nx + j];
+                        }
+                        out[(p0 + a) * nx + i0 + b] = acc;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,154 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_MIGRATION_UTILS_HPP
+#define PAGMO_DETAIL_MIGRATION_UTILS_HPP
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// The number of individuals a migration policy operates on. It can be
+// expressed either as an absolute number (integral constructor) or as
+// a fraction of the population size (floating-point constructor).
+class migr_rate
+{
+public:
+    template <typename T, enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value, int> = 0>
+    explicit migr_rate(T n) : m_is_fraction(false), m_fraction(0.), m_n(0u)
+    {
+        if (n < T(0)) {
+            pagmo_throw(std::invalid_argument,
+                        "The number of individuals to migrate must be non-negative, but a value of "
+                            + std::to_string(n) + " was provided instead");
+        }
+        if (static_cast<unsigned long long>(n) > std::numeric_limits<population::size_type>::max()) {
+            pagmo_throw(std::invalid_argument, "The number of individuals to migrate is too large: a value of "
+                                                   + std::to_string(n) + " was provided");
+        }
+        m_n = static_cast<population::size_type>(n);
+    }
+    template <typename T, enable_if_t<std::is_floating_point<T>::value, int> = 0>
+    explicit migr_rate(T x) : m_is_fraction(true), m_fraction(static_cast<double>(x)), m_n(0u)
+    {
+        if (!std::isfinite(m_fraction) || m_fraction < 0. || m_fraction > 1.) {
+            pagmo_throw(std::invalid_argument,
+                        "The fractional migration rate must be in the [0, 1] range, but a value of "
+                            + std::to_string(m_fraction) + " was provided instead");
+        }
+    }
+    // Number of individuals, given the size of a population.
+    population::size_type get(population::size_type pop_size) const
+    {
+        if (m_is_fraction) {
+            return static_cast<population::size_type>(std::floor(m_fraction * static_cast<double>(pop_size)));
+        }
+        return m_n < pop_size ? m_n : pop_size;
+    }
+    std::string get_extra_info() const
+    {
+        if (m_is_fraction) {
+            return "\tFractional migration rate: " + std::to_string(m_fraction) + "\n";
+        }
+        return "\tAbsolute migration rate: " + std::to_string(m_n) + "\n";
+    }
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_is_fraction, m_fraction, m_n);
+    }
+
+private:
+    bool m_is_fraction;
+    double m_fraction;
+    population::size_type m_n;
+};
+
+// Extract the individuals at the positions idx of pop.
+inline individuals_group_t extract_individuals(const population &pop,
+                                               const std::vector<vector_double::size_type> &idx)
+{
+    individuals_group_t retval;
+    std::get<0>(retval).reserve(idx.size());
+    std::get<1>(retval).reserve(idx.size());
+    std::get<2>(retval).reserve(idx.size());
+    for (auto i : idx) {
+        std::get<0>(retval).push_back(pop.get_ID()[i]);
+        std::get<1>(retval).push_back(pop.get_x()[i]);
+        std::get<2>(retval).push_back(pop.get_f()[i]);
+    }
+    return retval;
+}
+
+// Check that inds is a well-formed group of individuals for the problem prob.
+inline void check_individuals_group(const individuals_group_t &inds, const problem &prob, const std::string &ctx)
+{
+    const auto n = std::get<0>(inds).size();
+    if (std::get<1>(inds).size() != n || std::get<2>(inds).size() != n) {
+        pagmo_throw(std::invalid_argument,
+                    "Inconsistent group of individuals detected " + ctx + ": the number of IDs is "
+                        + std::to_string(n) + ", the number of decision vectors is "
+                        + std::to_string(std::get<1>(inds).size()) + " and the number of fitness vectors is "
+                        + std::to_string(std::get<2>(inds).size()) + " (the three numbers must be equal)");
+    }
+    for (decltype(std::get<0>(inds).size()) i = 0; i < n; ++i) {
+        if (std::get<1>(inds)[i].size() != prob.get_nx()) {
+            pagmo_throw(std::invalid_argument,
+                        "Invalid group of individuals detected " + ctx + ": a decision vector of size "
+                            + std::to_string(std::get<1>(inds)[i].size())
+                            + " was found, but the problem's dimension is " + std::to_string(prob.get_nx()));
+        }
+        if (std::get<2>(inds)[i].size() != prob.get_nf()) {
+            pagmo_throw(std::invalid_argument,
+                        "Invalid group of individuals detected " + ctx + ": a fitness vector of size "
+                            + std::to_string(std::get<2>(inds)[i].size())
+                            + " was found, but the problem's fitness dimension is " + std::to_string(prob.get_nf()));
+        }
+    }
+}
+
+} // namespace detail
+
+} // namespace pagmo
+
+#endif
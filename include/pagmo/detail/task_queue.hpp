@@ -26,9 +26,12 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+
 #ifndef PAGMO_TASK_QUEUE_HPP
 #define PAGMO_TASK_QUEUE_HPP
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <functional>
 #include <future>
@@ -36,9 +39,9 @@ see https://www.gnu.org/licenses/. */
 #include <mutex>
 #include <queue>
 #include <stdexcept>
-#include <thread>
 #include <utility>
 
+#include <pagmo/detail/thread_pool.hpp>
 #include <pagmo/exceptions.hpp>
 
 namespace pagmo
@@ -47,43 +50,15 @@ namespace pagmo
 namespace detail
 {
 
+// A FIFO queue of tasks executed one at a time on a thread_pool.
+// NOTE: the queue does not own a thread: whenever it has tasks to run, it submits
+// to the pool a job consuming a single task, which re-submits itself if more tasks
+// are available. Thus many queues can share the same (bounded) pool, with the tasks
+// of each queue still being executed serially and in order.
 struct task_queue {
-    task_queue() : m_stop(false)
+    explicit task_queue(std::shared_ptr<thread_pool> pool = thread_pool::shared())
+        : m_pool(std::move(pool)), m_stop(false), m_active(false)
     {
-        m_thread = std::thread([this]() {
-            try {
-                while (true) {
-                    std::unique_lock<std::mutex> lock(this->m_mutex);
-                    while (!this->m_stop && this->m_tasks.empty()) {
-                        // Need to wait for something to happen only if the task
-                        // list is empty and we are not stopping.
-                        // NOTE: wait will be noexcept in C++14.
-                        this->m_cond.wait(lock);
-                    }
-                    if (this->m_stop && this->m_tasks.empty()) {
-                        // If the stop flag was set, and we do not have more tasks,
-                        // just exit.
-                        break;
-                    }
-                    // NOTE: move constructor of std::function could throw, unfortunately.
-                    std::function<void()> task(std::move(this->m_tasks.front()));
-                    this->m_tasks.pop();
-                    lock.unlock();
-                    task();
-                }
-                // LCOV_EXCL_START
-            } catch (...) {
-                // The errors we could get here are:
-                // - threading primitives,
-                // - move-construction of std::function,
-                // - queue popping (I guess unlikely, as the destructor of std::function
-                //   is noexcept).
-                // In any case, not much that can be done to recover from this, better to abort.
-                // NOTE: logging candidate.
-                std::abort();
-                // LCOV_EXCL_STOP
-            }
-        });
     }
     ~task_queue()
     {
@@ -107,41 +82,105 @@ struct task_queue {
         // - std::function (in m_tasks) gives the uniform type interface via type erasure.
         auto task = std::make_shared<p_task_type>(std::forward<F>(f));
         std::future<void> res = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            if (m_stop) {
-                // Enqueueing is not allowed if the queue is stopped.
-                pagmo_throw(std::runtime_error, "cannot enqueue task while the task queue is stopping");
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_stop) {
+            // Enqueueing is not allowed if the queue is stopped.
+            pagmo_throw(std::runtime_error, "cannot enqueue task while the task queue is stopping");
+        }
+        m_tasks.push([task]() { (*task)(); });
+        if (!m_active) {
+            try {
+                schedule();
+                // LCOV_EXCL_START
+            } catch (...) {
+                m_tasks.pop();
+                throw;
+                // LCOV_EXCL_STOP
             }
-            m_tasks.push([task]() { (*task)(); });
         }
-        // NOTE: notify_one is noexcept.
-        m_cond.notify_one();
         return res;
     }
+    // Change the pool the tasks are run on. This will first wait
+    // for the tasks currently in the queue to be consumed.
+    void set_pool(std::shared_ptr<thread_pool> pool)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        wait_idle(lock);
+        m_pool = std::move(pool);
+    }
     // NOTE: we call this only from dtor, it is here in order to be able to test it.
     // So the exception handling in dtor will suffice, keep it in mind if things change.
     void stop()
     {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stop = true;
+        wait_idle(lock);
+    }
+
+private:
+    // Wait for the tasks in the queue to be consumed. If we are running
+    // inside a worker of a pool, help it in the meantime.
+    // NOTE: the task being completed does not imply that the queue is idle,
+    // hence the waiting on m_active.
+    void wait_idle(std::unique_lock<std::mutex> &lock)
+    {
+        auto pool = thread_pool::current();
+        while (m_active) {
+            if (pool) {
+                lock.unlock();
+                const auto ran = pool->try_run_one();
+                lock.lock();
+                if (!ran && m_active) {
+                    m_cond.wait_for(lock, std::chrono::milliseconds(1));
+                }
+            } else {
+                m_cond.wait(lock);
+            }
+        }
+    }
+    // Submit to the pool a job running the first task in the queue.
+    // NOTE: this must be called with m_mutex locked.
+    void schedule()
+    {
+        m_pool->submit([this]() { this->run_one(); });
+        m_active = true;
+    }
+    void run_one()
+    {
+        std::function<void()> task;
         {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            if (m_stop) {
-                // Already stopped.
-                return;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        // NOTE: this cannot throw, as exceptions are captured in the future.
+        task();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty()) {
+            m_active = false;
+            // NOTE: notify while holding the lock, as stop() might destroy
+            // this object as soon as it sees m_active set to false.
+            m_cond.notify_all();
+        } else {
+            try {
+                schedule();
+                // LCOV_EXCL_START
+            } catch (...) {
+                // NOTE: logging candidate, we cannot report the error to anyone.
+                std::abort();
+                // LCOV_EXCL_STOP
             }
-            m_stop = true;
         }
-        // Notify the thread that queue has been stopped, wait for it
-        // to consume the remaining tasks and exit.
-        m_cond.notify_one();
-        m_thread.join();
     }
+
     // Data members.
+    std::shared_ptr<thread_pool> m_pool;
     bool m_stop;
+    // Whether a job of this queue is pending in the pool or running.
+    bool m_active;
     std::condition_variable m_cond;
     std::mutex m_mutex;
     std::queue<std::function<void()>> m_tasks;
-    std::thread m_thread;
 };
 } // namespace detail
 } // namespace pagmo
@@ -0,0 +1,340 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_DETAIL_THREAD_POOL_HPP
+#define PAGMO_DETAIL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/make_unique.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// A bounded pool of worker threads with work stealing.
+//
+// Each worker owns a deque of tasks: tasks submitted by a worker with fifo == false are pushed to the back
+// of its own deque and popped back LIFO (this is what nested parallelism uses), while all the other tasks go
+// into a global FIFO queue. An idle worker will first look into its own deque, then into the global queue,
+// and then it will try to steal from the front of the deques of the other workers.
+//
+// Tasks are not supposed to throw: if they do, the program is aborted.
+class thread_pool
+{
+    // Per-thread information: the pool the calling thread is a worker of (if any), and its index.
+    struct worker_info {
+        thread_pool *pool = nullptr;
+        unsigned idx = 0;
+    };
+    static worker_info &this_worker()
+    {
+        static thread_local worker_info info;
+        return info;
+    }
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+public:
+    // Init with n workers. If n is zero, the number of workers is std::thread::hardware_concurrency().
+    explicit thread_pool(unsigned n = 0u) : m_stop(false), m_pending(0)
+    {
+        if (!n) {
+            n = std::thread::hardware_concurrency();
+        }
+        n = n ? n : 1u;
+        for (auto i = 0u; i < n; ++i) {
+            m_queues.push_back(make_unique<worker_queue>());
+        }
+        try {
+            for (auto i = 0u; i < n; ++i) {
+                m_threads.emplace_back([this, i]() { this->worker_loop(i); });
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+            stop();
+            throw;
+            // LCOV_EXCL_STOP
+        }
+    }
+    thread_pool(const thread_pool &) = delete;
+    thread_pool(thread_pool &&) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+    thread_pool &operator=(thread_pool &&) = delete;
+    // NOTE: the destructor will wait for all the pending tasks to be completed.
+    // It must not be invoked from one of the pool's workers.
+    ~thread_pool()
+    {
+        stop();
+    }
+    // Number of workers.
+    unsigned size() const
+    {
+        return static_cast<unsigned>(m_threads.size());
+    }
+    // The process-wide pool, sized to the hardware.
+    static const std::shared_ptr<thread_pool> &shared()
+    {
+        static const std::shared_ptr<thread_pool> retval = std::make_shared<thread_pool>();
+        return retval;
+    }
+    // The pool the calling thread belongs to (null if the calling thread is not a worker).
+    static thread_pool *current()
+    {
+        return this_worker().pool;
+    }
+    // Submit a task.
+    void submit(std::function<void()> f, bool fifo = true)
+    {
+        const auto &w = this_worker();
+        if (!fifo && w.pool == this) {
+            std::lock_guard<std::mutex> lock(m_queues[w.idx]->mutex);
+            m_queues[w.idx]->tasks.push_back(std::move(f));
+        } else {
+            std::lock_guard<std::mutex> lock(m_global.mutex);
+            m_global.tasks.push_back(std::move(f));
+        }
+        {
+            // NOTE: increase the counter while holding the sleep mutex,
+            // so that the wakeup cannot get lost.
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            ++m_pending;
+        }
+        m_cond.notify_one();
+    }
+    // Run one pending task in the calling thread, if any is available.
+    // Return true if a task was run.
+    bool try_run_one()
+    {
+        const auto &w = this_worker();
+        std::function<void()> task;
+        if (!pop_task(task, w.pool == this ? static_cast<int>(w.idx) : -1)) {
+            return false;
+        }
+        run_task(task);
+        return true;
+    }
+    // Wait for a future to become ready. If the calling thread is a worker of a pool,
+    // it will run other pending tasks of its pool while waiting, so that waiting
+    // from within a task never deadlocks the pool.
+    template <typename T>
+    static void wait(const std::future<T> &f)
+    {
+        auto pool = current();
+        if (!pool) {
+            f.wait();
+            return;
+        }
+        while (f.wait_for(std::chrono::duration<int>::zero()) != std::future_status::ready) {
+            if (!pool->try_run_one()) {
+                f.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+    // Run f(0), ..., f(n - 1) using at most n_helpers workers in addition to the calling thread.
+    // Indices are claimed dynamically and the calling thread takes part in the computation, thus
+    // this function does not deadlock even if all the workers are busy (or if it is invoked from
+    // within a worker). If any invocation of f throws, one of the exceptions is re-thrown
+    // once all the invocations have finished.
+    void run_batch(std::size_t n, const std::function<void(std::size_t)> &f, std::size_t n_helpers)
+    {
+        if (!n) {
+            return;
+        }
+        auto state = std::make_shared<batch_state>(n, f);
+        n_helpers = n_helpers < n - 1u ? n_helpers : n - 1u;
+        for (std::size_t i = 0; i < n_helpers; ++i) {
+            // NOTE: the helpers hold a reference to the state, so that a helper starting
+            // after the batch was completed will just find nothing to do.
+            submit([state]() { state->work(); }, false);
+        }
+        state->work();
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (state->n_done != n) {
+            state->cond.wait(lock);
+        }
+        if (state->eptr) {
+            std::rethrow_exception(state->eptr);
+        }
+    }
+
+private:
+    struct batch_state {
+        explicit batch_state(std::size_t size, const std::function<void(std::size_t)> &func)
+            : next(0), n(size), f(&func), n_done(0)
+        {
+        }
+        void work()
+        {
+            for (auto i = next++; i < n; i = next++) {
+                std::exception_ptr e;
+                try {
+                    (*f)(i);
+                } catch (...) {
+                    e = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (e && !eptr) {
+                    eptr = e;
+                }
+                if (++n_done == n) {
+                    cond.notify_all();
+                }
+            }
+        }
+        std::atomic<std::size_t> next;
+        const std::size_t n;
+        // NOTE: f is invoked only after a successful claim, that is, while
+        // the caller of run_batch() is still waiting.
+        const std::function<void(std::size_t)> *f;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::size_t n_done;
+        std::exception_ptr eptr;
+    };
+    static void run_task(std::function<void()> &task)
+    {
+        try {
+            task();
+            // LCOV_EXCL_START
+        } catch (...) {
+            // NOTE: tasks are not supposed to throw.
+            std::abort();
+            // LCOV_EXCL_STOP
+        }
+    }
+    // Pop a task: own deque first (LIFO), then the global queue, then steal
+    // from the other workers. self is -1 if the calling thread is not a worker.
+    bool pop_task(std::function<void()> &task, int self)
+    {
+        const auto n = m_queues.size();
+        if (self >= 0 && pop_from(*m_queues[static_cast<std::size_t>(self)], task, false)) {
+            return true;
+        }
+        if (pop_from(m_global, task, true)) {
+            return true;
+        }
+        const auto start = self >= 0 ? static_cast<std::size_t>(self) + 1u : 0u;
+        for (std::size_t k = 0; k < n; ++k) {
+            const auto i = (start + k) % n;
+            if (static_cast<int>(i) != self && pop_from(*m_queues[i], task, true)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool pop_from(worker_queue &q, std::function<void()> &task, bool front)
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) {
+            return false;
+        }
+        if (front) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        } else {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        }
+        --m_pending;
+        return true;
+    }
+    void worker_loop(unsigned idx)
+    {
+        this_worker().pool = this;
+        this_worker().idx = idx;
+        try {
+            std::function<void()> task;
+            while (true) {
+                if (pop_task(task, static_cast<int>(idx))) {
+                    run_task(task);
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_sleep_mutex);
+                while (!m_stop && !m_pending.load()) {
+                    m_cond.wait(lock);
+                }
+                if (m_stop && !m_pending.load()) {
+                    // Stop requested and no more tasks to consume.
+                    break;
+                }
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+            // NOTE: errors from threading primitives or std::function, not
+            // much we can do to recover.
+            std::abort();
+            // LCOV_EXCL_STOP
+        }
+    }
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_stop = true;
+        }
+        m_cond.notify_all();
+        for (auto &t : m_threads) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+    }
+
+private:
+    bool m_stop;
+    std::atomic<std::size_t> m_pending;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_cond;
+    worker_queue m_global;
+    std::vector<std::unique_ptr<worker_queue>> m_queues;
+    std::vector<std::thread> m_threads;
+};
+} // namespace detail
+} // namespace pagmo
+
+#endif
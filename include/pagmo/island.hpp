@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/any.hpp>
 #include <boost/iterator/indirect_iterator.hpp>
 #include <cassert>
@@ -41,11 +42,13 @@ see https://www.gnu.org/licenses/. */
 #include <future>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
@@ -56,27 +59,40 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/config.hpp>
 #include <pagmo/detail/make_unique.hpp>
 #include <pagmo/detail/task_queue.hpp>
+#include <pagmo/detail/thread_pool.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
+#include <pagmo/r_policy.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/s_policy.hpp>
 #include <pagmo/serialization.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/threading.hpp>
+#include <pagmo/topology.hpp>
 #include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/multi_objective.hpp>
 
 #if defined(PAGMO_WITH_FORK_ISLAND)
 
 #include <atomic>
 #include <cerrno>
 #include <csignal>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ios>
+#include <new>
 #include <ostream>
 #include <sstream>
 #include <tuple>
 
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 #endif
@@ -247,10 +263,12 @@ struct isl_inner final : isl_inner_base {
 // If f.wait() throws something, the program will terminate. A valid std::future should not
 // throw, but technically the standard does not guarantee that. Having this noexcept wrapper
 // simplifies reasoning about exception behaviour in wait(), wait_check(), etc.
+// NOTE: if invoked from a worker of a thread pool (e.g., from within an evolution), the calling
+// thread will run other pending tasks of its pool while waiting.
 inline void wait_f(const std::future<void> &f) noexcept
 {
     assert(f.valid());
-    f.wait();
+    thread_pool::wait(f);
 }
 
 // Small helper to determine if a future holds an exception.
@@ -289,7 +307,7 @@ inline bool future_running(const std::future<void> &f)
 /// Thread island.
 /**
  * This class is a user-defined island (UDI) that will run evolutions directly inside
- * the separate thread of execution within pagmo::island.
+ * the worker thread executing the evolution tasks of pagmo::island.
  *
  * thread_island is the UDI type automatically selected by the constructors of pagmo::island
  * on non-POSIX platforms or when both the island's problem and algorithm provide at least the
@@ -418,56 +436,291 @@ class fork_island
         // of the pipe: true for open, false for closed.
         bool r_status, w_status;
     };
+    // Small RAII wrapper around an anonymous shared memory region. A region created
+    // before fork() is shared by the parent and the child, and it is used to transfer
+    // the individuals of a population without going through a pipe.
+    struct shm_t {
+        explicit shm_t(std::size_t s) : ptr(nullptr), size(s)
+        {
+            if (!size) {
+                return;
+            }
+            auto p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            // LCOV_EXCL_START
+            if (p == MAP_FAILED) {
+                pagmo_throw(std::runtime_error,
+                            "Unable to create a shared memory region with the mmap() function. The error code is "
+                                + std::to_string(errno) + " and the error message is: '" + std::strerror(errno) + "'");
+            }
+            // LCOV_EXCL_STOP
+            ptr = static_cast<char *>(p);
+        }
+        shm_t(const shm_t &) = delete;
+        shm_t &operator=(const shm_t &) = delete;
+        ~shm_t()
+        {
+            if (ptr) {
+                ::munmap(static_cast<void *>(ptr), size);
+            }
+        }
+        char *ptr;
+        std::size_t size;
+    };
+    // A stop flag living in shared memory, used to forward the cancellation requests
+    // to the child process (see pagmo::stop_requested()). The parent sets the flag while
+    // waiting for the child, and the child installs a stop token reading the flag.
+    struct stop_flag_t {
+        stop_flag_t() : shm(sizeof(std::atomic<unsigned long long>))
+        {
+            ::new (static_cast<void *>(shm.ptr)) std::atomic<unsigned long long>(0);
+        }
+        std::atomic<unsigned long long> &get() const
+        {
+            return *static_cast<std::atomic<unsigned long long> *>(static_cast<void *>(shm.ptr));
+        }
+        // Forward a stop request of the calling thread to the child.
+        void forward() const
+        {
+            if (stop_requested()) {
+                get().store(1);
+            }
+        }
+        // The token to be used in the child.
+        detail::stop_token token(detail::stop_token::clock_t::time_point deadline) const
+        {
+            detail::stop_token retval;
+            retval.gen = &get();
+            retval.expected = 0;
+            retval.deadline = deadline;
+            return retval;
+        }
+        shm_t shm;
+    };
     // The structure we use to pass messages from the child to the parent:
     // - int, status flag,
     // - string, error message,
     // - the algorithm used for evolution,
     // - the evolved population.
+    // NOTE: the population is (de)serialized via save_pop()/load_pop(), so that
+    // its individuals can be transferred through a shared memory region.
     using message_t = std::tuple<int, std::string, algorithm, population>;
+    // Small raii helper to ensure that the pid of the child is atomically
+    // set on construction, and reset to zero by the dtor.
+    struct pid_setter {
+        explicit pid_setter(std::atomic<pid_t> &ap, pid_t pid) : m_ap(ap)
+        {
+            m_ap.store(pid);
+        }
+        ~pid_setter()
+        {
+            m_ap.store(0);
+        }
+        std::atomic<pid_t> &m_ap;
+    };
+    // A persistent worker process, serving multiple evolutions. The parent sends requests
+    // through req and receives replies through rep. The worker keeps the algorithm and the
+    // population of the last evolution: algo and pop are the island's snapshots which are known
+    // to be identical to the worker's state, so that unchanged state is not sent again.
+    struct worker_t {
+        pid_t pid = 0;
+        pipe_t req, rep;
+        unsigned long long n_tasks = 0;
+        std::shared_ptr<const algorithm> algo;
+        std::shared_ptr<const population> pop;
+        // The shared memory region used to transfer populations in both
+        // directions, sized after the population of the island at spawn time.
+        std::unique_ptr<shm_t> shm;
+        // The stop flag, reset before each evolution.
+        stop_flag_t stop;
+    };
+    // Small raii helper to block SIGPIPE in the current thread while writing to a worker
+    // which might have died. Writing to its pipe will then fail with EPIPE rather than
+    // killing the parent process. A SIGPIPE generated while the guard was active is consumed
+    // before the original signal mask is restored.
+    struct sigpipe_guard {
+        sigpipe_guard()
+        {
+            sigemptyset(&m_set);
+            sigaddset(&m_set, SIGPIPE);
+            sigset_t pending;
+            sigemptyset(&pending);
+            sigpending(&pending);
+            m_was_pending = sigismember(&pending, SIGPIPE) == 1;
+            pthread_sigmask(SIG_BLOCK, &m_set, &m_old);
+        }
+        ~sigpipe_guard()
+        {
+            if (!m_was_pending) {
+                sigset_t pending;
+                sigemptyset(&pending);
+                sigpending(&pending);
+                if (sigismember(&pending, SIGPIPE) == 1) {
+                    int sig;
+                    sigwait(&m_set, &sig);
+                }
+            }
+            pthread_sigmask(SIG_SETMASK, &m_old, nullptr);
+        }
+        sigset_t m_set, m_old;
+        bool m_was_pending;
+    };
 
 public:
     // NOTE: we need to implement these because of the m_pid member,
     // which has a trivial def ctor and which is missing the copy/move ctors.
     // m_pid is only informational and it is relevant only while the evolution
-    // is undergoing, we will not copy it or serialize it.
-    fork_island() : m_pid(0) {}
-    fork_island(const fork_island &) : fork_island() {}
-    fork_island(fork_island &&) : fork_island() {}
+    // is undergoing, we will not copy it or serialize it. Similarly, the persistent
+    // worker is never shared between copies: only the configuration is copied.
+    fork_island() : fork_island(false) {}
+    explicit fork_island(bool persistent, unsigned long long max_tasks = 0)
+        : m_pid(0), m_worker_pid(0), m_persistent(persistent), m_max_tasks(max_tasks)
+    {
+    }
+    fork_island(const fork_island &other) : fork_island(other.m_persistent, other.m_max_tasks) {}
+    fork_island(fork_island &&other) : fork_island(other.m_persistent, other.m_max_tasks) {}
+    ~fork_island()
+    {
+        stop_worker();
+    }
     void run_evolve(island &) const;
     std::string get_name() const
     {
         return "Fork island";
     }
     // Extra info: report the child process' ID, if evolution
-    // is active.
+    // is active, and the persistent worker's configuration.
     std::string get_extra_info() const
     {
         const auto pid = m_pid.load();
-        if (pid) {
-            return "\tChild PID: " + std::to_string(pid);
+        std::string retval = pid ? "\tChild PID: " + std::to_string(pid) : std::string("\tNo active child");
+        if (m_persistent) {
+            retval += "\n\tPersistent worker: yes\n\tMax tasks per worker: "
+                      + (m_max_tasks ? std::to_string(m_max_tasks) : std::string("unlimited"));
+            const auto wpid = m_worker_pid.load();
+            if (wpid) {
+                retval += "\n\tWorker PID: " + std::to_string(wpid);
+            }
         }
-        return "\tNo active child";
+        return retval;
     }
     // Get the PID of the child.
     pid_t get_child_pid() const
     {
         return m_pid.load();
     }
+    // Get the PID of the persistent worker, if any.
+    pid_t get_worker_pid() const
+    {
+        return m_worker_pid.load();
+    }
+    bool is_persistent() const
+    {
+        return m_persistent;
+    }
+    unsigned long long get_max_tasks() const
+    {
+        return m_max_tasks;
+    }
     template <typename Archive>
-    void serialize(Archive &)
+    void serialize(Archive &ar)
     {
+        ar(m_persistent, m_max_tasks);
     }
 
+private:
+    void run_evolve_persistent(island &) const;
+    void start_worker(const population &) const;
+    void stop_worker() const noexcept;
+    void kill_worker() const noexcept;
+    [[noreturn]] static void worker_loop(worker_t &, pid_t);
+    template <typename F>
+    static void wait_readable(const pipe_t &, const F &);
+    template <typename F>
+    static void read_exact(const pipe_t &, char *, std::size_t, const F &);
+    static void write_exact(const pipe_t &, const char *, std::size_t);
+    template <typename F>
+    static std::string read_frame(const pipe_t &, const F &);
+    static void write_frame(const pipe_t &, const std::string &);
+    template <typename Archive>
+    static void save_pop(Archive &, const population &, const shm_t *);
+    template <typename Archive>
+    static void load_pop(Archive &, population &, const shm_t *);
+
 private:
     mutable std::atomic<pid_t> m_pid;
+    mutable std::atomic<pid_t> m_worker_pid;
+    bool m_persistent;
+    unsigned long long m_max_tasks;
+    mutable std::mutex m_worker_mutex;
+    mutable std::unique_ptr<worker_t> m_worker;
 };
 
 #endif
 
 class archipelago;
 
+/// Champion record of an island.
+/**
+ * This structure summarises the content of the population of a pagmo::island. A new record is published
+ * whenever the island's population is replaced (e.g., via island::set_population()) and at the end of
+ * each call to the <tt>run_evolve()</tt> method of the UDI. Records are immutable once published,
+ * and they can be retrieved cheaply via island::get_champion() and archipelago::get_champions().
+ */
+struct island_champion {
+    /// Number of <tt>run_evolve()</tt> calls completed by the island when the record was published.
+    unsigned long long n_evolve = 0;
+    /// Publication time.
+    std::chrono::steady_clock::time_point timestamp;
+    /// Availability of the champion.
+    /**
+     * This flag is \p true if the population's problem is single-objective and deterministic,
+     * that is, if population::champion_x() and population::champion_f() would not throw.
+     */
+    bool has_champion = false;
+    /// Champion decision vector (empty if \p has_champion is \p false).
+    vector_double x;
+    /// Champion fitness vector (empty if \p has_champion is \p false).
+    vector_double f;
+    /// Decision vectors of the non-dominated individuals.
+    /**
+     * This member (and \p nd_f) is filled only for unconstrained multi-objective problems.
+     */
+    std::vector<vector_double> nd_x;
+    /// Fitness vectors of the non-dominated individuals.
+    std::vector<vector_double> nd_f;
+};
+
 namespace detail
 {
+// Build the champion record of a population.
+inline std::shared_ptr<const island_champion> make_island_champion(const population &pop, unsigned long long n_evolve)
+{
+    auto retval = std::make_shared<island_champion>();
+    retval->n_evolve = n_evolve;
+    retval->timestamp = std::chrono::steady_clock::now();
+    const auto &prob = pop.get_problem();
+    if (prob.get_nobj() == 1u) {
+        if (!prob.is_stochastic()) {
+            retval->has_champion = true;
+            retval->x = pop.champion_x();
+            retval->f = pop.champion_f();
+        }
+    } else if (prob.get_nc() == 0u && pop.size()) {
+        std::vector<vector_double::size_type> nd_idx{0};
+        if (pop.size() > 1u) {
+            const auto &f = pop.get_f();
+            nd_idx = prob.get_nobj() == 2u ? non_dominated_front_2d(f) : std::get<0>(fast_non_dominated_sorting(f))[0];
+        }
+        retval->nd_x.reserve(nd_idx.size());
+        retval->nd_f.reserve(nd_idx.size());
+        for (auto idx : nd_idx) {
+            retval->nd_x.push_back(pop.get_x_row(idx).to_vector());
+            retval->nd_f.push_back(pop.get_f_row(idx).to_vector());
+        }
+    }
+    return retval;
+}
+
 // NOTE: this construct is used to create a RAII-style object at the beginning
 // of island::wait()/island::wait_check(). Normally this object's constructor and destructor will not
 // do anything, but in Python we need to override this getter so that it returns
@@ -516,6 +769,13 @@ inline void default_island_factory(const algorithm &algo, const population &pop,
 template <typename T>
 typename island_factory<T>::func_t island_factory<T>::s_func = default_island_factory;
 
+// A group of emigrants published by an island. seq identifies the
+// publication, so that neighbours import each group at most once.
+struct island_migrants {
+    individuals_group_t inds;
+    unsigned long long seq;
+};
+
 // NOTE: the idea with this class is that we use it to store the data members of pagmo::island, and,
 // within pagmo::island, we store a pointer to an instance of this struct. The reason for this approach
 // is that, like this, we can provide sensible move semantics: just move the internal pointer of pagmo::island.
@@ -524,7 +784,7 @@ struct island_data {
     // are both thread safe.
     island_data()
         : isl_ptr(make_unique<isl_inner<thread_island>>()), algo(std::make_shared<algorithm>()),
-          pop(std::make_shared<population>())
+          pop(std::make_shared<population>()), n_evolve(0), champ(make_island_champion(*pop, 0))
     {
     }
     // This is the main ctor, from an algo and a population. The UDI type will be selected
@@ -532,7 +792,8 @@ struct island_data {
     template <typename Algo, typename Pop>
     explicit island_data(Algo &&a, Pop &&p)
         : algo(std::make_shared<algorithm>(std::forward<Algo>(a))),
-          pop(std::make_shared<population>(std::forward<Pop>(p)))
+          pop(std::make_shared<population>(std::forward<Pop>(p))), n_evolve(0),
+          champ(make_island_champion(*pop, 0))
     {
         island_factory<>::s_func(*algo, *pop, isl_ptr);
     }
@@ -541,7 +802,8 @@ struct island_data {
     explicit island_data(Isl &&isl, Algo &&a, Pop &&p)
         : isl_ptr(make_unique<isl_inner<uncvref_t<Isl>>>(std::forward<Isl>(isl))),
           algo(std::make_shared<algorithm>(std::forward<Algo>(a))),
-          pop(std::make_shared<population>(std::forward<Pop>(p)))
+          pop(std::make_shared<population>(std::forward<Pop>(p))), n_evolve(0),
+          champ(make_island_champion(*pop, 0))
     {
     }
     // This is used only in the copy ctor of island. It's equivalent to the ctor from Algo + pop,
@@ -549,7 +811,8 @@ struct island_data {
     template <typename Algo, typename Pop>
     explicit island_data(std::unique_ptr<isl_inner_base> &&ptr, Algo &&a, Pop &&p)
         : isl_ptr(std::move(ptr)), algo(std::make_shared<algorithm>(std::forward<Algo>(a))),
-          pop(std::make_shared<population>(std::forward<Pop>(p)))
+          pop(std::make_shared<population>(std::forward<Pop>(p))), n_evolve(0),
+          champ(make_island_champion(*pop, 0))
     {
     }
     // Delete all the rest, make sure we don't implicitly rely on any of this.
@@ -569,10 +832,31 @@ struct island_data {
     std::shared_ptr<algorithm> algo;
     std::mutex pop_mutex;
     std::shared_ptr<population> pop;
+    // Number of completed run_evolve() calls, and the latest
+    // champion record. The record is accessed via the atomic
+    // shared_ptr free functions, so that readers never block.
+    std::atomic<unsigned long long> n_evolve;
+    std::shared_ptr<const island_champion> champ;
+    // The migration policies.
+    std::mutex pol_mutex;
+    s_policy s_pol;
+    r_policy r_pol;
+    // The latest group of emigrants, accessed via the atomic shared_ptr
+    // free functions. Neighbours never block on a slow island: they just
+    // import whatever group was published last.
+    std::shared_ptr<const island_migrants> emigrants;
+    // The seq of the last group imported from each island of the archipelago.
+    // NOTE: this is accessed only from within the evolution tasks of the
+    // island, which are executed one at a time.
+    std::vector<unsigned long long> last_imported;
+    // Incremented by island::cancel(): the evolution tasks submitted
+    // before the increment will stop (see detail::stop_token).
+    std::atomic<unsigned long long> cancel_gen{0};
     std::vector<std::future<void>> futures;
-    // This will be explicitly set only during archipelago::push_back().
-    // In all other situations, it will be null.
+    // These will be explicitly set only during archipelago::push_back().
+    // In all other situations, archi_ptr will be null.
     archipelago *archi_ptr = nullptr;
+    std::size_t archi_idx = 0;
     task_queue queue;
 };
 } // namespace detail
@@ -704,6 +988,10 @@ class island
     using idata_t = detail::island_data;
     // archi needs access to the internal of island.
     friend class archipelago;
+#if defined(PAGMO_WITH_FORK_ISLAND)
+    // fork_island needs to know which snapshots it published.
+    friend class fork_island;
+#endif
     // NOTE: the idea in the move members and the dtor is that
     // we want to wait *and* erase any future in the island, before doing
     // the move/destruction. Thus we use this small wrapper.
@@ -728,13 +1016,13 @@ public:
     island() : m_ptr(detail::make_unique<idata_t>()) {}
     /// Copy constructor.
     /**
-     * The copy constructor will initialise an island containing a copy of <tt>other</tt>'s UDI, population
-     * and algorithm. It is safe to call this constructor while \p other is evolving.
+     * The copy constructor will initialise an island containing a copy of <tt>other</tt>'s UDI, population,
+     * algorithm and migration policies. It is safe to call this constructor while \p other is evolving.
      *
      * @param other the island tht will be copied.
      *
      * @throws unspecified any exception thrown by:
-     * - get_population() and get_algorithm(),
+     * - get_population(), get_algorithm(), get_s_policy() and get_r_policy(),
      * - memory allocation errors,
      * - the copy constructors of pagmo::algorithm and pagmo::population.
      */
@@ -742,6 +1030,8 @@ public:
         : m_ptr(detail::make_unique<idata_t>(other.m_ptr->isl_ptr->clone(), other.get_algorithm(),
                                              other.get_population()))
     {
+        m_ptr->s_pol = other.get_s_policy();
+        m_ptr->r_pol = other.get_r_policy();
         // NOTE: the idata_t ctor will set the archi ptr to null. The archi ptr is never copied.
         assert(m_ptr->archi_ptr == nullptr);
     }
@@ -1030,12 +1320,22 @@ public:
      * island's pagmo::algorithm. The evolution happens asynchronously:
      * a call to island::evolve() will create an evolution task that will be pushed
      * to a queue, and then return immediately.
-     * The tasks in the queue are consumed
-     * by a separate thread of execution managed by the pagmo::island object.
+     * The tasks in the queue are consumed,
+     * one at a time, by the worker threads of a thread pool shared among islands (see
+     * archipelago::set_n_threads() for using a dedicated pool).
      * Each task will invoke the <tt>run_evolve()</tt>
      * method of the UDI \p n times consecutively to perform the actual evolution.
      * The island's population will be updated at the end of each <tt>run_evolve()</tt>
-     * invocation. Exceptions raised inside the
+     * invocation.
+     *
+     * If the island belongs to a pagmo::archipelago whose topology connects it to other islands, each
+     * <tt>run_evolve()</tt> invocation is preceded by the import of the emigrants most recently published
+     * by the neighbouring islands (via the island's replacement policy, see set_r_policy()) and followed
+     * by the publication of new emigrants (via the island's selection policy, see set_s_policy()). Emigrants
+     * are exchanged through per-island buffers which are never locked, so that a slow island
+     * never blocks its neighbours.
+     *
+     * Exceptions raised inside the
      * tasks are stored within the island object, and can be re-raised by calling wait_check().
      *
      * It is possible to call this method multiple times to enqueue multiple evolution tasks, which
@@ -1043,6 +1343,8 @@ public:
      * to block until all tasks have been completed, and to fetch exceptions raised during the execution of the tasks.
      * island::status() can be used to query the status of the asynchronous operations in the island.
      *
+     * The evolution task can be stopped via cancel().
+     *
      * @param n the number of times the <tt>run_evolve()</tt> method of the UDI will be called
      * within the evolution task.
      *
@@ -1053,6 +1355,55 @@ public:
      */
     void evolve(unsigned n = 1)
     {
+        evolve_impl(n, detail::stop_token::clock_t::time_point::max());
+    }
+    /// Evolve with a deadline.
+    /**
+     * This method is equivalent to evolve(), except that the <tt>run_evolve()</tt> method of the UDI will be called
+     * repeatedly until \p d has elapsed (counting from the invocation of this method). When the deadline passes,
+     * the ongoing evolution is asked to stop (see pagmo::stop_requested()): algorithms which support cooperative
+     * cancellation will then return the best population found so far, which will be inserted into the island as usual.
+     * Algorithms which do not check pagmo::stop_requested() will run to completion, and thus the evolution
+     * may end after the deadline.
+     *
+     * @param d the duration of the evolution.
+     *
+     * @throws unspecified any exception thrown by evolve().
+     */
+    template <typename Rep, typename Period>
+    void evolve_for(const std::chrono::duration<Rep, Period> &d)
+    {
+        evolve_impl(0, detail::stop_token::clock_t::now()
+                           + std::chrono::duration_cast<detail::stop_token::clock_t::duration>(d));
+    }
+    /// Cancel the evolution.
+    /**
+     * This method will request the cooperative cancellation of the evolution tasks enqueued via evolve() and
+     * evolve_for() before its invocation:
+     * - the algorithm currently being run (if any) will see pagmo::stop_requested() return \p true. Algorithms
+     *   which support cooperative cancellation will then return the best population found so far, which will be
+     *   inserted into the island as usual, while the other algorithms will run to completion;
+     * - the remaining calls to <tt>run_evolve()</tt> of the cancelled tasks will be skipped.
+     *
+     * Cancellation is not an error: wait_check() will not raise because of it. Evolution tasks enqueued after the
+     * invocation of this method are not affected. This method does not block, and it is safe to call it while
+     * the island is evolving.
+     */
+    void cancel()
+    {
+        ++m_ptr->cancel_gen;
+    }
+
+private:
+    // Enqueue an evolution task. If n is zero, run_evolve() will be called
+    // repeatedly until the deadline.
+    // NOTE: if n is zero, i can wrap around, which is harmless.
+    void evolve_impl(unsigned n, detail::stop_token::clock_t::time_point deadline)
+    {
+        detail::stop_token tok;
+        tok.gen = &m_ptr->cancel_gen;
+        tok.expected = m_ptr->cancel_gen.load();
+        tok.deadline = deadline;
         // First add an empty future, so that if an exception is thrown
         // we will not have modified m_futures, nor we will have a future
         // in flight which we cannot wait upon.
@@ -1061,9 +1412,9 @@ public:
             // Move assign a new future provided by the enqueue() method.
             // NOTE: enqueue either returns a valid future, or throws without
             // having enqueued any task.
-            m_ptr->futures.back() = m_ptr->queue.enqueue([this, n]() {
-                for (auto i = 0u; i < n; ++i) {
-                    this->m_ptr->isl_ptr->run_evolve(*this);
+            m_ptr->futures.back() = m_ptr->queue.enqueue([this, n, tok]() {
+                for (auto i = 0u; (!n || i < n) && !tok.stop_requested(); i += n ? 1u : 0u) {
+                    this->evolve_step(nullptr, tok);
                 }
             });
             // LCOV_EXCL_START
@@ -1075,6 +1426,8 @@ public:
             // LCOV_EXCL_STOP
         }
     }
+
+public:
     /// Block until evolution ends and re-raise the first stored exception.
     /**
      * This method will block until all the evolution tasks enqueued via island::evolve() have been completed.
@@ -1095,6 +1448,7 @@ public:
         for (auto it = m_ptr->futures.begin(); it != m_ptr->futures.end(); ++it) {
             assert(it->valid());
             try {
+                detail::wait_f(*it);
                 it->get();
             } catch (...) {
                 // If any of the futures stores an exception, we will re-raise it.
@@ -1216,10 +1570,46 @@ public:
         // by set_algorithm() below, and we guarantee strong thread safety for this method.
         // NOTE: it might be possible to replace the locks with atomic operations:
         // http://en.cppreference.com/w/cpp/memory/shared_ptr/atomic
-        std::unique_lock<std::mutex> lock(m_ptr->algo_mutex);
-        auto new_algo_ptr = m_ptr->algo;
-        lock.unlock();
-        return *new_algo_ptr;
+        return *get_algorithm_snapshot();
+    }
+    /// Get a read-only snapshot of the algorithm.
+    /**
+     * The island never modifies its algorithm in place: set_algorithm() and the end of each evolution
+     * replace it with a new object. This method returns a shared handle to the algorithm currently
+     * stored in the island, without copying it. The returned object will remain valid and unchanged
+     * for as long as the handle is alive, even if the island is evolved or assigned a new algorithm
+     * in the meantime.
+     *
+     * It is safe to call this method while the island is evolving. Since the pointee may be shared with
+     * other readers, only const and thread-safe member functions should be invoked on it.
+     *
+     * @return a shared pointer to the island's current algorithm.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    std::shared_ptr<const algorithm> get_algorithm_snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->algo_mutex);
+        return m_ptr->algo;
+    }
+    /// Read the algorithm.
+    /**
+     * This method will invoke \p f with a const reference to the island's algorithm and return the result,
+     * without copying the algorithm. The island's lock is not held while \p f is running.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @param f the function object to invoke.
+     *
+     * @return the output of \p f.
+     *
+     * @throws unspecified any exception thrown by get_algorithm_snapshot() or by \p f.
+     */
+    template <typename F>
+    auto read_algorithm(F &&f) const -> decltype(std::forward<F>(f)(std::declval<const algorithm &>()))
+    {
+        const auto ptr = get_algorithm_snapshot();
+        return std::forward<F>(f)(*ptr);
     }
     /// Set the algorithm.
     /**
@@ -1232,9 +1622,7 @@ public:
      */
     void set_algorithm(algorithm algo)
     {
-        auto new_algo_ptr = std::make_shared<algorithm>(std::move(algo));
-        std::lock_guard<std::mutex> lock(m_ptr->algo_mutex);
-        m_ptr->algo = new_algo_ptr;
+        publish_algorithm(std::move(algo));
     }
     /// Get the population.
     /**
@@ -1247,10 +1635,46 @@ public:
      */
     population get_population() const
     {
-        std::unique_lock<std::mutex> lock(m_ptr->pop_mutex);
-        auto new_pop_ptr = m_ptr->pop;
-        lock.unlock();
-        return *new_pop_ptr;
+        return *get_population_snapshot();
+    }
+    /// Get a read-only snapshot of the population.
+    /**
+     * The island never modifies its population in place: set_population() and the end of each evolution
+     * replace it with a new object. This method returns a shared handle to the population currently
+     * stored in the island, without copying it. The returned object will remain valid and unchanged
+     * for as long as the handle is alive, even if the island is evolved or assigned a new population
+     * in the meantime.
+     *
+     * It is safe to call this method while the island is evolving. Since the pointee may be shared with
+     * other readers, only const and thread-safe member functions should be invoked on it.
+     *
+     * @return a shared pointer to the island's current population.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    std::shared_ptr<const population> get_population_snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+        return m_ptr->pop;
+    }
+    /// Read the population.
+    /**
+     * This method will invoke \p f with a const reference to the island's population and return the result,
+     * without copying the population. The island's lock is not held while \p f is running.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @param f the function object to invoke.
+     *
+     * @return the output of \p f.
+     *
+     * @throws unspecified any exception thrown by get_population_snapshot() or by \p f.
+     */
+    template <typename F>
+    auto read_population(F &&f) const -> decltype(std::forward<F>(f)(std::declval<const population &>()))
+    {
+        const auto ptr = get_population_snapshot();
+        return std::forward<F>(f)(*ptr);
     }
     /// Set the population.
     /**
@@ -1263,9 +1687,83 @@ public:
      */
     void set_population(population pop)
     {
-        auto new_pop_ptr = std::make_shared<population>(std::move(pop));
-        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
-        m_ptr->pop = new_pop_ptr;
+        publish_population(std::move(pop));
+    }
+    /// Get the selection policy.
+    /**
+     * It is safe to call this method while the island is evolving.
+     *
+     * @return a copy of the island's selection policy.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by the copy constructor
+     * of pagmo::s_policy.
+     */
+    s_policy get_s_policy() const
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pol_mutex);
+        return m_ptr->s_pol;
+    }
+    /// Set the selection policy.
+    /**
+     * The selection policy is used to select, at the end of each evolution step, the individuals of the
+     * island's population which will be offered as emigrants to the neighbouring islands (see evolve()).
+     * The default selection policy is pagmo::select_best.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @param s the new selection policy.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    void set_s_policy(s_policy s)
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pol_mutex);
+        m_ptr->s_pol = std::move(s);
+    }
+    /// Get the replacement policy.
+    /**
+     * It is safe to call this method while the island is evolving.
+     *
+     * @return a copy of the island's replacement policy.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by the copy constructor
+     * of pagmo::r_policy.
+     */
+    r_policy get_r_policy() const
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pol_mutex);
+        return m_ptr->r_pol;
+    }
+    /// Set the replacement policy.
+    /**
+     * The replacement policy is used to insert, at the beginning of each evolution step, the immigrants
+     * coming from the neighbouring islands into the island's population (see evolve()).
+     * The default replacement policy is pagmo::fair_replace.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @param r the new replacement policy.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    void set_r_policy(r_policy r)
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pol_mutex);
+        m_ptr->r_pol = std::move(r);
+    }
+    /// Get the champion record.
+    /**
+     * This method returns the latest champion record published by the island (see pagmo::island_champion),
+     * without copying the island's population. The record is read via atomic operations, thus this method
+     * never waits on an ongoing evolution.
+     *
+     * It is safe to call this method while the island is evolving.
+     *
+     * @return a shared pointer to the island's latest champion record.
+     */
+    std::shared_ptr<const island_champion> get_champion() const
+    {
+        return std::atomic_load(&m_ptr->champ);
     }
     /// Get the thread safety of the island's members.
     /**
@@ -1279,14 +1777,8 @@ public:
     std::array<thread_safety, 2> get_thread_safety() const
     {
         std::array<thread_safety, 2> retval;
-        {
-            std::lock_guard<std::mutex> lock(m_ptr->algo_mutex);
-            retval[0] = m_ptr->algo->get_thread_safety();
-        }
-        {
-            std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
-            retval[1] = m_ptr->pop->get_problem().get_thread_safety();
-        }
+        retval[0] = get_algorithm_snapshot()->get_thread_safety();
+        retval[1] = get_population_snapshot()->get_problem().get_thread_safety();
         return retval;
     }
     /// Island's name.
@@ -1332,7 +1824,8 @@ public:
      *
      * @throws unspecified any exception thrown by:
      * - the stream operators of fundamental types, pagmo::algorithm and pagmo::population,
-     * - pagmo::island::get_extra_info(), pagmo::island::get_algorithm(), pagmo::island::get_population().
+     * - pagmo::island::get_extra_info(), pagmo::island::get_algorithm_snapshot(),
+     *   pagmo::island::get_population_snapshot().
      */
     friend std::ostream &operator<<(std::ostream &os, const island &isl)
     {
@@ -1342,11 +1835,13 @@ public:
         if (!extra_str.empty()) {
             stream(os, "Extra info:\n", extra_str, "\n\n");
         }
-        stream(os, "Algorithm: " + isl.get_algorithm().get_name(), "\n\n");
-        stream(os, "Problem: " + isl.get_population().get_problem().get_name(), "\n\n");
-        stream(os, "Population size: ", isl.get_population().size(), "\n");
-        stream(os, "\tChampion decision vector: ", isl.get_population().champion_x(), "\n");
-        stream(os, "\tChampion fitness: ", isl.get_population().champion_f(), "\n");
+        stream(os, "Algorithm: " + isl.get_algorithm_snapshot()->get_name(), "\n\n");
+        // NOTE: use a single snapshot, so that the printed data refer to the same population.
+        const auto pop = isl.get_population_snapshot();
+        stream(os, "Problem: " + pop->get_problem().get_name(), "\n\n");
+        stream(os, "Population size: ", pop->size(), "\n");
+        stream(os, "\tChampion decision vector: ", pop->champion_x(), "\n");
+        stream(os, "\tChampion fitness: ", pop->champion_f(), "\n");
         return os;
     }
     /// Save to archive.
@@ -1358,13 +1853,13 @@ public:
      * @param ar the target archive.
      *
      * @throws unspecified any exception thrown by:
-     * - the serialization of pagmo::algorithm, pagmo::population and of the UDI type,
-     * - get_algorithm() and get_population().
+     * - the serialization of pagmo::algorithm, pagmo::population, of the migration policies and of the UDI type,
+     * - get_algorithm_snapshot(), get_population_snapshot(), get_s_policy() and get_r_policy().
      */
     template <typename Archive>
     void save(Archive &ar) const
     {
-        ar(m_ptr->isl_ptr, get_algorithm(), get_population());
+        ar(m_ptr->isl_ptr, *get_algorithm_snapshot(), *get_population_snapshot(), get_s_policy(), get_r_policy());
     }
     /// Load from archive.
     /**
@@ -1374,8 +1869,8 @@ public:
      *
      * @param ar the source archive.
      *
-     * @throws unspecified any exception thrown by the deserialization of pagmo::algorithm, pagmo::population and of the
-     * UDI type.
+     * @throws unspecified any exception thrown by the deserialization of pagmo::algorithm, pagmo::population,
+     * of the migration policies and of the UDI type.
      */
     template <typename Archive>
     void load(Archive &ar)
@@ -1386,9 +1881,50 @@ public:
         ar(tmp_island.m_ptr->isl_ptr);
         ar(*tmp_island.m_ptr->algo);
         ar(*tmp_island.m_ptr->pop);
+        ar(tmp_island.m_ptr->s_pol, tmp_island.m_ptr->r_pol);
+        tmp_island.m_ptr->champ = detail::make_island_champion(*tmp_island.m_ptr->pop, 0);
         *this = std::move(tmp_island);
     }
 
+private:
+    // Implementation of set_algorithm()/set_population(). They return the snapshot
+    // which was stored in the island.
+    std::shared_ptr<const algorithm> publish_algorithm(algorithm algo)
+    {
+        auto new_algo_ptr = std::make_shared<algorithm>(std::move(algo));
+        std::lock_guard<std::mutex> lock(m_ptr->algo_mutex);
+        m_ptr->algo = new_algo_ptr;
+        return new_algo_ptr;
+    }
+    std::shared_ptr<const population> publish_population(population pop)
+    {
+        auto new_pop_ptr = std::make_shared<population>(std::move(pop));
+        auto new_champ = detail::make_island_champion(*new_pop_ptr, m_ptr->n_evolve.load());
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+        m_ptr->pop = new_pop_ptr;
+        std::atomic_store(&m_ptr->champ, std::move(new_champ));
+        return new_pop_ptr;
+    }
+    // Publish a new champion record at the end of a run_evolve() call.
+    // NOTE: the UDI has already published the evolved population via set_population(),
+    // thus we just need to update the counter and the timestamp.
+    void bump_champion()
+    {
+        const auto n = ++m_ptr->n_evolve;
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+        auto new_champ = std::make_shared<island_champion>(*std::atomic_load(&m_ptr->champ));
+        new_champ->n_evolve = n;
+        new_champ->timestamp = std::chrono::steady_clock::now();
+        std::atomic_store(&m_ptr->champ, std::shared_ptr<const island_champion>(std::move(new_champ)));
+    }
+    // A single evolution step: import the immigrants, call run_evolve() and publish
+    // the emigrants. If snapshot is not null, the immigrants are taken from it rather
+    // than from the current emigrant buffers of the neighbours (synchronous migration).
+    // NOTE: this is implemented after the definition of archipelago.
+    // The evolution is run with tok as the stop token of the calling thread.
+    void evolve_step(const std::vector<std::shared_ptr<const detail::island_migrants>> *snapshot,
+                     const detail::stop_token &tok);
+
 private:
     std::unique_ptr<idata_t> m_ptr;
 };
@@ -1436,10 +1972,24 @@ inline void thread_island::run_evolve(island &isl) const
 
 inline void fork_island::run_evolve(island &isl) const
 {
+    if (m_persistent) {
+        run_evolve_persistent(isl);
+        return;
+    }
     // A message that will be used both by parent and child.
     message_t m;
     // The pipe.
     pipe_t p;
+    // The shared memory region into which the child will write the individuals
+    // of the evolved population, sized after the current population.
+    const auto pop_ptr = isl.get_population_snapshot();
+    std::size_t shm_size;
+    if (!detail::population_access::inds_bytes(*pop_ptr, pop_ptr->size(), shm_size)) {
+        shm_size = 0; // LCOV_EXCL_LINE
+    }
+    shm_t shm(shm_size);
+    // The stop flag of the child.
+    const stop_flag_t stop;
     // Try to fork now.
     auto child_pid = fork();
     // LCOV_EXCL_START
@@ -1452,19 +2002,6 @@ inline void fork_island::run_evolve(island &isl) const
     // LCOV_EXCL_STOP
     if (child_pid) {
         // We are in the parent.
-        // Small raii helper to ensure that the pid of the child is atomically
-        // set on construction, and reset to zero by the dtor.
-        struct pid_setter {
-            explicit pid_setter(std::atomic<pid_t> &ap, pid_t pid) : m_ap(ap)
-            {
-                m_ap.store(pid);
-            }
-            ~pid_setter()
-            {
-                m_ap.store(0);
-            }
-            std::atomic<pid_t> &m_ap;
-        };
         pid_setter ps(m_pid, child_pid);
         try {
             // Close the write descriptor, we don't need to send anything to the child.
@@ -1477,6 +2014,7 @@ inline void fork_island::run_evolve(island &isl) const
             {
                 cereal::BinaryInputArchive iarchive(ss);
                 while (true) {
+                    wait_readable(p, [&stop]() { stop.forward(); });
                     const auto read_bytes = p.read(static_cast<void *>(buffer), sizeof(buffer));
                     if (!read_bytes) {
                         // EOF, break out.
@@ -1484,7 +2022,8 @@ inline void fork_island::run_evolve(island &isl) const
                     }
                     ss.write(buffer, static_cast<std::streamsize>(read_bytes));
                 }
-                iarchive(m);
+                iarchive(std::get<0>(m), std::get<1>(m), std::get<2>(m));
+                load_pop(iarchive, std::get<3>(m), &shm);
             }
             // Close the read descriptor.
             p.close_r();
@@ -1525,9 +2064,10 @@ inline void fork_island::run_evolve(island &isl) const
         // Small helpers to serialize a message and send the contents of a string
         // stream back to the parent. This is split in 2 separate functions
         // because we can handle errors in serialize_message(), but not in send_ss().
-        auto serialize_message = [](std::stringstream &ss, const message_t &ms) {
+        auto serialize_message = [&shm](std::stringstream &ss, const message_t &ms) {
             cereal::BinaryOutputArchive oarchive(ss);
-            oarchive(ms);
+            oarchive(std::get<0>(ms), std::get<1>(ms), std::get<2>(ms));
+            save_pop(oarchive, std::get<3>(ms), &shm);
         };
         auto send_ss = [&p](std::stringstream &ss) {
             // NOTE: make the buffer small enough that its size can be represented by any
@@ -1551,9 +2091,13 @@ inline void fork_island::run_evolve(island &isl) const
         try {
             // Close the read descriptor, we don't need to read anything from the parent.
             p.close_r();
-            // Run the evolution.
+            // Run the evolution, with a stop token reading the shared stop flag.
+            // NOTE: the deadline is taken from the token of the parent's thread.
+            const auto cur = detail::current_stop_token();
+            const auto tok = stop.token(cur ? cur->deadline : detail::stop_token::clock_t::time_point::max());
+            detail::stop_token_setter sts(tok);
             auto algo = isl.get_algorithm();
-            auto new_pop = algo.evolve(isl.get_population());
+            auto new_pop = algo.evolve(*pop_ptr);
             // Pack in m and serialize the result of the evolution.
             // NOTE: m was def cted, which, for tuples, value-inits all members.
             // So the status flag is already zero and the error message empty.
@@ -1614,8 +2158,423 @@ inline void fork_island::run_evolve(island &isl) const
     }
 }
 
+// Wait until p is readable (or closed), invoking on_timeout() periodically while waiting.
+template <typename F>
+inline void fork_island::wait_readable(const pipe_t &p, const F &on_timeout)
+{
+    while (true) {
+        ::pollfd pfd;
+        pfd.fd = p.rd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        const auto ret = ::poll(&pfd, 1, 100);
+        if (ret == -1) {
+            // LCOV_EXCL_START
+            if (errno == EINTR) {
+                continue;
+            }
+            pagmo_throw(std::runtime_error, "Unable to poll a pipe with the poll() function. The error code is "
+                                                + std::to_string(errno) + " and the error message is: '"
+                                                + std::strerror(errno) + "'");
+            // LCOV_EXCL_STOP
+        }
+        if (ret) {
+            return;
+        }
+        on_timeout();
+    }
+}
+
+// Read exactly size bytes from p. While waiting for data, alive() is periodically
+// invoked in order to detect a peer process which terminated without closing its end of the pipe
+// (e.g., because the pipe was inherited by another process).
+template <typename F>
+inline void fork_island::read_exact(const pipe_t &p, char *buf, std::size_t size, const F &alive)
+{
+    while (size) {
+        wait_readable(p, [&alive]() {
+            if (!alive()) {
+                pagmo_throw(std::runtime_error,
+                            "The peer process of a persistent fork_island worker terminated unexpectedly");
+            }
+        });
+        const auto read_bytes
+            = p.read(static_cast<void *>(buf), std::min(size, static_cast<std::size_t>(1) << 20));
+        if (!read_bytes) {
+            pagmo_throw(std::runtime_error,
+                        "The peer process of a persistent fork_island worker closed its pipe unexpectedly");
+        }
+        buf += read_bytes;
+        size -= static_cast<std::size_t>(read_bytes);
+    }
+}
+
+// Write exactly size bytes into p.
+inline void fork_island::write_exact(const pipe_t &p, const char *buf, std::size_t size)
+{
+    while (size) {
+        const auto written_bytes
+            = p.write(static_cast<const void *>(buf), std::min(size, static_cast<std::size_t>(1) << 20));
+        buf += written_bytes;
+        size -= static_cast<std::size_t>(written_bytes);
+    }
+}
+
+// The messages exchanged with a persistent worker are framed as an 8-byte little-endian
+// size, followed by the payload.
+template <typename F>
+inline std::string fork_island::read_frame(const pipe_t &p, const F &alive)
+{
+    unsigned char header[8];
+    read_exact(p, reinterpret_cast<char *>(header), sizeof(header), alive);
+    std::uint64_t size = 0;
+    for (std::size_t i = 0; i < sizeof(header); ++i) {
+        size |= static_cast<std::uint64_t>(header[i]) << (8u * i);
+    }
+    // LCOV_EXCL_START
+    if (size > std::numeric_limits<std::size_t>::max()) {
+        pagmo_throw(std::overflow_error, "The size of a message received from a persistent fork_island worker is "
+                                         "too large");
+    }
+    // LCOV_EXCL_STOP
+    std::string retval(static_cast<std::size_t>(size), '\0');
+    if (size) {
+        read_exact(p, &retval[0], retval.size(), alive);
+    }
+    return retval;
+}
+
+inline void fork_island::write_frame(const pipe_t &p, const std::string &s)
+{
+    const auto size = static_cast<std::uint64_t>(s.size());
+    char header[8];
+    for (std::size_t i = 0; i < sizeof(header); ++i) {
+        header[i] = static_cast<char>((size >> (8u * i)) & 0xffu);
+    }
+    write_exact(p, header, sizeof(header));
+    write_exact(p, s.data(), s.size());
+}
+
+// Serialize pop into ar. If shm is large enough, the individuals of pop are copied
+// into it, and only the rest of the population is serialized.
+template <typename Archive>
+inline void fork_island::save_pop(Archive &ar, const population &pop, const shm_t *shm)
+{
+    std::size_t size;
+    if (shm && detail::population_access::inds_bytes(pop, pop.size(), size) && size <= shm->size) {
+        ar(true, static_cast<unsigned long long>(pop.size()));
+        detail::population_access::save_no_inds(ar, pop);
+        detail::population_access::copy_inds(pop, shm->ptr);
+    } else {
+        ar(false, pop);
+    }
+}
+
+// Deserialize into pop a population serialized via save_pop().
+template <typename Archive>
+inline void fork_island::load_pop(Archive &ar, population &pop, const shm_t *shm)
+{
+    bool in_shm;
+    ar(in_shm);
+    if (!in_shm) {
+        ar(pop);
+        return;
+    }
+    unsigned long long n;
+    ar(n);
+    population tmp;
+    detail::population_access::load_no_inds(ar, tmp);
+    std::size_t size;
+    if (!shm || !detail::population_access::inds_bytes(tmp, n, size) || size > shm->size) {
+        pagmo_throw(std::invalid_argument, "Inconsistent size of a population received through shared memory "
+                                           "in a fork_island");
+    }
+    detail::population_access::set_inds(tmp, shm->ptr, n);
+    pop = std::move(tmp);
+}
+
+// The main loop of a persistent worker. Each request is made of:
+// - int, the command (0 to quit, 1 to evolve),
+// - two bools, signalling whether a new algorithm and/or a new population follow,
+// - the deadline of the evolution (see detail::stop_token),
+// - the new algorithm and/or population, if any.
+// The reply is made of a status flag and an error message, followed by the evolved
+// algorithm and population if the status flag is zero. The populations are transferred
+// via save_pop()/load_pop() in both directions.
+inline void fork_island::worker_loop(worker_t &w, pid_t ppid)
+{
+    // NOTE: we won't get any coverage data from the worker process.
+    // NOTE: the worker terminates via _exit(), so that the atexit handlers and
+    // the static destructors inherited from the parent are not run.
+    //
+    // LCOV_EXCL_START
+    try {
+        w.req.close_w();
+        w.rep.close_r();
+        // The worker will terminate if the parent process dies.
+        const auto parent_alive = [ppid]() { return getppid() == ppid; };
+        algorithm algo;
+        population pop;
+        while (true) {
+            std::string req;
+            try {
+                req = read_frame(w.req, parent_alive);
+            } catch (...) {
+                // The parent went away.
+                _exit(0);
+            }
+            std::string rep;
+            try {
+                int cmd;
+                bool has_algo, has_pop;
+                detail::stop_token::clock_t::rep deadline;
+                std::stringstream iss(req);
+                {
+                    cereal::BinaryInputArchive iarchive(iss);
+                    iarchive(cmd, has_algo, has_pop, deadline);
+                    if (!cmd) {
+                        _exit(0);
+                    }
+                    if (has_algo) {
+                        iarchive(algo);
+                    }
+                    if (has_pop) {
+                        load_pop(iarchive, pop, w.shm.get());
+                    }
+                }
+                const auto tok = w.stop.token(
+                    detail::stop_token::clock_t::time_point(detail::stop_token::clock_t::duration(deadline)));
+                detail::stop_token_setter sts(tok);
+                pop = algo.evolve(pop);
+                std::stringstream oss;
+                {
+                    cereal::BinaryOutputArchive oarchive(oss);
+                    oarchive(0, std::string{}, algo);
+                    save_pop(oarchive, pop, w.shm.get());
+                }
+                rep = oss.str();
+            } catch (const std::exception &e) {
+                std::stringstream oss;
+                {
+                    cereal::BinaryOutputArchive oarchive(oss);
+                    oarchive(1, std::string(e.what()));
+                }
+                rep = oss.str();
+            } catch (...) {
+                std::stringstream oss;
+                {
+                    cereal::BinaryOutputArchive oarchive(oss);
+                    oarchive(1, std::string("unknown error"));
+                }
+                rep = oss.str();
+            }
+            write_frame(w.rep, rep);
+        }
+    } catch (...) {
+        std::cerr << "An unrecoverable error was raised in the worker process of a persistent fork_island. Giving up "
+                     "now."
+                  << std::endl;
+    }
+    _exit(1);
+    // LCOV_EXCL_STOP
+}
+
+// Spawn a new persistent worker.
+// NOTE: all the methods managing the worker must be called with m_worker_mutex held
+// (or from the destructor).
+inline void fork_island::start_worker(const population &pop) const
+{
+    assert(!m_worker);
+    std::unique_ptr<worker_t> w(new worker_t);
+    std::size_t shm_size;
+    if (!detail::population_access::inds_bytes(pop, pop.size(), shm_size)) {
+        shm_size = 0; // LCOV_EXCL_LINE
+    }
+    w->shm.reset(new shm_t(shm_size));
+    const auto ppid = getpid();
+    const auto pid = fork();
+    // LCOV_EXCL_START
+    if (pid == -1) {
+        pagmo_throw(std::runtime_error,
+                    "Cannot fork the process in a fork_island with the fork() function. The error code is "
+                        + std::to_string(errno) + " and the error message is: '" + std::strerror(errno) + "'");
+    }
+    // LCOV_EXCL_STOP
+    if (!pid) {
+        worker_loop(*w, ppid);
+    }
+    w->pid = pid;
+    try {
+        w->req.close_r();
+        w->rep.close_w();
+        // LCOV_EXCL_START
+    } catch (...) {
+        ::kill(pid, SIGKILL);
+        while (::waitpid(pid, nullptr, 0) == -1 && errno == EINTR) {
+        }
+        throw;
+    }
+    // LCOV_EXCL_STOP
+    m_worker = std::move(w);
+    m_worker_pid.store(pid);
+}
+
+// Forcibly terminate the worker, if any.
+inline void fork_island::kill_worker() const noexcept
+{
+    if (!m_worker) {
+        return;
+    }
+    const auto pid = m_worker->pid;
+    ::kill(pid, SIGKILL);
+    while (::waitpid(pid, nullptr, 0) == -1 && errno == EINTR) {
+    }
+    m_worker.reset();
+    m_worker_pid.store(0);
+}
+
+// Ask the worker, if any, to quit and wait for its termination.
+inline void fork_island::stop_worker() const noexcept
+{
+    if (!m_worker) {
+        return;
+    }
+    try {
+        sigpipe_guard sg;
+        std::stringstream ss;
+        {
+            cereal::BinaryOutputArchive oarchive(ss);
+            oarchive(0, false, false, detail::stop_token::clock_t::rep(0));
+        }
+        write_frame(m_worker->req, ss.str());
+    } catch (...) {
+        // The worker cannot be reached, kill it.
+        kill_worker();
+        return;
+    }
+    const auto pid = m_worker->pid;
+    // NOTE: this will close our ends of the pipes.
+    m_worker.reset();
+    while (::waitpid(pid, nullptr, 0) == -1 && errno == EINTR) {
+    }
+    m_worker_pid.store(0);
+}
+
+inline void fork_island::run_evolve_persistent(island &isl) const
+{
+    std::lock_guard<std::mutex> lock(m_worker_mutex);
+    const auto algo = isl.get_algorithm_snapshot();
+    const auto pop = isl.get_population_snapshot();
+    if (!m_worker) {
+        start_worker(*pop);
+    }
+    auto &w = *m_worker;
+    // Send to the worker only the state which changed since the last evolution.
+    const bool send_algo = algo != w.algo, send_pop = pop != w.pop;
+    int status = 0;
+    std::string msg;
+    algorithm new_algo;
+    population new_pop;
+    try {
+        pid_setter ps(m_pid, w.pid);
+        std::string rep;
+        {
+            sigpipe_guard sg;
+            const auto cur = detail::current_stop_token();
+            const auto deadline = cur ? cur->deadline : detail::stop_token::clock_t::time_point::max();
+            w.stop.get().store(0);
+            std::stringstream ss;
+            {
+                cereal::BinaryOutputArchive oarchive(ss);
+                oarchive(1, send_algo, send_pop, deadline.time_since_epoch().count());
+                if (send_algo) {
+                    oarchive(*algo);
+                }
+                if (send_pop) {
+                    save_pop(oarchive, *pop, w.shm.get());
+                }
+            }
+            write_frame(w.req, ss.str());
+        }
+        const auto pid = w.pid;
+        const auto &stop = w.stop;
+        rep = read_frame(w.rep, [pid, &stop]() {
+            stop.forward();
+            ::siginfo_t info;
+            info.si_pid = 0;
+            return ::waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == 0 && !info.si_pid;
+        });
+        std::stringstream ss(rep);
+        {
+            cereal::BinaryInputArchive iarchive(ss);
+            iarchive(status, msg);
+            if (!status) {
+                iarchive(new_algo);
+                load_pop(iarchive, new_pop, w.shm.get());
+            }
+        }
+    } catch (...) {
+        // Communication with the worker failed. Kill it, a new
+        // one will be spawned by the next evolution.
+        kill_worker();
+        throw;
+    }
+    ++w.n_tasks;
+    const bool recycle = m_max_tasks && w.n_tasks >= m_max_tasks;
+    if (status) {
+        // The state of the worker is now unknown, it will be sent again in full.
+        w.algo.reset();
+        w.pop.reset();
+        if (recycle) {
+            stop_worker();
+        }
+        pagmo_throw(std::runtime_error, "The run_evolve() method of fork_island raised an error in the "
+                                        "persistent worker process. The full error message reported by the worker is:\n"
+                                            + msg);
+    }
+    w.algo = isl.publish_algorithm(std::move(new_algo));
+    w.pop = isl.publish_population(std::move(new_pop));
+    if (recycle) {
+        stop_worker();
+    }
+}
+
 #endif
 
+/// Migration mode.
+/**
+ * This enumeration selects how the islands of a pagmo::archipelago exchange individuals
+ * during archipelago::evolve().
+ */
+enum class migration_mode {
+    asynchronous = 0, ///< Each island evolves at its own pace, importing the emigrants most recently
+                      /// published by its neighbours
+    synchronous = 1   ///< The islands evolve in lockstep rounds, and in each round they import the
+                      /// emigrants published by their neighbours at the end of the previous round
+};
+
+namespace detail
+{
+
+// The state of a synchronous evolution (see archipelago::evolve()).
+struct sync_migration_state {
+    // If unbounded is true, the rounds continue until the deadline of the tokens.
+    unsigned n_rounds = 0;
+    bool unbounded = false;
+    unsigned round = 0;
+    // Number of islands which have not completed the current round yet.
+    std::atomic<std::size_t> remaining{0};
+    std::vector<island *> islands;
+    // The emigrants published at the end of the previous round.
+    std::vector<std::shared_ptr<const island_migrants>> snapshot;
+    std::vector<std::exception_ptr> errors;
+    std::vector<std::promise<void>> promises;
+    // The stop tokens of the islands.
+    std::vector<stop_token> tokens;
+};
+
+} // namespace detail
+
 /// Archipelago.
 /**
  * \image html archi_no_text.png
@@ -1628,9 +2587,16 @@ inline void fork_island::run_evolve(island &isl) const
  * state of the archipelago and access its island members. The user can explicitly wait for pending evolutions
  * to conclude by calling the wait() and wait_check() methods. The status of
  * ongoing evolutions in the archipelago can be queried via status().
+ *
+ * The islands of an archipelago can exchange individuals (migration) along the edges of a pagmo::topology
+ * (see set_topology()). The default topology, pagmo::unconnected, disables migration. The individuals
+ * leaving and entering each island are chosen by the island's selection and replacement policies
+ * (see island::set_s_policy() and island::set_r_policy()).
  */
 class archipelago
 {
+    // The islands need access to the migration machinery.
+    friend class island;
     using container_t = std::vector<std::unique_ptr<island>>;
     using size_type_implementation = container_t::size_type;
     using iterator_implementation = boost::indirect_iterator<container_t::iterator>;
@@ -1683,13 +2649,16 @@ public:
      *
      * @throws unspecified any exception thrown by archipelago::push_back().
      */
-    archipelago(const archipelago &other)
+    archipelago(const archipelago &other) : m_pool(other.m_pool)
     {
         for (const auto &iptr : other.m_islands) {
             // This will end up copying the island members,
             // and assign the archi pointer as well.
             push_back(*iptr);
         }
+        // NOTE: push_back() added vertices to the default topology,
+        // overwrite it with the topology of other.
+        m_topology = other.get_topology();
     }
     /// Move constructor.
     /**
@@ -1707,10 +2676,14 @@ public:
         other.wait_check_ignore();
         // Move in the islands.
         m_islands = std::move(other.m_islands);
+        m_pool = std::move(other.m_pool);
+        m_topology = std::move(other.m_topology);
         // Re-direct the archi pointers to point to this.
         for (const auto &iptr : m_islands) {
             iptr->m_ptr->archi_ptr = this;
         }
+        // NOTE: leave other with a valid topology.
+        other.m_topology = topology{};
     }
 
 private:
@@ -1824,10 +2797,14 @@ public:
             other.wait_check_ignore();
             // Move in the islands.
             m_islands = std::move(other.m_islands);
+            m_pool = std::move(other.m_pool);
+            m_topology = std::move(other.m_topology);
             // Re-direct the archi pointers to point to this.
             for (const auto &iptr : m_islands) {
                 iptr->m_ptr->archi_ptr = this;
             }
+            // NOTE: leave other with a valid topology.
+            other.m_topology = topology{};
         }
         return *this;
     }
@@ -1921,37 +2898,138 @@ public:
      *
      * This method will construct an island from the supplied arguments and add it to the archipelago.
      * Islands are added at the end of the archipelago (that is, the new island will have an index
-     * equal to the value of size() before the call to this method).
+     * equal to the value of size() before the call to this method). A new vertex, corresponding to the
+     * new island, will also be added to the archipelago's topology via topology::push_back().
      *
      * @param args the arguments that will be used for the construction of the island.
      *
-     * @throws unspecified any exception thrown by memory allocation errors or by the invoked constructor
-     * of pagmo::island.
+     * @throws unspecified any exception thrown by memory allocation errors, by the invoked constructor
+     * of pagmo::island or by topology::push_back().
      */
     template <typename... Args, push_back_enabler<Args...> = 0>
     void push_back(Args &&... args)
     {
-        m_islands.emplace_back(detail::make_unique<island>(std::forward<Args>(args)...));
-        // NOTE: this is noexcept.
+        auto new_isl = detail::make_unique<island>(std::forward<Args>(args)...);
+        {
+            // NOTE: the evolution tasks of the other islands access the
+            // islands and the topology under this lock.
+            std::lock_guard<std::mutex> lock(m_migr_mutex);
+            m_islands.reserve(m_islands.size() + 1u);
+            m_topology.push_back();
+            // NOTE: this is noexcept, the storage was reserved above.
+            m_islands.push_back(std::move(new_isl));
+        }
+        // NOTE: these are noexcept.
         m_islands.back()->m_ptr->archi_ptr = this;
+        m_islands.back()->m_ptr->archi_idx = m_islands.size() - 1u;
+        if (m_pool) {
+            // NOTE: the new island is not evolving, thus this will not wait.
+            m_islands.back()->m_ptr->queue.set_pool(m_pool);
+        }
     }
     /// Evolve archipelago.
     /**
-     * This method will call island::evolve() on all the islands of the archipelago.
-     * The input parameter \p n will be passed to the invocations of island::evolve() for each island.
+     * If \p mode is migration_mode::asynchronous, this method will call island::evolve() on all the islands
+     * of the archipelago. The input parameter \p n will be passed to the invocations of island::evolve() for
+     * each island: each island will then evolve at its own pace, importing at each step the emigrants most
+     * recently published by its neighbours.
+     *
+     * If \p mode is migration_mode::synchronous, the islands will instead evolve in \p n lockstep rounds:
+     * in each round, every island imports the emigrants published by its neighbours at the end of the previous
+     * round, evolves once and publishes new emigrants. The next round starts only after all the islands have
+     * completed the current one, without blocking any thread while waiting. Exceptions are stored
+     * in the islands as usual, and an island which threw skips the remaining rounds. The evolution
+     * of each island is reported as finished (e.g., by island::status()) only after the last round
+     * has been completed by all the islands.
+     *
      * archipelago::status() can be used to query the status of the asynchronous operations in the
      * archipelago.
      *
-     * @param n the parameter that will be passed to island::evolve().
+     * @param n the number of evolution steps.
+     * @param mode the migration mode.
      *
-     * @throws unspecified any exception thrown by island::evolve().
+     * @throws unspecified any exception thrown by island::evolve(), threading primitives
+     * or memory allocation errors.
      */
-    void evolve(unsigned n = 1)
+    void evolve(unsigned n = 1, migration_mode mode = migration_mode::asynchronous)
+    {
+        evolve_impl(n, false, detail::stop_token::clock_t::time_point::max(), mode);
+    }
+    /// Evolve archipelago with a deadline.
+    /**
+     * This method is equivalent to evolve(), except that the islands will keep on evolving until \p d has
+     * elapsed (counting from the invocation of this method), rather than for a fixed number of steps. If \p mode
+     * is migration_mode::asynchronous, this method will call island::evolve_for() on all the islands of the
+     * archipelago. Otherwise, no synchronous round will be started after the deadline. When the deadline passes,
+     * the ongoing evolutions are asked to stop (see pagmo::stop_requested()): algorithms which support cooperative
+     * cancellation will then return the best population found so far, while the other algorithms will run
+     * to completion.
+     *
+     * @param d the duration of the evolution.
+     * @param mode the migration mode.
+     *
+     * @throws unspecified any exception thrown by island::evolve_for(), threading primitives
+     * or memory allocation errors.
+     */
+    template <typename Rep, typename Period>
+    void evolve_for(const std::chrono::duration<Rep, Period> &d, migration_mode mode = migration_mode::asynchronous)
+    {
+        evolve_impl(0, true,
+                    detail::stop_token::clock_t::now()
+                        + std::chrono::duration_cast<detail::stop_token::clock_t::duration>(d),
+                    mode);
+    }
+    /// Cancel the evolution.
+    /**
+     * This method will call island::cancel() on all the islands of the archipelago. A synchronous evolution
+     * will not start new rounds after the cancellation.
+     */
+    void cancel()
+    {
+        for (auto &iptr : m_islands) {
+            iptr->cancel();
+        }
+    }
+
+private:
+    void evolve_impl(unsigned n, bool unbounded, detail::stop_token::clock_t::time_point deadline,
+                     migration_mode mode)
     {
+        if (mode == migration_mode::asynchronous) {
+            for (auto &iptr : m_islands) {
+                iptr->evolve_impl(unbounded ? 0u : n, deadline);
+            }
+            return;
+        }
+        if (m_islands.empty()) {
+            return;
+        }
+        auto st = std::make_shared<detail::sync_migration_state>();
+        st->n_rounds = n;
+        st->unbounded = unbounded;
+        st->errors.resize(m_islands.size());
+        st->promises.resize(m_islands.size());
         for (auto &iptr : m_islands) {
-            iptr->evolve(n);
+            detail::stop_token tok;
+            tok.gen = &iptr->m_ptr->cancel_gen;
+            tok.expected = iptr->m_ptr->cancel_gen.load();
+            tok.deadline = deadline;
+            st->tokens.push_back(tok);
+            st->islands.push_back(iptr.get());
+            // NOTE: reserve here, so that the loop below cannot throw.
+            iptr->m_ptr->futures.reserve(iptr->m_ptr->futures.size() + 1u);
+        }
+        for (decltype(m_islands.size()) i = 0; i < m_islands.size(); ++i) {
+            m_islands[i]->m_ptr->futures.push_back(st->promises[i].get_future());
+        }
+        if (unbounded || n) {
+            sync_round(st);
+        } else {
+            sync_finish(*st);
         }
     }
+
+public:
     /// Block until all evolutions have finished.
     /**
      * This method will call island::wait() on all the islands of the archipelago. Exceptions thrown by island
@@ -2132,22 +3210,58 @@ public:
      *
      * @throws unspecified any exception thrown by:
      * - the streaming of primitive types,
-     * - island::get_algorithm(), island::get_population().
+     * - island::get_algorithm_snapshot(), island::get_population_snapshot().
      */
     friend std::ostream &operator<<(std::ostream &os, const archipelago &archi)
     {
         stream(os, "Number of islands: ", archi.size(), "\n");
+        stream(os, "Topology: ", archi.get_topology().get_name(), "\n");
         stream(os, "Status: ", archi.status(), "\n\n");
         stream(os, "Islands summaries:\n\n");
         detail::table t({"#", "Type", "Algo", "Prob", "Size", "Status"}, "\t");
         for (decltype(archi.size()) i = 0; i < archi.size(); ++i) {
-            const auto pop = archi[i].get_population();
-            t.add_row(i, archi[i].get_name(), archi[i].get_algorithm().get_name(), pop.get_problem().get_name(),
-                      pop.size(), archi[i].status());
+            const auto pop = archi[i].get_population_snapshot();
+            t.add_row(i, archi[i].get_name(), archi[i].get_algorithm_snapshot()->get_name(),
+                      pop->get_problem().get_name(), pop->size(), archi[i].status());
         }
         stream(os, t);
         return os;
     }
+    /// Get the champion records of the islands.
+    /**
+     * This method will collect the latest champion records published by the islands
+     * (see island::get_champion()). The records are read via atomic operations, thus this method
+     * never waits on ongoing evolutions and its cost does not depend on the sizes of the populations.
+     *
+     * It is safe to call this method while the archipelago is evolving.
+     *
+     * @param with_nd if \p false, the non-dominated summaries of multi-objective islands
+     * (pagmo::island_champion::nd_x and pagmo::island_champion::nd_f) will not be included in the output.
+     *
+     * @return a collection of the champion records of the islands.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    std::vector<island_champion> get_champions(bool with_nd = false) const
+    {
+        std::vector<island_champion> retval;
+        retval.reserve(m_islands.size());
+        for (const auto &isl_ptr : m_islands) {
+            const auto champ = isl_ptr->get_champion();
+            if (with_nd) {
+                retval.push_back(*champ);
+            } else {
+                island_champion tmp;
+                tmp.n_evolve = champ->n_evolve;
+                tmp.timestamp = champ->timestamp;
+                tmp.has_champion = champ->has_champion;
+                tmp.x = champ->x;
+                tmp.f = champ->f;
+                retval.push_back(std::move(tmp));
+            }
+        }
+        return retval;
+    }
     /// Get the fitness vectors of the islands' champions.
     /**
      * @return a collection of the fitness vectors of the islands' champions.
@@ -2159,7 +3273,13 @@ public:
     {
         std::vector<vector_double> retval;
         for (const auto &isl_ptr : m_islands) {
-            retval.emplace_back(isl_ptr->get_population().champion_f());
+            const auto champ = isl_ptr->get_champion();
+            if (champ->has_champion) {
+                retval.emplace_back(champ->f);
+            } else {
+                // NOTE: this will throw the appropriate error.
+                retval.emplace_back(isl_ptr->get_population_snapshot()->champion_f());
+            }
         }
         return retval;
     }
@@ -2174,22 +3294,78 @@ public:
     {
         std::vector<vector_double> retval;
         for (const auto &isl_ptr : m_islands) {
-            retval.emplace_back(isl_ptr->get_population().champion_x());
+            const auto champ = isl_ptr->get_champion();
+            if (champ->has_champion) {
+                retval.emplace_back(champ->x);
+            } else {
+                // NOTE: this will throw the appropriate error.
+                retval.emplace_back(isl_ptr->get_population_snapshot()->champion_x());
+            }
+        }
+        return retval;
+    }
+    /// Set the topology.
+    /**
+     * This method will set the topology used for migration. The topology is expected to contain
+     * no vertices: one vertex per island will be added to it via topology::push_back(), following
+     * the order in which the islands were inserted into the archipelago.
+     *
+     * It is safe to call this method while the archipelago is evolving.
+     *
+     * @param t the new topology.
+     *
+     * @throws unspecified any exception thrown by topology::push_back() or by threading primitives.
+     */
+    void set_topology(topology t)
+    {
+        t.push_back(m_islands.size());
+        std::lock_guard<std::mutex> lock(m_migr_mutex);
+        m_topology = std::move(t);
+    }
+    /// Get the topology.
+    /**
+     * It is safe to call this method while the archipelago is evolving.
+     *
+     * @return a copy of the topology used for migration.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by the copy constructor of
+     * pagmo::topology.
+     */
+    topology get_topology() const
+    {
+        std::lock_guard<std::mutex> lock(m_migr_mutex);
+        return m_topology;
+    }
+    /// Get the migrants database.
+    /**
+     * It is safe to call this method while the archipelago is evolving.
+     *
+     * @return a vector containing, for each island, the group of emigrants it published last (an empty group
+     * if the island has not published any emigrant yet).
+     *
+     * @throws unspecified any exception thrown by memory allocation errors.
+     */
+    std::vector<individuals_group_t> get_migrants_db() const
+    {
+        std::vector<individuals_group_t> retval;
+        for (const auto &iptr : m_islands) {
+            const auto m = std::atomic_load(&iptr->m_ptr->emigrants);
+            retval.push_back(m ? m->inds : individuals_group_t{});
         }
         return retval;
     }
     /// Save to archive.
     /**
-     * This method will save to \p ar the islands of the archipelago.
+     * This method will save to \p ar the islands and the topology of the archipelago.
      *
      * @param ar the output archive.
      *
-     * @throws unspecified any exception thrown by the serialization of pagmo::island.
+     * @throws unspecified any exception thrown by the serialization of pagmo::island and pagmo::topology.
      */
     template <typename Archive>
     void save(Archive &ar) const
     {
-        ar(m_islands);
+        ar(m_islands, get_topology());
     }
     /// Load from archive.
     /**
@@ -2198,19 +3374,220 @@ public:
      *
      * @param ar the input archive.
      *
-     * @throws unspecified any exception thrown by the deserialization of pagmo::island.
+     * @throws unspecified any exception thrown by the deserialization of pagmo::island and pagmo::topology.
      */
     template <typename Archive>
     void load(Archive &ar)
     {
         archipelago tmp;
-        ar(tmp.m_islands);
+        ar(tmp.m_islands, tmp.m_topology);
+        // NOTE: the archi pointers will be set by the move assignment below.
+        for (decltype(tmp.m_islands.size()) i = 0; i < tmp.m_islands.size(); ++i) {
+            tmp.m_islands[i]->m_ptr->archi_idx = i;
+        }
+        // NOTE: the thread pool is not part of the archived state,
+        // the islands will keep on using the pool of this.
+        tmp.set_pool(m_pool);
         *this = std::move(tmp);
     }
+    /// Set the number of threads.
+    /**
+     * By default, the evolutions of all islands (in all archipelagos) are run by a single pool of worker threads
+     * shared process-wide and sized according to <tt>std::thread::hardware_concurrency()</tt>. This method
+     * will make the islands of \p this (including the islands added later via push_back()) run their evolutions
+     * on a dedicated pool of \p n threads instead. If \p n is zero, the islands will be moved back to the shared pool.
+     * In either case, the evolution tasks of each island are still executed one at a time and in order.
+     *
+     * This method will wait for any ongoing evolution in \p this to finish before taking any action.
+     * Errors raised by the evolutions will not be re-thrown (see archipelago::wait()). Copies of \p this share
+     * its pool, while the pool is not saved when serialising \p this.
+     *
+     * @param n the number of threads in the dedicated pool, or zero to use the shared pool.
+     *
+     * @throws unspecified any exception thrown by threading primitives or memory allocation errors.
+     */
+    void set_n_threads(unsigned n)
+    {
+        wait();
+        set_pool(n ? std::make_shared<detail::thread_pool>(n) : std::shared_ptr<detail::thread_pool>{});
+    }
+    /// Get the number of threads.
+    /**
+     * @return the number of threads of the pool used by the islands of \p this (either a dedicated pool created
+     * by set_n_threads(), or the pool shared process-wide).
+     */
+    unsigned get_n_threads() const
+    {
+        return m_pool ? m_pool->size() : detail::thread_pool::shared()->size();
+    }
 
 private:
+    // Move all islands onto a new pool (null means the shared pool).
+    // NOTE: the islands must not be evolving.
+    void set_pool(std::shared_ptr<detail::thread_pool> pool)
+    {
+        for (const auto &iptr : m_islands) {
+            iptr->m_ptr->queue.set_pool(pool ? pool : detail::thread_pool::shared());
+        }
+        m_pool = std::move(pool);
+    }
+    // Fetch the immigrants for the island at index idx. The groups of emigrants already imported
+    // by the island (as recorded in last_imported) are skipped. If snapshot is not null, the emigrants
+    // are taken from it, rather than from the current buffers of the islands.
+    individuals_group_t get_immigrants(std::size_t idx, std::vector<unsigned long long> &last_imported,
+                                       const std::vector<std::shared_ptr<const detail::island_migrants>> *snapshot)
+    {
+        std::vector<std::pair<std::size_t, std::shared_ptr<const detail::island_migrants>>> groups;
+        {
+            std::lock_guard<std::mutex> lock(m_migr_mutex);
+            if (m_topology.is<unconnected>()) {
+                return individuals_group_t{};
+            }
+            const auto conn = m_topology.get_connections(idx);
+            std::uniform_real_distribution<double> drng(0., 1.);
+            for (decltype(conn.first.size()) i = 0; i < conn.first.size(); ++i) {
+                const auto src = conn.first[i];
+                if (src >= m_islands.size()) {
+                    pagmo_throw(std::invalid_argument,
+                                "The topology '" + m_topology.get_name() + "' connects the island at index "
+                                    + std::to_string(idx) + " to the island at index " + std::to_string(src)
+                                    + ", but the archipelago contains only " + std::to_string(m_islands.size())
+                                    + " islands");
+                }
+                // Migration along the edge happens with a probability equal to its weight.
+                if (conn.second[i] < 1. && !(drng(m_migr_e) < conn.second[i])) {
+                    continue;
+                }
+                if (snapshot) {
+                    if (src < snapshot->size()) {
+                        groups.emplace_back(src, (*snapshot)[src]);
+                    }
+                } else {
+                    groups.emplace_back(src, std::atomic_load(&m_islands[src]->m_ptr->emigrants));
+                }
+            }
+        }
+        individuals_group_t retval;
+        for (const auto &g : groups) {
+            if (!g.second) {
+                continue;
+            }
+            if (last_imported.size() <= g.first) {
+                last_imported.resize(g.first + 1u, 0u);
+            }
+            if (last_imported[g.first] == g.second->seq) {
+                continue;
+            }
+            last_imported[g.first] = g.second->seq;
+            const auto &inds = g.second->inds;
+            std::get<0>(retval).insert(std::get<0>(retval).end(), std::get<0>(inds).begin(), std::get<0>(inds).end());
+            std::get<1>(retval).insert(std::get<1>(retval).end(), std::get<1>(inds).begin(), std::get<1>(inds).end());
+            std::get<2>(retval).insert(std::get<2>(retval).end(), std::get<2>(inds).begin(), std::get<2>(inds).end());
+        }
+        return retval;
+    }
+    // Check if the islands need to publish emigrants.
+    bool migration_enabled() const
+    {
+        std::lock_guard<std::mutex> lock(m_migr_mutex);
+        return !m_topology.is<unconnected>();
+    }
+    // Start a round of a synchronous evolution.
+    static void sync_round(const std::shared_ptr<detail::sync_migration_state> &st)
+    {
+        // Freeze the emigrants published in the previous round.
+        st->snapshot.clear();
+        for (auto isl : st->islands) {
+            st->snapshot.push_back(std::atomic_load(&isl->m_ptr->emigrants));
+        }
+        st->remaining.store(st->islands.size());
+        for (decltype(st->islands.size()) i = 0; i < st->islands.size(); ++i) {
+            try {
+                st->islands[i]->m_ptr->queue.enqueue([st, i]() { sync_step(st, i); });
+                // LCOV_EXCL_START
+            } catch (...) {
+                if (!st->errors[i]) {
+                    st->errors[i] = std::current_exception();
+                }
+                sync_done(st);
+            }
+            // LCOV_EXCL_STOP
+        }
+    }
+    // A single island's step in a round of a synchronous evolution.
+    static void sync_step(const std::shared_ptr<detail::sync_migration_state> &st, std::size_t i)
+    {
+        if (!st->errors[i] && !st->tokens[i].stop_requested()) {
+            try {
+                st->islands[i]->evolve_step(&st->snapshot, st->tokens[i]);
+            } catch (...) {
+                st->errors[i] = std::current_exception();
+            }
+        }
+        sync_done(st);
+    }
+    // Invoked whenever an island completes a round: the last island to complete
+    // the round starts the next one.
+    static void sync_done(const std::shared_ptr<detail::sync_migration_state> &st)
+    {
+        if (st->remaining.fetch_sub(1u) != 1u) {
+            return;
+        }
+        // NOTE: stop when all the islands were cancelled or the deadline has passed.
+        const auto stopped = std::all_of(st->tokens.begin(), st->tokens.end(),
+                                         [](const detail::stop_token &t) { return t.stop_requested(); });
+        if (!stopped && (st->unbounded || ++st->round < st->n_rounds)) {
+            sync_round(st);
+        } else {
+            sync_finish(*st);
+        }
+    }
+    static void sync_finish(detail::sync_migration_state &st)
+    {
+        for (decltype(st.promises.size()) i = 0; i < st.promises.size(); ++i) {
+            if (st.errors[i]) {
+                st.promises[i].set_exception(st.errors[i]);
+            } else {
+                st.promises[i].set_value();
+            }
+        }
+    }
+
+    // The dedicated thread pool, if any.
+    // NOTE: this is declared before the islands,
+    // so that it is destroyed after them.
+    std::shared_ptr<detail::thread_pool> m_pool;
     container_t m_islands;
+    // The migration data. The mutex protects the topology and the engine,
+    // as well as the access to the islands from within the evolution tasks.
+    mutable std::mutex m_migr_mutex;
+    topology m_topology;
+    detail::random_engine_type m_migr_e{
+        static_cast<detail::random_engine_type::result_type>(random_device::next())};
 };
+
+inline void island::evolve_step(const std::vector<std::shared_ptr<const detail::island_migrants>> *snapshot,
+                                const detail::stop_token &tok)
+{
+    detail::stop_token_setter sts(tok);
+    const auto archi = m_ptr->archi_ptr;
+    if (archi) {
+        const auto imm = archi->get_immigrants(m_ptr->archi_idx, m_ptr->last_imported, snapshot);
+        if (!std::get<0>(imm).empty()) {
+            auto pop = get_population();
+            get_r_policy().replace(pop, imm);
+            set_population(std::move(pop));
+        }
+    }
+    m_ptr->isl_ptr->run_evolve(*this);
+    bump_champion();
+    if (archi && archi->migration_enabled()) {
+        auto inds = get_s_policy().select(*get_population_snapshot());
+        std::atomic_store(&m_ptr->emigrants,
+                          std::shared_ptr<const detail::island_migrants>(std::make_shared<detail::island_migrants>(
+                              detail::island_migrants{std::move(inds), m_ptr->n_evolve.load()})));
+    }
+}
 } // namespace pagmo
 
 PAGMO_REGISTER_ISLAND(pagmo::thread_island)
@@ -0,0 +1,275 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_LATENCY_HISTOGRAM_HPP
+#define PAGMO_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/serialization.hpp>
+
+namespace pagmo
+{
+
+/// Latency histogram.
+/**
+ * This class records durations (e.g., the latencies of the calls to the fitness function of a problem, see
+ * problem::set_latency_tracking()) into a fixed number of buckets on a base-2 logarithmic scale. Bucket 0 counts
+ * durations shorter than 2 nanoseconds, bucket \f$ i > 0 \f$ counts durations in the
+ * \f$ \left[ 2^i, 2^{i+1} \right) \f$ nanoseconds range, and the last bucket counts also all the
+ * longer durations. The total number of recorded durations and their sum are kept as well.
+ *
+ * Recording and reading the data are lock-free, thread-safe operations. A read concurrent with a recording
+ * returns a consistent value for each individual quantity, but different quantities might reflect
+ * different points in time.
+ */
+class latency_histogram
+{
+public:
+    /// The duration type used by the histogram.
+    using duration = std::chrono::nanoseconds;
+    /// The number of buckets.
+    /**
+     * The last bucket starts at \f$ 2^{39} \f$ nanoseconds (i.e., about 9 minutes).
+     */
+    static const std::size_t n_buckets = 40u;
+    /// Default constructor.
+    /**
+     * The histogram will be initialised empty.
+     */
+    latency_histogram()
+    {
+        reset();
+    }
+    /// Copy constructor.
+    /**
+     * @param other the histogram that will be copied.
+     */
+    latency_histogram(const latency_histogram &other)
+    {
+        assign(other);
+    }
+    /// Copy assignment operator.
+    /**
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     */
+    latency_histogram &operator=(const latency_histogram &other)
+    {
+        if (this != &other) {
+            assign(other);
+        }
+        return *this;
+    }
+    /// Record a duration.
+    /**
+     * This method will record \p n occurrences of the duration \p d. Negative durations are recorded as zero.
+     *
+     * @param d the duration to be recorded.
+     * @param n the number of occurrences of \p d.
+     */
+    void record(duration d, unsigned long long n = 1u)
+    {
+        const auto ns = d.count() > 0 ? static_cast<unsigned long long>(d.count()) : 0ull;
+        m_counts[get_bucket(ns)].fetch_add(n, std::memory_order_relaxed);
+        m_count.fetch_add(n, std::memory_order_relaxed);
+        m_total.fetch_add(ns * n, std::memory_order_relaxed);
+    }
+    /// Get the counts of the buckets.
+    /**
+     * @return an array containing the number of durations recorded in each bucket.
+     */
+    std::array<unsigned long long, n_buckets> get_counts() const
+    {
+        std::array<unsigned long long, n_buckets> retval;
+        for (std::size_t i = 0; i < n_buckets; ++i) {
+            retval[i] = m_counts[i].load(std::memory_order_relaxed);
+        }
+        return retval;
+    }
+    /// Get the number of recorded durations.
+    /**
+     * @return the total number of durations recorded in the histogram.
+     */
+    unsigned long long get_count() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+    /// Get the total recorded time.
+    /**
+     * @return the sum of the durations recorded in the histogram.
+     */
+    duration get_total() const
+    {
+        return duration(static_cast<duration::rep>(m_total.load(std::memory_order_relaxed)));
+    }
+    /// Get the bounds of a bucket.
+    /**
+     * @param i the index of the bucket.
+     *
+     * @return the half-open range \f$ \left[ a, b \right) \f$ of the durations counted in the bucket \p i
+     * (for the last bucket, \f$ b \f$ is the maximum representable duration).
+     *
+     * @throws std::out_of_range if \p i is not less than latency_histogram::n_buckets.
+     */
+    static std::pair<duration, duration> get_bucket_bounds(std::size_t i)
+    {
+        if (i >= n_buckets) {
+            pagmo_throw(std::out_of_range, "Invalid bucket index " + std::to_string(i)
+                                               + ": the number of buckets is " + std::to_string(n_buckets));
+        }
+        const auto lb = i ? duration(duration::rep(1) << i) : duration(0);
+        const auto ub = i == n_buckets - 1u ? duration::max() : duration(duration::rep(1) << (i + 1u));
+        return std::make_pair(lb, ub);
+    }
+    /// Reset the histogram.
+    /**
+     * This method will discard all the recorded durations.
+     */
+    void reset()
+    {
+        for (auto &c : m_counts) {
+            c.store(0u, std::memory_order_relaxed);
+        }
+        m_count.store(0u, std::memory_order_relaxed);
+        m_total.store(0u, std::memory_order_relaxed);
+    }
+    /// Stream operator.
+    /**
+     * This operator will print to \p os the number of recorded durations, their mean value and
+     * the non-empty buckets.
+     *
+     * @param os the target stream.
+     * @param h the histogram.
+     *
+     * @return a reference to \p os.
+     *
+     * @throws unspecified any exception thrown by the stream operators of fundamental types.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const latency_histogram &h)
+    {
+        const auto count = h.get_count();
+        os << "Number of calls: " << count;
+        if (count) {
+            os << ", mean latency: " << h.get_total().count() / static_cast<duration::rep>(count) << " ns";
+            const auto counts = h.get_counts();
+            for (std::size_t i = 0; i < n_buckets; ++i) {
+                if (counts[i]) {
+                    const auto b = get_bucket_bounds(i);
+                    os << "\n\t\t[" << b.first.count() << ", ";
+                    if (i == n_buckets - 1u) {
+                        os << "inf";
+                    } else {
+                        os << b.second.count();
+                    }
+                    os << ") ns: " << counts[i];
+                }
+            }
+        }
+        return os;
+    }
+    /// Save to archive.
+    /**
+     * @param ar the target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types or of
+     * <tt>std::vector</tt>.
+     */
+    template <typename Archive>
+    void save(Archive &ar) const
+    {
+        const auto counts = get_counts();
+        ar(std::vector<unsigned long long>(counts.begin(), counts.end()), get_count(),
+           m_total.load(std::memory_order_relaxed));
+    }
+    /// Load from archive.
+    /**
+     * @param ar the source archive.
+     *
+     * @throws std::invalid_argument if the number of buckets in the archive is not latency_histogram::n_buckets.
+     * @throws unspecified any exception thrown by the deserialization of primitive types or of
+     * <tt>std::vector</tt>.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        std::vector<unsigned long long> counts;
+        unsigned long long count, total;
+        ar(counts, count, total);
+        if (counts.size() != n_buckets) {
+            pagmo_throw(std::invalid_argument, "Cannot load a latency histogram with " + std::to_string(counts.size())
+                                                   + " buckets: the number of buckets must be "
+                                                   + std::to_string(n_buckets));
+        }
+        for (std::size_t i = 0; i < n_buckets; ++i) {
+            m_counts[i].store(counts[i], std::memory_order_relaxed);
+        }
+        m_count.store(count, std::memory_order_relaxed);
+        m_total.store(total, std::memory_order_relaxed);
+    }
+
+private:
+    // Index of the bucket for a duration of ns nanoseconds.
+    static std::size_t get_bucket(unsigned long long ns)
+    {
+        std::size_t retval = 0;
+        while ((ns >>= 1u) && retval < n_buckets - 1u) {
+            ++retval;
+        }
+        return retval;
+    }
+    void assign(const latency_histogram &other)
+    {
+        for (std::size_t i = 0; i < n_buckets; ++i) {
+            m_counts[i].store(other.m_counts[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        m_count.store(other.get_count(), std::memory_order_relaxed);
+        m_total.store(other.m_total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<unsigned long long>, n_buckets> m_counts;
+    std::atomic<unsigned long long> m_count;
+    // Total time, in nanoseconds.
+    std::atomic<unsigned long long> m_total;
+};
+
+} // namespace pagmo
+
+#endif
@@ -59,6 +59,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithms/simulated_annealing.hpp>
 #include <pagmo/algorithms/xnes.hpp>
 #include <pagmo/archipelago.hpp>
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/island.hpp>
@@ -66,6 +67,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/islands/fork_island.hpp>
 #endif
 #include <pagmo/islands/thread_island.hpp>
+#include <pagmo/latency_histogram.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/ackley.hpp>
@@ -86,6 +88,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
 #include <pagmo/problems/inventory.hpp>
 #include <pagmo/problems/luksan_vlcek1.hpp>
+#include <pagmo/problems/memoize.hpp>
 #include <pagmo/problems/minlp_rastrigin.hpp>
 #include <pagmo/problems/rastrigin.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
@@ -93,9 +96,19 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problems/translate.hpp>
 #include <pagmo/problems/unconstrain.hpp>
 #include <pagmo/problems/zdt.hpp>
+#include <pagmo/r_policies/fair_replace.hpp>
+#include <pagmo/r_policy.hpp>
 #include <pagmo/rng.hpp>
+#include <pagmo/s_policies/select_best.hpp>
+#include <pagmo/s_policy.hpp>
 #include <pagmo/serialization.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/threading.hpp>
+#include <pagmo/topologies/free_form.hpp>
+#include <pagmo/topologies/fully_connected.hpp>
+#include <pagmo/topologies/k_regular.hpp>
+#include <pagmo/topologies/ring.hpp>
+#include <pagmo/topology.hpp>
 #include <pagmo/type_traits.hpp>
 #include <pagmo/types.hpp>
 #include <pagmo/utils/constrained.hpp>
@@ -30,16 +30,21 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_POPULATION_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <limits>
-#include <numeric>
+#include <mutex>
 #include <random>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/rng.hpp>
 #include <pagmo/type_traits.hpp>
@@ -55,6 +60,41 @@ see https://www.gnu.org/licenses/. */
 
 namespace pagmo
 {
+
+namespace detail
+{
+
+// Lazily-built copy of the decision and fitness vectors of a population in the vector of vectors
+// layout, used to implement population::get_x() and population::get_f(). Once built, the copy is kept
+// up to date by the population. Copying or assigning a cache yields an empty cache.
+struct pop_vv_cache {
+    pop_vv_cache() : m_valid(false) {}
+    pop_vv_cache(const pop_vv_cache &) : pop_vv_cache() {}
+    pop_vv_cache &operator=(const pop_vv_cache &)
+    {
+        invalidate();
+        return *this;
+    }
+    void invalidate()
+    {
+        m_x.clear();
+        m_f.clear();
+        m_valid.store(false, std::memory_order_release);
+    }
+    bool valid() const
+    {
+        return m_valid.load(std::memory_order_acquire);
+    }
+    std::mutex m_mutex;
+    std::atomic<bool> m_valid;
+    std::vector<vector_double> m_x;
+    std::vector<vector_double> m_f;
+};
+
+struct population_access;
+
+} // namespace detail
+
 /// Population class.
 /**
  * \image html pop_no_text.png
@@ -75,6 +115,12 @@ namespace pagmo
  * only defined and accessible via the population interface if the pagmo::problem
  * currently contained in the pagmo::population is single objective.
  *
+ * The decision vectors and the fitness vectors of the individuals are stored contiguously, in two row-major
+ * matrices (one row per individual), which can be accessed directly via population::get_x_data() and
+ * population::get_f_data(), or via the lightweight row and column views returned by population::get_x_row(),
+ * population::get_f_row(), population::get_x_column() and population::get_f_column(). The vectors of vectors
+ * returned by population::get_x() and population::get_f() are built on first access, and then kept up to date.
+ *
  * \verbatim embed:rst:leading-asterisk
  * .. warning::
  *
@@ -85,6 +131,7 @@ namespace pagmo
  */
 class population
 {
+    friend struct detail::population_access;
     // Enable the generic ctor only if T is not a population (after removing
     // const/reference qualifiers).
     template <typename T>
@@ -95,6 +142,148 @@ class population
 public:
     /// The size type of the population.
     typedef std::vector<vector_double>::size_type size_type;
+
+    /// Row view.
+    /**
+     * A non-owning view of a contiguous range of values, such as the decision or fitness vector of an individual
+     * (see population::get_x_row() and population::get_f_row()). The view is invalidated by any
+     * operation modifying the size of the population, and it reflects the changes to the values it refers to.
+     */
+    class row_view
+    {
+    public:
+        /// Constructor.
+        /**
+         * @param data pointer to the first value.
+         * @param size number of values.
+         */
+        row_view(const double *data, size_type size) : m_data(data), m_size(size) {}
+        /// Number of values.
+        /**
+         * @return the number of values in the view.
+         */
+        size_type size() const
+        {
+            return m_size;
+        }
+        /// Pointer to the values.
+        /**
+         * @return a pointer to the first value of the view.
+         */
+        const double *data() const
+        {
+            return m_data;
+        }
+        /// Begin iterator.
+        /**
+         * @return a pointer to the first value of the view.
+         */
+        const double *begin() const
+        {
+            return m_data;
+        }
+        /// End iterator.
+        /**
+         * @return a pointer one past the last value of the view.
+         */
+        const double *end() const
+        {
+            return m_data + m_size;
+        }
+        /// Access a value.
+        /**
+         * @param i the index of the value (no bounds checking is performed).
+         *
+         * @return a reference to the value at index \p i.
+         */
+        const double &operator[](size_type i) const
+        {
+            assert(i < m_size);
+            return m_data[i];
+        }
+        /// Copy the values into a vector.
+        /**
+         * @return a vector containing the values of the view.
+         *
+         * @throws unspecified any exception thrown by memory errors in standard containers.
+         */
+        vector_double to_vector() const
+        {
+            return vector_double(begin(), end());
+        }
+
+    private:
+        const double *m_data;
+        size_type m_size;
+    };
+
+    /// Column view.
+    /**
+     * A non-owning view of a strided range of values, such as the values of a decision vector or fitness vector
+     * component across the population (see population::get_x_column() and population::get_f_column()). The view
+     * is invalidated by any operation modifying the size of the population, and it reflects the changes to the
+     * values it refers to.
+     */
+    class column_view
+    {
+    public:
+        /// Constructor.
+        /**
+         * @param data pointer to the first value.
+         * @param size number of values.
+         * @param stride distance between consecutive values.
+         */
+        column_view(const double *data, size_type size, size_type stride)
+            : m_data(data), m_size(size), m_stride(stride)
+        {
+        }
+        /// Number of values.
+        /**
+         * @return the number of values in the view.
+         */
+        size_type size() const
+        {
+            return m_size;
+        }
+        /// Distance between consecutive values.
+        /**
+         * @return the distance, in memory, between consecutive values of the view.
+         */
+        size_type stride() const
+        {
+            return m_stride;
+        }
+        /// Access a value.
+        /**
+         * @param i the index of the value (no bounds checking is performed).
+         *
+         * @return a reference to the value at index \p i.
+         */
+        const double &operator[](size_type i) const
+        {
+            assert(i < m_size);
+            return m_data[i * m_stride];
+        }
+        /// Copy the values into a vector.
+        /**
+         * @return a vector containing the values of the view.
+         *
+         * @throws unspecified any exception thrown by memory errors in standard containers.
+         */
+        vector_double to_vector() const
+        {
+            vector_double retval(m_size);
+            for (size_type i = 0u; i < m_size; ++i) {
+                retval[i] = m_data[i * m_stride];
+            }
+            return retval;
+        }
+
+    private:
+        const double *m_data;
+        size_type m_size;
+        size_type m_stride;
+    };
     /// Default constructor
     /**
      * Constructs an empty population with a pagmo::null_problem.
@@ -136,6 +325,49 @@ public:
         }
     }
 
+    /// Constructor from a problem, with parallel fitness evaluation.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is enabled only if, after the removal of cv/reference qualifiers,
+     *    ``T`` is not :cpp:class:`pagmo::population`, and if :cpp:class:`pagmo::problem` is constructible from ``T``.
+     *
+     * \endverbatim
+     *
+     * This constructor is equivalent to the constructor without the \p bfe argument, but all the random decision
+     * vectors (and the IDs of the individuals) are generated up front, and their fitnesses are then computed
+     * in a single batch evaluation via \p bfe. The resulting population is identical to the population
+     * created by the other constructor with the same arguments.
+     *
+     * @param x the problem the population refers to.
+     * @param pop_size population size (i.e. number of individuals therein).
+     * @param bfe the batch fitness evaluator that will be used to compute the fitnesses of the individuals.
+     * @param seed seed of the random number generator used, for example, to
+     * create new random individuals within the bounds.
+     *
+     * @throws unspecified any exception thrown by random_decision_vector(), by the call operator of
+     * pagmo::thread_bfe, by the invoked constructor of pagmo::problem, or by memory errors in standard containers.
+     */
+    template <typename T, generic_ctor_enabler<T> = 0>
+    explicit population(T &&x, size_type pop_size, const thread_bfe &bfe,
+                        unsigned seed = pagmo::random_device::next())
+        : m_prob(std::forward<T>(x)), m_e(seed), m_seed(seed)
+    {
+        vector_double dvs;
+        std::vector<unsigned long long> ids;
+        dvs.reserve(pop_size * m_prob.get_nx());
+        ids.reserve(pop_size);
+        // NOTE: draw the decision vectors and the IDs in the same order as push_back()
+        // in the other constructor.
+        for (size_type i = 0u; i < pop_size; ++i) {
+            const auto x_rnd = random_decision_vector();
+            dvs.insert(dvs.end(), x_rnd.begin(), x_rnd.end());
+            ids.push_back(std::uniform_int_distribution<unsigned long long>()(m_e));
+        }
+        append_impl(dvs, bfe(m_prob, dvs), ids);
+    }
+
     /// Defaulted copy constructor.
     population(const population &) = default;
 
@@ -181,6 +413,7 @@ public:
             m_ID = std::move(pop.m_ID);
             m_x = std::move(pop.m_x);
             m_f = std::move(pop.m_f);
+            m_vv.invalidate();
             m_champion_x = std::move(pop.m_champion_x);
             m_champion_f = std::move(pop.m_champion_f);
             m_e = std::move(pop.m_e);
@@ -195,8 +428,8 @@ public:
      */
     ~population()
     {
-        assert(m_ID.size() == m_x.size());
-        assert(m_ID.size() == m_f.size());
+        assert(m_ID.size() * m_prob.get_nx() == m_x.size());
+        assert(m_ID.size() * m_prob.get_nf() == m_f.size());
     }
 
     /// Adds one decision vector (chromosome) to the population.
@@ -249,20 +482,105 @@ public:
 
         // Prepare quantities to be appended to the internal vectors.
         const auto new_id = std::uniform_int_distribution<unsigned long long>()(m_e);
-        auto x_copy(x);
-        auto f_copy(f);
         // Reserve space in the vectors.
         // NOTE: in face of overflow here, reserve(0) will be called, which is fine.
         // The first push_back below will then fail, with no modifications to the class taking place.
         m_ID.reserve(m_ID.size() + 1u);
-        m_x.reserve(m_x.size() + 1u);
-        m_f.reserve(m_f.size() + 1u);
+        m_x.reserve(m_x.size() + x.size());
+        m_f.reserve(m_f.size() + f.size());
+        vector_double x_copy, f_copy;
+        if (m_vv.valid()) {
+            m_vv.m_x.reserve(m_vv.m_x.size() + 1u);
+            m_vv.m_f.reserve(m_vv.m_f.size() + 1u);
+            x_copy = x;
+            f_copy = f;
+        }
 
         // update champion either throws before modfying anything, or completes successfully. The rest is noexcept.
         update_champion(x, f);
         m_ID.push_back(new_id);
-        m_x.push_back(std::move(x_copy));
-        m_f.push_back(std::move(f_copy));
+        m_x.insert(m_x.end(), x.begin(), x.end());
+        m_f.insert(m_f.end(), f.begin(), f.end());
+        if (m_vv.valid()) {
+            m_vv.m_x.push_back(std::move(x_copy));
+            m_vv.m_f.push_back(std::move(f_copy));
+        }
+    }
+
+    /// Adds a batch of decision vectors to the population.
+    /**
+     * Appends the decision vectors stored contiguously in \p dvs to the population, computing their fitnesses
+     * in a single call to problem::batch_fitness(). The result is the same as calling push_back() on each decision
+     * vector in \p dvs (in order), but the champion is updated only once per batch.
+     *
+     * In case of exceptions, the population will not be altered.
+     *
+     * @param dvs the decision vectors to be added to the population.
+     *
+     * @throws unspecified any exception thrown by problem::batch_fitness() or by the other overloads of this method.
+     */
+    void append(const vector_double &dvs)
+    {
+        append(dvs, m_prob.batch_fitness(dvs));
+    }
+
+    /// Adds a batch of decision vectors to the population, with parallel fitness evaluation.
+    /**
+     * This method is equivalent to the overload taking only \p dvs, but the fitnesses are computed
+     * via the batch fitness evaluator \p bfe.
+     *
+     * In case of exceptions, the population will not be altered (apart from the fitness evaluation
+     * counter of the problem, see pagmo::thread_bfe).
+     *
+     * @param dvs the decision vectors to be added to the population.
+     * @param bfe the batch fitness evaluator that will be used to compute the fitnesses of \p dvs.
+     *
+     * @throws unspecified any exception thrown by the call operator of pagmo::thread_bfe or by the other
+     * overloads of this method.
+     */
+    void append(const vector_double &dvs, const thread_bfe &bfe)
+    {
+        append(dvs, bfe(m_prob, dvs));
+    }
+
+    /// Adds a batch of decision vectors/fitness vectors to the population.
+    /**
+     * Appends the decision vectors stored contiguously in \p dvs to the population, setting their fitnesses
+     * to the fitness vectors stored contiguously in \p fvs. The result is the same as calling push_back() on
+     * each pair of decision vector and fitness vector (in order), but the champion is updated only once per batch.
+     *
+     * In case of exceptions, the population will not be altered.
+     *
+     * @param dvs the decision vectors to be added to the population.
+     * @param fvs the fitness vectors corresponding to \p dvs.
+     *
+     * @throws std::invalid_argument if the size of \p dvs is not a multiple of the problem's dimension, or if
+     * the size of \p fvs is not consistent with the number of decision vectors in \p dvs and with the fitness
+     * dimension.
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    void append(const vector_double &dvs, const vector_double &fvs)
+    {
+        const auto nx = m_prob.get_nx(), nf = m_prob.get_nf();
+        if (dvs.size() % nx) {
+            pagmo_throw(std::invalid_argument, "Trying to add a batch of decision vectors of size: "
+                                                   + std::to_string(dvs.size())
+                                                   + ", which is not a multiple of the problem's dimension: "
+                                                   + std::to_string(nx));
+        }
+        const auto n = dvs.size() / nx;
+        if (fvs.size() / nf != n || fvs.size() % nf) {
+            pagmo_throw(std::invalid_argument, "Trying to add a batch of fitness vectors of size: "
+                                                   + std::to_string(fvs.size()) + ", while a size of "
+                                                   + std::to_string(n) + " * " + std::to_string(nf)
+                                                   + " was expected");
+        }
+        std::vector<unsigned long long> ids;
+        ids.reserve(n);
+        for (size_type i = 0u; i < n; ++i) {
+            ids.push_back(std::uniform_int_distribution<unsigned long long>()(m_e));
+        }
+        append_impl(dvs, fvs, ids);
     }
 
     /// Creates a random decision vector
@@ -323,13 +641,10 @@ public:
                         "The best individual can only be extracted in single objective problems");
         }
         if (m_prob.get_nc() > 0u) { // TODO: should we also code a min_element_population_con?
-            return sort_population_con(m_f, m_prob.get_nec(), tol)[0];
+            return sort_population_con(get_f(), m_prob.get_nec(), tol)[0];
         }
-        // Sort for single objective, unconstrained optimization
-        std::vector<size_type> indexes(size());
-        std::iota(indexes.begin(), indexes.end(), size_type(0u));
-        return *std::min_element(indexes.begin(), indexes.end(),
-                                 [this](size_type idx1, size_type idx2) { return m_f[idx1] < m_f[idx2]; });
+        // Sort for single objective, unconstrained optimization (the fitness matrix is a single column)
+        return static_cast<size_type>(std::min_element(m_f.begin(), m_f.end()) - m_f.begin());
     }
 
     /// Index of the best individual (accounting for a scalar tolerance)
@@ -396,13 +711,10 @@ public:
                         "The worst element of a population can only be extracted in single objective problems");
         }
         if (m_prob.get_nc() > 0u) { // TODO: should we also code a min_element_population_con?
-            return sort_population_con(m_f, m_prob.get_nec(), tol).back();
+            return sort_population_con(get_f(), m_prob.get_nec(), tol).back();
         }
-        // Sort for single objective, unconstrained optimization
-        std::vector<size_type> indexes(size());
-        std::iota(indexes.begin(), indexes.end(), size_type(0u));
-        return *std::max_element(indexes.begin(), indexes.end(),
-                                 [this](size_type idx1, size_type idx2) { return m_f[idx1] < m_f[idx2]; });
+        // Sort for single objective, unconstrained optimization (the fitness matrix is a single column)
+        return static_cast<size_type>(std::max_element(m_f.begin(), m_f.end()) - m_f.begin());
     }
 
     /// Index of the worst individual (accounting for a scalar tolerance)
@@ -479,8 +791,8 @@ public:
      */
     size_type size() const
     {
-        assert(m_f.size() == m_ID.size());
-        assert(m_x.size() == m_ID.size());
+        assert(m_f.size() == m_ID.size() * m_prob.get_nf());
+        assert(m_x.size() == m_ID.size() * m_prob.get_nx());
         return m_ID.size();
     }
 
@@ -523,18 +835,14 @@ public:
                             + ", while the problem's dimension is: " + std::to_string(m_prob.get_nx()));
         }
 
-        // Reserve space for the incoming vectors. If any of this throws,
-        // the data in m_x[i]/m_f[i] will not be modified.
-        m_x[i].reserve(x.size());
-        m_f[i].reserve(f.size());
-
         update_champion(x, f);
-        // Use resize + std::copy: since we reserved enough space above, none of this
-        // can throw.
-        m_x[i].resize(x.size());
-        m_f[i].resize(f.size());
-        std::copy(x.begin(), x.end(), m_x[i].begin());
-        std::copy(f.begin(), f.end(), m_f[i].begin());
+        // The sizes have been checked above: none of this can throw.
+        std::copy(x.begin(), x.end(), m_x.begin() + static_cast<std::ptrdiff_t>(i * x.size()));
+        std::copy(f.begin(), f.end(), m_f.begin() + static_cast<std::ptrdiff_t>(i * f.size()));
+        if (m_vv.valid()) {
+            std::copy(x.begin(), x.end(), m_vv.m_x[i].begin());
+            std::copy(f.begin(), f.end(), m_vv.m_f[i].begin());
+        }
     }
 
     /// Sets the \f$i\f$-th individual's chromosome
@@ -589,22 +897,135 @@ public:
 
     /// Const getter for the fitness vectors.
     /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The vector of fitness vectors is built from the contiguous storage of the population on first access, and
+     *    then kept up to date until the population is assigned to (after which it is rebuilt on the next access).
+     *    Performance-sensitive code should prefer :cpp:func:`pagmo::population::get_f_data()` and the row
+     *    and column views.
+     *
+     * \endverbatim
+     *
      * @return a const reference to the vector of fitness vectors.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
      */
     const std::vector<vector_double> &get_f() const
     {
-        return m_f;
+        build_vv();
+        return m_vv.m_f;
     }
 
     /// Const getter for the decision vectors.
     /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The vector of decision vectors is built from the contiguous storage of the population on first access, and
+     *    then kept up to date until the population is assigned to (after which it is rebuilt on the next access).
+     *    Performance-sensitive code should prefer :cpp:func:`pagmo::population::get_x_data()` and the row
+     *    and column views.
+     *
+     * \endverbatim
+     *
      * @return a const reference to the vector of decision vectors.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
      */
     const std::vector<vector_double> &get_x() const
+    {
+        build_vv();
+        return m_vv.m_x;
+    }
+
+    /// Contiguous fitness vectors.
+    /**
+     * @return a const reference to the fitness vectors of the individuals, stored contiguously
+     * in a row-major matrix with population::size() rows and problem::get_nf() columns.
+     */
+    const vector_double &get_f_data() const
+    {
+        return m_f;
+    }
+
+    /// Contiguous decision vectors.
+    /**
+     * @return a const reference to the decision vectors of the individuals, stored contiguously
+     * in a row-major matrix with population::size() rows and problem::get_nx() columns.
+     */
+    const vector_double &get_x_data() const
     {
         return m_x;
     }
 
+    /// View of a decision vector.
+    /**
+     * @param i the index of the individual.
+     *
+     * @return a view of the decision vector of the \f$i\f$-th individual.
+     *
+     * @throws std::invalid_argument if \p i is not smaller than the population size.
+     */
+    row_view get_x_row(size_type i) const
+    {
+        check_row(i);
+        const auto nx = m_prob.get_nx();
+        return row_view(m_x.data() + i * nx, nx);
+    }
+
+    /// View of a fitness vector.
+    /**
+     * @param i the index of the individual.
+     *
+     * @return a view of the fitness vector of the \f$i\f$-th individual.
+     *
+     * @throws std::invalid_argument if \p i is not smaller than the population size.
+     */
+    row_view get_f_row(size_type i) const
+    {
+        check_row(i);
+        const auto nf = m_prob.get_nf();
+        return row_view(m_f.data() + i * nf, nf);
+    }
+
+    /// View of a decision vector component.
+    /**
+     * @param j the index of the component.
+     *
+     * @return a view of the \f$j\f$-th component of the decision vectors of all the individuals.
+     *
+     * @throws std::invalid_argument if \p j is not smaller than the problem dimension.
+     */
+    column_view get_x_column(size_type j) const
+    {
+        const auto nx = m_prob.get_nx();
+        if (j >= nx) {
+            pagmo_throw(std::invalid_argument, "Trying to access the decision vector component: " + std::to_string(j)
+                                                   + ", while the problem's dimension is: " + std::to_string(nx));
+        }
+        return column_view(m_x.data() + j, size(), nx);
+    }
+
+    /// View of a fitness vector component.
+    /**
+     * @param j the index of the component.
+     *
+     * @return a view of the \f$j\f$-th component of the fitness vectors of all the individuals.
+     *
+     * @throws std::invalid_argument if \p j is not smaller than the fitness dimension.
+     */
+    column_view get_f_column(size_type j) const
+    {
+        const auto nf = m_prob.get_nf();
+        if (j >= nf) {
+            pagmo_throw(std::invalid_argument, "Trying to access the fitness vector component: " + std::to_string(j)
+                                                   + ", while the problem's fitness has dimension: "
+                                                   + std::to_string(nf));
+        }
+        return column_view(m_f.data() + j, size(), nf);
+    }
+
     /// Const getter for the individual IDs.
     /**
      * @return a const reference to the vector of individual IDs.
@@ -638,8 +1059,8 @@ public:
         for (size_type i = 0u; i < p.size(); ++i) {
             stream(os, "#", i, ":\n");
             stream(os, "\tID:\t\t\t", p.m_ID[i], '\n');
-            stream(os, "\tDecision vector:\t", p.m_x[i], '\n');
-            stream(os, "\tFitness vector:\t\t", p.m_f[i], '\n');
+            stream(os, "\tDecision vector:\t", p.get_x_row(i).to_vector(), '\n');
+            stream(os, "\tFitness vector:\t\t", p.get_f_row(i).to_vector(), '\n');
         }
         if (p.get_problem().get_nobj() == 1u && !p.get_problem().is_stochastic()) {
             stream(os, "\nChampion decision vector: ", p.champion_x(), '\n');
@@ -667,6 +1088,7 @@ public:
      *
      * @param ar source archive.
      *
+     * @throws std::invalid_argument if the sizes of the loaded decision and fitness vectors are inconsistent.
      * @throws unspecified any exception thrown by the deserialization of the internal pagmo::problem and of
      * primitive
      * types.
@@ -676,10 +1098,94 @@ public:
     {
         population tmp;
         ar(tmp.m_prob, tmp.m_ID, tmp.m_x, tmp.m_f, tmp.m_champion_x, tmp.m_champion_f, tmp.m_e, tmp.m_seed);
+        if (tmp.m_x.size() != tmp.m_ID.size() * tmp.m_prob.get_nx()
+            || tmp.m_f.size() != tmp.m_ID.size() * tmp.m_prob.get_nf()) {
+            pagmo_throw(std::invalid_argument, "Inconsistent sizes of the decision and fitness vectors in the "
+                                               "serialized representation of a population");
+        }
         *this = std::move(tmp);
     }
 
 private:
+    // Append the individuals with decision vectors dvs, fitness vectors fvs and IDs ids (whose sizes
+    // must be consistent). Provides the strong exception guarantee.
+    void append_impl(const vector_double &dvs, const vector_double &fvs, const std::vector<unsigned long long> &ids)
+    {
+        const auto nx = m_prob.get_nx(), nf = m_prob.get_nf(), n = ids.size();
+        assert(dvs.size() == n * nx && fvs.size() == n * nf);
+        if (!n) {
+            return;
+        }
+        // Reserve space in all the vectors, and prepare the new rows of the vector of vectors representation.
+        m_ID.reserve(m_ID.size() + n);
+        m_x.reserve(m_x.size() + dvs.size());
+        m_f.reserve(m_f.size() + fvs.size());
+        std::vector<vector_double> x_rows, f_rows;
+        if (m_vv.valid()) {
+            m_vv.m_x.reserve(m_vv.m_x.size() + n);
+            m_vv.m_f.reserve(m_vv.m_f.size() + n);
+            for (size_type i = 0u; i < n; ++i) {
+                x_rows.emplace_back(dvs.data() + i * nx, dvs.data() + (i + 1u) * nx);
+                f_rows.emplace_back(fvs.data() + i * nf, fvs.data() + (i + 1u) * nf);
+            }
+        }
+        // Update the champion with the best individual of the batch (in case of ties, the first one,
+        // as in a sequence of push_back()).
+        if (m_prob.get_nobj() == 1u) {
+            size_type best = 0u;
+            for (size_type i = 1u; i < n; ++i) {
+                const auto fi = fvs.data() + i * nf, fb = fvs.data() + best * nf;
+                if (m_prob.get_nc() == 0u ? *fi < *fb
+                                          : compare_fc(vector_double(fi, fi + nf), vector_double(fb, fb + nf),
+                                                       m_prob.get_nec(), m_prob.get_c_tol())) {
+                    best = i;
+                }
+            }
+            // update champion either throws before modfying anything, or completes successfully.
+            update_champion(vector_double(dvs.data() + best * nx, dvs.data() + (best + 1u) * nx),
+                            vector_double(fvs.data() + best * nf, fvs.data() + (best + 1u) * nf));
+        }
+        // The rest is noexcept.
+        m_ID.insert(m_ID.end(), ids.begin(), ids.end());
+        m_x.insert(m_x.end(), dvs.begin(), dvs.end());
+        m_f.insert(m_f.end(), fvs.begin(), fvs.end());
+        if (m_vv.valid()) {
+            std::move(x_rows.begin(), x_rows.end(), std::back_inserter(m_vv.m_x));
+            std::move(f_rows.begin(), f_rows.end(), std::back_inserter(m_vv.m_f));
+        }
+    }
+    // Check the index of an individual.
+    void check_row(size_type i) const
+    {
+        if (i >= size()) {
+            pagmo_throw(std::invalid_argument, "Trying to access individual at position: " + std::to_string(i)
+                                                   + ", while population has size: " + std::to_string(size()));
+        }
+    }
+    // Build the vector of vectors representation of the decision and fitness vectors, if needed.
+    void build_vv() const
+    {
+        if (m_vv.valid()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_vv.m_mutex);
+        if (m_vv.valid()) {
+            return;
+        }
+        const auto nx = m_prob.get_nx(), nf = m_prob.get_nf();
+        std::vector<vector_double> x, f;
+        x.reserve(size());
+        f.reserve(size());
+        for (size_type i = 0u; i < size(); ++i) {
+            x.emplace_back(m_x.data() + i * nx, m_x.data() + (i + 1u) * nx);
+            f.emplace_back(m_f.data() + i * nf, m_f.data() + (i + 1u) * nf);
+        }
+        // NOTE: swap into the existing vectors, so that references previously returned
+        // by get_x()/get_f() stay valid.
+        m_vv.m_x.swap(x);
+        m_vv.m_f.swap(f);
+        m_vv.m_valid.store(true, std::memory_order_release);
+    }
     // Short routine to update the champion. Does nothing if the problem is MO
     void update_champion(vector_double x, vector_double f)
     {
@@ -707,10 +1213,12 @@ private:
     problem m_prob;
     // ID of the various decision vectors
     std::vector<unsigned long long> m_ID;
-    // Decision vectors.
-    std::vector<vector_double> m_x;
-    // Fitness vectors.
-    std::vector<vector_double> m_f;
+    // Decision vectors (row-major, one row per individual).
+    vector_double m_x;
+    // Fitness vectors (row-major, one row per individual).
+    vector_double m_f;
+    // Vector of vectors representation of m_x and m_f.
+    mutable detail::pop_vv_cache m_vv;
     // The Champion chromosome
     vector_double m_champion_x;
     // The Champion fitness
@@ -721,6 +1229,77 @@ private:
     unsigned m_seed;
 };
 
+namespace detail
+{
+
+// Low-level access to the individuals of a population, used to transfer them between
+// processes via raw memory rather than via serialization (see fork_island). The flat
+// representation of the individuals is made of the IDs, followed by the decision
+// vectors and by the fitness vectors (both row-major).
+struct population_access {
+    // Serialize/deserialize everything but the individuals. load_no_inds() leaves pop
+    // with no individuals.
+    template <typename Archive>
+    static void save_no_inds(Archive &ar, const population &pop)
+    {
+        ar(pop.m_prob, pop.m_champion_x, pop.m_champion_f, pop.m_e, pop.m_seed);
+    }
+    template <typename Archive>
+    static void load_no_inds(Archive &ar, population &pop)
+    {
+        population tmp;
+        ar(tmp.m_prob, tmp.m_champion_x, tmp.m_champion_f, tmp.m_e, tmp.m_seed);
+        pop = std::move(tmp);
+    }
+    // Size in bytes of the flat representation of n individuals of pop. Returns false
+    // in case of overflow.
+    static bool inds_bytes(const population &pop, unsigned long long n, std::size_t &out)
+    {
+        static_assert(sizeof(unsigned long long) == sizeof(double), "Unsupported type sizes.");
+        const auto nx = pop.m_prob.get_nx(), nf = pop.m_prob.get_nf();
+        const auto max = std::numeric_limits<std::size_t>::max() / sizeof(double);
+        if (nx > max - 1u || nf > max - 1u - nx || n > max || (n && 1u + nx + nf > max / n)) {
+            return false;
+        }
+        out = static_cast<std::size_t>(n) * (1u + nx + nf) * sizeof(double);
+        return true;
+    }
+    // Copy the flat representation of the individuals of pop into buf.
+    static void copy_inds(const population &pop, char *buf)
+    {
+        const auto n = pop.m_ID.size();
+        if (!n) {
+            return;
+        }
+        std::memcpy(buf, pop.m_ID.data(), n * sizeof(unsigned long long));
+        buf += n * sizeof(unsigned long long);
+        std::memcpy(buf, pop.m_x.data(), pop.m_x.size() * sizeof(double));
+        buf += pop.m_x.size() * sizeof(double);
+        std::memcpy(buf, pop.m_f.data(), pop.m_f.size() * sizeof(double));
+    }
+    // Replace the individuals of pop with the n individuals whose flat
+    // representation is stored in buf.
+    static void set_inds(population &pop, const char *buf, unsigned long long n)
+    {
+        const auto nx = pop.m_prob.get_nx(), nf = pop.m_prob.get_nf();
+        std::vector<unsigned long long> ids(static_cast<std::size_t>(n));
+        vector_double x(static_cast<std::size_t>(n) * nx), f(static_cast<std::size_t>(n) * nf);
+        if (n) {
+            std::memcpy(ids.data(), buf, ids.size() * sizeof(unsigned long long));
+            buf += ids.size() * sizeof(unsigned long long);
+            std::memcpy(x.data(), buf, x.size() * sizeof(double));
+            buf += x.size() * sizeof(double);
+            std::memcpy(f.data(), buf, f.size() * sizeof(double));
+        }
+        pop.m_ID.swap(ids);
+        pop.m_x.swap(x);
+        pop.m_f.swap(f);
+        pop.m_vv.invalidate();
+    }
+};
+
+} // namespace detail
+
 } // namespace pagmo
 
 #if defined(__GNUC__) && defined(__MINGW32__)
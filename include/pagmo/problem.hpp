@@ -30,8 +30,10 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_PROBLEM_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <boost/numeric/conversion/cast.hpp>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -46,6 +48,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/detail/make_unique.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
+#include <pagmo/latency_histogram.hpp>
 #include <pagmo/serialization.hpp>
 #include <pagmo/threading.hpp>
 #include <pagmo/type_traits.hpp>
@@ -203,6 +206,82 @@ public:
 template <typename T>
 const bool has_fitness<T>::value;
 
+/// Detect raw \p fitness() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * void fitness(const double *, double *) const;
+ * @endcode
+ * This overload of the \p fitness() method is an optional part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class has_raw_fitness
+{
+    template <typename U>
+    using raw_fitness_t
+        = decltype(std::declval<const U &>().fitness(std::declval<const double *>(), std::declval<double *>()));
+    static const bool implementation_defined = std::is_same<detected_t<raw_fitness_t, T>, void>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_raw_fitness<T>::value;
+
+/// Detect \p batch_fitness() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * vector_double batch_fitness(const vector_double &) const;
+ * @endcode
+ * The \p batch_fitness() method is part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class has_batch_fitness
+{
+    template <typename U>
+    using batch_fitness_t = decltype(std::declval<const U &>().batch_fitness(std::declval<const vector_double &>()));
+    static const bool implementation_defined = std::is_same<detected_t<batch_fitness_t, T>, vector_double>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_batch_fitness<T>::value;
+
+/// Detect \p has_batch_fitness() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * bool has_batch_fitness() const;
+ * @endcode
+ * The \p has_batch_fitness() method is part of the interface for the definition of a problem
+ * (see pagmo::problem).
+ */
+template <typename T>
+class override_has_batch_fitness
+{
+    template <typename U>
+    using has_batch_fitness_t = decltype(std::declval<const U &>().has_batch_fitness());
+    static const bool implementation_defined = std::is_same<bool, detected_t<has_batch_fitness_t, T>>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool override_has_batch_fitness<T>::value;
+
 /// Detect \p get_nobj() method.
 /**
  * This type trait will be \p true if \p T provides a method with
@@ -571,6 +650,33 @@ const bool is_udp<T>::value;
 namespace detail
 {
 
+// Helper to check a batch of decision vectors for a problem with nx decision variables and
+// nf fitness components. This will throw if the size of the batch is not a multiple of nx, or if the
+// size of the corresponding batch of fitness vectors would overflow. Otherwise, the number of
+// decision vectors in the batch is returned.
+inline vector_double::size_type check_batch_dvs(const vector_double &dvs, vector_double::size_type nx,
+                                                vector_double::size_type nf)
+{
+    // 1 - the batch must contain an integral number of decision vectors
+    if (dvs.size() % nx) {
+        pagmo_throw(std::invalid_argument, "Length of the batch of decision vectors is " + std::to_string(dvs.size())
+                                               + ", which is not a multiple of " + std::to_string(nx));
+    }
+    const auto n_dvs = dvs.size() / nx;
+    // 2 - the size of the fitnesses must be representable
+    if (n_dvs > std::numeric_limits<vector_double::size_type>::max() / nf) {
+        pagmo_throw(std::invalid_argument, "The size of the batch of fitness vectors is too large");
+    }
+    return n_dvs;
+}
+
+// Generate a new, globally unique, identifier for the state of a UDP (see problem::m_udp_id).
+inline unsigned long long new_udp_id()
+{
+    static std::atomic<unsigned long long> counter(0u);
+    return ++counter;
+}
+
 // Helper to check that the problem bounds are valid. This will throw if the bounds
 // are invalid because of:
 // - the bounds size is zero,
@@ -662,6 +768,10 @@ struct prob_inner_base {
     virtual ~prob_inner_base() {}
     virtual std::unique_ptr<prob_inner_base> clone() const = 0;
     virtual vector_double fitness(const vector_double &) const = 0;
+    virtual void raw_fitness(const double *, double *) const = 0;
+    virtual bool has_raw_fitness() const = 0;
+    virtual vector_double batch_fitness(const vector_double &) const = 0;
+    virtual bool has_batch_fitness() const = 0;
     virtual vector_double gradient(const vector_double &) const = 0;
     virtual bool has_gradient() const = 0;
     virtual sparsity_pattern gradient_sparsity() const = 0;
@@ -712,6 +822,22 @@ struct prob_inner final : prob_inner_base {
         return m_value.get_bounds();
     }
     // optional methods
+    virtual void raw_fitness(const double *dv, double *f) const override final
+    {
+        raw_fitness_impl(m_value, dv, f);
+    }
+    virtual bool has_raw_fitness() const override final
+    {
+        return pagmo::has_raw_fitness<T>::value;
+    }
+    virtual vector_double batch_fitness(const vector_double &dvs) const override final
+    {
+        return batch_fitness_impl(m_value, dvs);
+    }
+    virtual bool has_batch_fitness() const override final
+    {
+        return has_batch_fitness_impl(m_value);
+    }
     virtual vector_double::size_type get_nobj() const override final
     {
         return get_nobj_impl(m_value);
@@ -791,6 +917,51 @@ struct prob_inner final : prob_inner_base {
     {
         return 1u;
     }
+    template <typename U, enable_if_t<pagmo::has_raw_fitness<U>::value, int> = 0>
+    static void raw_fitness_impl(const U &value, const double *dv, double *f)
+    {
+        value.fitness(dv, f);
+    }
+    template <typename U, enable_if_t<!pagmo::has_raw_fitness<U>::value, int> = 0>
+    [[noreturn]] static void raw_fitness_impl(const U &, const double *, double *) // LCOV_EXCL_LINE
+    {
+        // NOTE: we should never end up here. raw_fitness() is called only if m_has_raw_fitness
+        // in the problem is set to true, and m_has_raw_fitness is unconditionally false if the UDP
+        // does not implement the raw fitness() overload.
+        assert(false); // LCOV_EXCL_LINE
+        throw;
+    }
+    template <typename U, enable_if_t<pagmo::has_batch_fitness<U>::value, int> = 0>
+    static vector_double batch_fitness_impl(const U &value, const vector_double &dvs)
+    {
+        return value.batch_fitness(dvs);
+    }
+    template <typename U, enable_if_t<!pagmo::has_batch_fitness<U>::value, int> = 0>
+    [[noreturn]] static vector_double batch_fitness_impl(const U &, const vector_double &) // LCOV_EXCL_LINE
+    {
+        // NOTE: we should never end up here. batch_fitness() is called only if m_has_batch_fitness
+        // in the problem is set to true, and m_has_batch_fitness is unconditionally false if the UDP
+        // does not implement batch_fitness() (see implementation of the three overloads below).
+        assert(false); // LCOV_EXCL_LINE
+        throw;
+    }
+    template <typename U,
+              enable_if_t<pagmo::has_batch_fitness<U>::value && pagmo::override_has_batch_fitness<U>::value, int> = 0>
+    static bool has_batch_fitness_impl(const U &p)
+    {
+        return p.has_batch_fitness();
+    }
+    template <typename U,
+              enable_if_t<pagmo::has_batch_fitness<U>::value && !pagmo::override_has_batch_fitness<U>::value, int> = 0>
+    static bool has_batch_fitness_impl(const U &)
+    {
+        return true;
+    }
+    template <typename U, enable_if_t<!pagmo::has_batch_fitness<U>::value, int> = 0>
+    static bool has_batch_fitness_impl(const U &)
+    {
+        return false;
+    }
     template <typename U, enable_if_t<pagmo::has_gradient<U>::value, int> = 0>
     static vector_double gradient_impl(const U &value, const vector_double &dv)
     {
@@ -1006,6 +1177,27 @@ struct prob_inner final : prob_inner_base {
 
 } // namespace detail
 
+class problem;
+
+namespace detail
+{
+
+// The latency histograms of a problem (see problem::set_latency_tracking()).
+struct problem_latencies {
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_fitness, m_gradient, m_hessians);
+    }
+    latency_histogram m_fitness;
+    latency_histogram m_gradient;
+    latency_histogram m_hessians;
+};
+
+inline unsigned long long udp_id(const problem &);
+inline void batch_fitness_range(const problem &, const double *, vector_double::size_type, double *);
+} // namespace detail
+
 /// Problem class.
 /**
  * \image html prob_no_text.png
@@ -1057,10 +1249,13 @@ struct prob_inner final : prob_inner_base {
  * unconstrained optimization problem. In order to consider more complex cases, the UDP may implement one or more of the
  * following methods:
  * @code{.unparsed}
+ * void fitness(const double *, double *) const;
  * vector_double::size_type get_nobj() const;
  * vector_double::size_type get_nec() const;
  * vector_double::size_type get_nic() const;
  * vector_double::size_type get_nix() const;
+ * bool has_batch_fitness() const;
+ * vector_double batch_fitness(const vector_double &) const;
  * bool has_gradient() const;
  * vector_double gradient(const vector_double &) const;
  * bool has_gradient_sparsity() const;
@@ -1089,6 +1284,8 @@ struct prob_inner final : prob_inner_base {
  */
 class problem
 {
+    friend unsigned long long detail::udp_id(const problem &);
+    friend void detail::batch_fitness_range(const problem &, const double *, vector_double::size_type, double *);
     // Enable the generic ctor only if T is not a problem (after removing
     // const/reference qualifiers), and if T is a udp.
     template <typename T>
@@ -1137,7 +1334,7 @@ public:
     template <typename T, generic_ctor_enabler<T> = 0>
     explicit problem(T &&x)
         : m_ptr(detail::make_unique<detail::prob_inner<uncvref_t<T>>>(std::forward<T>(x))), m_fevals(0u), m_gevals(0u),
-          m_hevals(0u)
+          m_hevals(0u), m_udp_id(detail::new_udp_id()), m_cow(false)
     {
         // 0 - Integer part
         const auto tmp_size = ptr()->get_bounds().first.size();
@@ -1170,8 +1367,10 @@ public:
         if (m_nic > std::numeric_limits<decltype(m_nic)>::max() / 3u) {
             pagmo_throw(std::invalid_argument, "The number of inequality constraints is too large");
         }
-        // 4 - Presence of gradient and its sparsity.
+        // 4 - Presence of raw fitness, batch fitness, gradient and gradient sparsity.
         // NOTE: all these m_has_* attributes refer to the presence of the features in the UDP.
+        m_has_raw_fitness = ptr()->has_raw_fitness();
+        m_has_batch_fitness = ptr()->has_batch_fitness();
         m_has_gradient = ptr()->has_gradient();
         m_has_gradient_sparsity = ptr()->has_gradient_sparsity();
         // 5 - Presence of Hessians and their sparsity.
@@ -1226,7 +1425,9 @@ public:
 
     /// Copy constructor.
     /**
-     * The copy constructor will deep copy the input problem \p other.
+     * The copy constructor will deep copy the input problem \p other. If copy-on-write is enabled in \p other
+     * (see problem::set_copy_on_write()), the UDP is not copied: \p this will share the UDP of \p other
+     * until either of them needs to modify it.
      *
      * @param other the problem to be copied.
      *
@@ -1235,9 +1436,15 @@ public:
      * - the copying of the internal UDP.
      */
     problem(const problem &other)
-        : m_ptr(other.ptr()->clone()), m_fevals(other.m_fevals), m_gevals(other.m_gevals), m_hevals(other.m_hevals),
-          m_lb(other.m_lb), m_ub(other.m_ub), m_nobj(other.m_nobj), m_nec(other.m_nec), m_nic(other.m_nic),
-          m_nix(other.m_nix), m_c_tol(other.m_c_tol), m_has_gradient(other.m_has_gradient),
+        : m_ptr(other.m_cow ? other.m_ptr : std::shared_ptr<detail::prob_inner_base>(other.ptr()->clone())),
+          m_fevals(other.m_fevals.load(std::memory_order_relaxed)),
+          m_gevals(other.m_gevals.load(std::memory_order_relaxed)),
+          m_hevals(other.m_hevals.load(std::memory_order_relaxed)),
+          m_latencies(other.m_latencies ? detail::make_unique<detail::problem_latencies>(*other.m_latencies) : nullptr),
+          m_udp_id(other.m_udp_id), m_cow(other.m_cow), m_lb(other.m_lb), m_ub(other.m_ub), m_nobj(other.m_nobj),
+          m_nec(other.m_nec),
+          m_nic(other.m_nic), m_nix(other.m_nix), m_c_tol(other.m_c_tol), m_has_raw_fitness(other.m_has_raw_fitness),
+          m_has_batch_fitness(other.m_has_batch_fitness), m_has_gradient(other.m_has_gradient),
           m_has_gradient_sparsity(other.m_has_gradient_sparsity), m_has_hessians(other.m_has_hessians),
           m_has_hessians_sparsity(other.m_has_hessians_sparsity), m_has_set_seed(other.m_has_set_seed),
           m_name(other.m_name), m_gs_dim(other.m_gs_dim), m_hs_dim(other.m_hs_dim),
@@ -1250,9 +1457,13 @@ public:
      * @param other the problem from which \p this will be move-constructed.
      */
     problem(problem &&other) noexcept
-        : m_ptr(std::move(other.m_ptr)), m_fevals(other.m_fevals), m_gevals(other.m_gevals), m_hevals(other.m_hevals),
-          m_lb(std::move(other.m_lb)), m_ub(std::move(other.m_ub)), m_nobj(other.m_nobj), m_nec(other.m_nec),
-          m_nic(other.m_nic), m_nix(other.m_nix), m_c_tol(std::move(other.m_c_tol)),
+        : m_ptr(std::move(other.m_ptr)), m_fevals(other.m_fevals.load(std::memory_order_relaxed)),
+          m_gevals(other.m_gevals.load(std::memory_order_relaxed)),
+          m_hevals(other.m_hevals.load(std::memory_order_relaxed)), m_latencies(std::move(other.m_latencies)),
+          m_udp_id(other.m_udp_id), m_cow(other.m_cow), m_lb(std::move(other.m_lb)), m_ub(std::move(other.m_ub)),
+          m_nobj(other.m_nobj),
+          m_nec(other.m_nec), m_nic(other.m_nic), m_nix(other.m_nix), m_c_tol(std::move(other.m_c_tol)),
+          m_has_raw_fitness(other.m_has_raw_fitness), m_has_batch_fitness(other.m_has_batch_fitness),
           m_has_gradient(other.m_has_gradient), m_has_gradient_sparsity(other.m_has_gradient_sparsity),
           m_has_hessians(other.m_has_hessians), m_has_hessians_sparsity(other.m_has_hessians_sparsity),
           m_has_set_seed(other.m_has_set_seed), m_name(std::move(other.m_name)), m_gs_dim(other.m_gs_dim),
@@ -1270,9 +1481,12 @@ public:
     {
         if (this != &other) {
             m_ptr = std::move(other.m_ptr);
-            m_fevals = other.m_fevals;
-            m_gevals = other.m_gevals;
-            m_hevals = other.m_hevals;
+            m_fevals.store(other.m_fevals.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_gevals.store(other.m_gevals.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_hevals.store(other.m_hevals.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_latencies = std::move(other.m_latencies);
+            m_udp_id = other.m_udp_id;
+            m_cow = other.m_cow;
             m_lb = std::move(other.m_lb);
             m_ub = std::move(other.m_ub);
             m_nobj = other.m_nobj;
@@ -1280,6 +1494,8 @@ public:
             m_nic = other.m_nic;
             m_nix = other.m_nix;
             m_c_tol = std::move(other.m_c_tol);
+            m_has_raw_fitness = other.m_has_raw_fitness;
+            m_has_batch_fitness = other.m_has_batch_fitness;
             m_has_gradient = other.m_has_gradient;
             m_has_gradient_sparsity = other.m_has_gradient_sparsity;
             m_has_hessians = other.m_has_hessians;
@@ -1360,6 +1576,8 @@ public:
     template <typename T>
     T *extract()
     {
+        // NOTE: the UDP could be modified via the returned pointer.
+        m_udp_id = detail::new_udp_id();
         auto p = dynamic_cast<detail::prob_inner<T> *>(ptr());
         return p == nullptr ? nullptr : &(p->m_value);
     }
@@ -1397,18 +1615,150 @@ public:
      * @throws unspecified any exception thrown by the <tt>%fitness()</tt> method of the UDP.
      */
     vector_double fitness(const vector_double &dv) const
+    {
+        vector_double retval;
+        fitness(dv, retval);
+        return retval;
+    }
+
+    /// Fitness (in-place version).
+    /**
+     * This method is equivalent to problem::fitness(const vector_double &) const, but the fitness of \p dv
+     * is written into the caller-owned vector \p f (which will be resized to get_nf()) rather than returned
+     * as a new vector.
+     *
+     * If the UDP satisfies pagmo::has_raw_fitness, the raw <tt>%fitness()</tt> overload of the UDP will be invoked
+     * with pointers to the data of \p dv and \p f, and no memory allocation will take place as long as the
+     * capacity of \p f is at least get_nf(). In this case, the raw <tt>%fitness()</tt> overload of the UDP
+     * must write exactly get_nf() values into its output buffer. Otherwise, the fitness will be computed
+     * via the <tt>%fitness()</tt> method of the UDP returning a vector, and then copied into \p f.
+     *
+     * A successful call of this method will increase the internal fitness evaluation counter (see
+     * problem::get_fevals()). If an exception is raised, the content of \p f is unspecified.
+     *
+     * @param dv the decision vector.
+     * @param f the output fitness vector.
+     *
+     * @throws std::invalid_argument if either
+     * - the length of \p dv differs from the value returned by get_nx(), or
+     * - the length of the fitness vector returned by the UDP differs from the the value returned by get_nf().
+     * @throws unspecified any exception thrown by the <tt>%fitness()</tt> method of the UDP, or by memory
+     * errors in standard containers.
+     */
+    void fitness(const vector_double &dv, vector_double &f) const
     {
         // 1 - checks the decision vector
         check_decision_vector(dv);
         // 2 - computes the fitness
-        vector_double retval(ptr()->fitness(dv));
-        // 3 - checks the fitness vector
-        check_fitness_vector(retval);
+        if (m_has_raw_fitness) {
+            // NOTE: the fitness vector is sized by us in this case, no need to check it.
+            f.resize(get_nf());
+            tracked_call(&detail::problem_latencies::m_fitness,
+                         [this, &dv, &f]() { ptr()->raw_fitness(dv.data(), f.data()); });
+        } else {
+            tracked_call(&detail::problem_latencies::m_fitness, [this, &dv, &f]() { f = ptr()->fitness(dv); });
+            // 3 - checks the fitness vector
+            check_fitness_vector(f);
+        }
         // 4 - increments fitness evaluation counter
-        ++m_fevals;
+        m_fevals.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    /// Batch fitness.
+    /**
+     * This method computes the fitnesses of a batch of decision vectors, stored contiguously in \p dvs.
+     * That is, \p dvs is expected to be the concatenation of \f$ n \f$ decision vectors of size
+     * \f$ n_x \f$, and the return value will be the concatenation of the corresponding \f$ n \f$ fitness vectors,
+     * each one of size \f$ n_f \f$ (in the same order).
+     *
+     * If problem::has_batch_fitness() returns \p true, \p dvs will be forwarded to the <tt>%batch_fitness()</tt>
+     * method of the UDP. Otherwise, the fitnesses will be computed by invoking the <tt>%fitness()</tt> method
+     * of the UDP in a loop (using the raw <tt>%fitness()</tt> overload of the UDP directly on the input and output
+     * buffers, if the UDP satisfies pagmo::has_raw_fitness). In all cases, sanity checks will be run on \p dvs
+     * and on the returned fitness vectors, and the internal fitness evaluation counter (see problem::get_fevals())
+     * will be increased by \f$ n \f$ once the whole batch has been evaluated successfully.
+     *
+     * @param dvs the input batch of decision vectors.
+     *
+     * @return the fitnesses of the decision vectors in \p dvs.
+     *
+     * @throws std::invalid_argument if either
+     * - the length of \p dvs is not a multiple of the value returned by get_nx(),
+     * - the total length of the fitness vectors would overflow, or
+     * - the length of the returned fitness vectors is not consistent with the number of decision vectors
+     *   and with the value returned by get_nf().
+     * @throws unspecified any exception thrown by the <tt>%batch_fitness()</tt> or <tt>%fitness()</tt> methods
+     * of the UDP, or by memory errors in standard containers.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        vector_double retval;
+        batch_fitness(dvs, retval);
         return retval;
     }
 
+    /// Batch fitness (in-place version).
+    /**
+     * This method is equivalent to problem::batch_fitness(const vector_double &) const, but the fitnesses
+     * are written into the caller-owned vector \p fvs (which will be resized to the number of decision vectors
+     * in \p dvs times get_nf()) rather than returned as a new vector.
+     *
+     * If the UDP is not capable of batch fitness evaluation, the fitnesses are computed directly into \p fvs,
+     * and no memory allocation will take place if the UDP satisfies pagmo::has_raw_fitness and the capacity
+     * of \p fvs is large enough. \p dvs and \p fvs must be distinct objects. If an exception is raised,
+     * the content of \p fvs is unspecified.
+     *
+     * @param dvs the input batch of decision vectors.
+     * @param fvs the output batch of fitness vectors.
+     *
+     * @throws unspecified any exception thrown by problem::batch_fitness(const vector_double &) const.
+     */
+    void batch_fitness(const vector_double &dvs, vector_double &fvs) const
+    {
+        // 1 - checks the input decision vectors
+        const auto n_dvs = check_batch_decision_vectors(dvs);
+        if (m_has_batch_fitness) {
+            // 2 - computes the fitnesses
+            // NOTE: the latency of the batch is split evenly among its decision vectors.
+            tracked_call(&detail::problem_latencies::m_fitness,
+                         [this, &dvs, &fvs]() { fvs = ptr()->batch_fitness(dvs); }, n_dvs);
+            // 3 - checks the output fitness vectors
+            check_batch_fitness_vectors(fvs, n_dvs);
+            // 4 - increments fitness evaluation counter, once for the whole batch
+            m_fevals.fetch_add(n_dvs, std::memory_order_relaxed);
+        } else {
+            fvs.resize(n_dvs * get_nf());
+            batch_fitness_impl(dvs.data(), n_dvs, fvs.data());
+        }
+    }
+
+    /// Check if the UDP is capable of batch fitness evaluation.
+    /**
+     * This method will return \p true if the UDP is capable of batch fitness evaluation, \p false otherwise.
+     *
+     * The batch fitness evaluation capability of the UDP is determined as follows:
+     * - if the UDP does not satisfy pagmo::has_batch_fitness, then this method will always return \p false;
+     * - if the UDP satisfies pagmo::has_batch_fitness but it does not satisfy pagmo::override_has_batch_fitness,
+     *   then this method will always return \p true;
+     * - if the UDP satisfies both pagmo::has_batch_fitness and pagmo::override_has_batch_fitness,
+     *   then this method will return the output of the <tt>%has_batch_fitness()</tt> method of the UDP.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    Regardless of what this method returns, :cpp:func:`problem::batch_fitness()` can always be invoked:
+     *    if the UDP is not capable of batch fitness evaluation, the fitnesses will be computed one
+     *    decision vector at a time via the ``fitness()`` method of the UDP.
+     *
+     * \endverbatim
+     *
+     * @return a flag signalling the availability of batch fitness evaluation in the UDP.
+     */
+    bool has_batch_fitness() const
+    {
+        return m_has_batch_fitness;
+    }
+
     /// Gradient.
     /**
      * This method will compute the gradient of the input decision vector \p dv by invoking
@@ -1442,11 +1792,12 @@ public:
         // 1 - checks the decision vector
         check_decision_vector(dv);
         // 2 - compute the gradients
-        vector_double retval(ptr()->gradient(dv));
+        vector_double retval;
+        tracked_call(&detail::problem_latencies::m_gradient, [this, &dv, &retval]() { retval = ptr()->gradient(dv); });
         // 3 - checks the gradient vector
         check_gradient_vector(retval);
         // 4 - increments gradient evaluation counter
-        ++m_gevals;
+        m_gevals.fetch_add(1u, std::memory_order_relaxed);
         return retval;
     }
 
@@ -1570,11 +1921,12 @@ public:
         // 1 - checks the decision vector
         check_decision_vector(dv);
         // 2 - computes the hessians
-        auto retval(ptr()->hessians(dv));
+        std::vector<vector_double> retval;
+        tracked_call(&detail::problem_latencies::m_hessians, [this, &dv, &retval]() { retval = ptr()->hessians(dv); });
         // 3 - checks the hessians
         check_hessians_vector(retval);
         // 4 - increments hessians evaluation counter
-        ++m_hevals;
+        m_hevals.fetch_add(1u, std::memory_order_relaxed);
         return retval;
     }
 
@@ -1837,15 +2189,19 @@ public:
 
     /// Number of fitness evaluations.
     /**
-     * Each time a call to problem::fitness() successfully completes, an internal counter is increased by one.
+     * Each time a call to problem::fitness() successfully completes, an internal counter is increased by one
+     * (problem::batch_fitness() increases it by the number of decision vectors in the batch).
      * The counter is initialised to zero upon problem construction and it is never reset. Copy and move operations
      * copy the counter as well.
      *
+     * The evaluation counters are atomic: they are updated correctly, and they can be read at any time, also
+     * when multiple threads are performing evaluations concurrently via the same problem.
+     *
      * @return the number of times problem::fitness() was successfully called.
      */
     unsigned long long get_fevals() const
     {
-        return m_fevals;
+        return m_fevals.load(std::memory_order_relaxed);
     }
 
     /// Number of gradient evaluations.
@@ -1858,7 +2214,7 @@ public:
      */
     unsigned long long get_gevals() const
     {
-        return m_gevals;
+        return m_gevals.load(std::memory_order_relaxed);
     }
 
     /// Number of hessians evaluations.
@@ -1871,7 +2227,137 @@ public:
      */
     unsigned long long get_hevals() const
     {
-        return m_hevals;
+        return m_hevals.load(std::memory_order_relaxed);
+    }
+
+    /// Increment the number of fitness evaluations.
+    /**
+     * This method will increase the internal counter of fitness evaluations by \p n. It is meant to be used
+     * by components (such as pagmo::thread_bfe) that evaluate fitnesses on copies of \p this, so that
+     * the evaluations performed on the copies can be accounted for in the original problem.
+     *
+     * @param n the amount by which the fitness evaluation counter will be increased.
+     */
+    void increment_fevals(unsigned long long n)
+    {
+        m_fevals.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /// Enable or disable latency tracking.
+    /**
+     * If latency tracking is enabled, the latency of each call to the <tt>%fitness()</tt>, <tt>%batch_fitness()</tt>,
+     * <tt>%gradient()</tt> and <tt>%hessians()</tt> methods of the UDP will be recorded in a pagmo::latency_histogram
+     * (one histogram for the fitness, one for the gradient and one for the hessians, see
+     * problem::get_fitness_latency(), problem::get_gradient_latency() and problem::get_hessians_latency()).
+     * The latency of a call to the <tt>%batch_fitness()</tt> method of the UDP is split evenly among the decision
+     * vectors in the batch. Latency tracking is disabled by default.
+     *
+     * Enabling latency tracking when it is already enabled has no effect. Disabling latency tracking discards
+     * the recorded data.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The recorded data is copied and serialized together with the problem. The histograms can be read
+     *    (and they are updated) safely while the problem is being used for evaluations, but this method must
+     *    not be called concurrently with any other method of this class.
+     *
+     * \endverbatim
+     *
+     * @param flag \p true to enable latency tracking, \p false to disable it.
+     *
+     * @throws unspecified any exception thrown by memory errors.
+     */
+    void set_latency_tracking(bool flag)
+    {
+        if (!flag) {
+            m_latencies.reset();
+        } else if (!m_latencies) {
+            m_latencies = detail::make_unique<detail::problem_latencies>();
+        }
+    }
+
+    /// Check if latency tracking is enabled.
+    /**
+     * @return \p true if latency tracking is enabled, \p false otherwise.
+     */
+    bool get_latency_tracking() const
+    {
+        return static_cast<bool>(m_latencies);
+    }
+
+    /// Fitness latency histogram.
+    /**
+     * @return the histogram of the latencies of the fitness evaluations performed by the UDP while latency
+     * tracking was enabled (see problem::set_latency_tracking()). If latency tracking is disabled,
+     * an empty histogram is returned.
+     */
+    latency_histogram get_fitness_latency() const
+    {
+        return m_latencies ? m_latencies->m_fitness : latency_histogram{};
+    }
+
+    /// Gradient latency histogram.
+    /**
+     * @return the histogram of the latencies of the gradient evaluations performed by the UDP while latency
+     * tracking was enabled (see problem::set_latency_tracking()). If latency tracking is disabled,
+     * an empty histogram is returned.
+     */
+    latency_histogram get_gradient_latency() const
+    {
+        return m_latencies ? m_latencies->m_gradient : latency_histogram{};
+    }
+
+    /// Hessians latency histogram.
+    /**
+     * @return the histogram of the latencies of the hessians evaluations performed by the UDP while latency
+     * tracking was enabled (see problem::set_latency_tracking()). If latency tracking is disabled,
+     * an empty histogram is returned.
+     */
+    latency_histogram get_hessians_latency() const
+    {
+        return m_latencies ? m_latencies->m_hessians : latency_histogram{};
+    }
+
+    /// Enable or disable copy-on-write.
+    /**
+     * If copy-on-write is enabled, copies of \p this (and copies of the copies) do not clone the UDP, but
+     * they share it with \p this through a reference-counted pointer. The UDP is cloned only when one of the
+     * problems sharing it needs to modify it (i.e., in problem::set_seed() and in the non-const overload of
+     * problem::extract()). The evaluation counters, the latency histograms and all the other properties
+     * of the problem are never shared. Copy-on-write is disabled by default, and its status is inherited by copies.
+     *
+     * Disabling copy-on-write clones the UDP of \p this, if it is currently shared with other problems.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. warning::
+     *
+     *    Problems sharing the same UDP will invoke the const methods of the same UDP object, possibly concurrently
+     *    (e.g., from different islands or from a batch fitness evaluator). Copy-on-write should thus be enabled
+     *    only for UDPs whose const methods can safely be called concurrently on the same object.
+     *
+     * \endverbatim
+     *
+     * @param flag \p true to enable copy-on-write, \p false to disable it.
+     *
+     * @throws unspecified any exception thrown by the copy constructor of the UDP.
+     */
+    void set_copy_on_write(bool flag)
+    {
+        if (!flag) {
+            // Stop sharing the UDP (the non-const ptr() clones it if needed).
+            ptr();
+        }
+        m_cow = flag;
+    }
+
+    /// Get the copy-on-write status.
+    /**
+     * @return \p true if copy-on-write is enabled, \p false otherwise (see problem::set_copy_on_write()).
+     */
+    bool get_copy_on_write() const
+    {
+        return m_cow;
     }
 
     /// Set the seed for the stochastic variables.
@@ -1888,6 +2374,7 @@ public:
     void set_seed(unsigned seed)
     {
         ptr()->set_seed(seed);
+        m_udp_id = detail::new_udp_id();
     }
 
     /// Feasibility of a decision vector.
@@ -2039,7 +2526,8 @@ public:
         stream(os, p.get_bounds().first, '\n');
         os << "\tUpper bounds: ";
         stream(os, p.get_bounds().second, '\n');
-        stream(os, "\n\tHas gradient: ", p.has_gradient(), '\n');
+        stream(os, "\n\tHas batch fitness evaluation: ", p.has_batch_fitness(), '\n');
+        stream(os, "\tHas gradient: ", p.has_gradient(), '\n');
         stream(os, "\tUser implemented gradient sparsity: ", p.m_has_gradient_sparsity, '\n');
         if (p.has_gradient()) {
             stream(os, "\tExpected gradients: ", p.m_gs_dim, '\n');
@@ -2056,6 +2544,15 @@ public:
         if (p.has_hessians()) {
             stream(os, "\tHessians evaluations: ", p.get_hevals(), '\n');
         }
+        if (p.get_latency_tracking()) {
+            os << "\n\tFitness latency: " << p.get_fitness_latency() << '\n';
+            if (p.has_gradient()) {
+                os << "\tGradient latency: " << p.get_gradient_latency() << '\n';
+            }
+            if (p.has_hessians()) {
+                os << "\tHessians latency: " << p.get_hessians_latency() << '\n';
+            }
+        }
         stream(os, "\n\tThread safety: ", p.get_thread_safety(), '\n');
 
         const auto extra_str = p.get_extra_info();
@@ -2076,9 +2573,9 @@ public:
     template <typename Archive>
     void save(Archive &ar) const
     {
-        ar(m_ptr, m_fevals, m_gevals, m_hevals, m_lb, m_ub, m_nobj, m_nec, m_nic, m_nix, m_c_tol, m_has_gradient,
-           m_has_gradient_sparsity, m_has_hessians, m_has_hessians_sparsity, m_has_set_seed, m_name, m_gs_dim, m_hs_dim,
-           m_thread_safety);
+        ar(m_ptr, get_fevals(), get_gevals(), get_hevals(), m_latencies, m_lb, m_ub, m_nobj, m_nec, m_nic, m_nix,
+           m_c_tol, m_has_raw_fitness, m_has_batch_fitness, m_has_gradient, m_has_gradient_sparsity, m_has_hessians,
+           m_has_hessians_sparsity, m_has_set_seed, m_name, m_gs_dim, m_hs_dim, m_thread_safety, m_cow);
     }
 
     /// Load from archive.
@@ -2094,10 +2591,16 @@ public:
     {
         // Deserialize in a separate object and move it in later, for exception safety.
         problem tmp_prob;
-        ar(tmp_prob.m_ptr, tmp_prob.m_fevals, tmp_prob.m_gevals, tmp_prob.m_hevals, tmp_prob.m_lb, tmp_prob.m_ub,
-           tmp_prob.m_nobj, tmp_prob.m_nec, tmp_prob.m_nic, tmp_prob.m_nix, tmp_prob.m_c_tol, tmp_prob.m_has_gradient,
+        unsigned long long fevals, gevals, hevals;
+        ar(tmp_prob.m_ptr, fevals, gevals, hevals, tmp_prob.m_latencies, tmp_prob.m_lb, tmp_prob.m_ub,
+           tmp_prob.m_nobj, tmp_prob.m_nec, tmp_prob.m_nic, tmp_prob.m_nix, tmp_prob.m_c_tol,
+           tmp_prob.m_has_raw_fitness, tmp_prob.m_has_batch_fitness, tmp_prob.m_has_gradient,
            tmp_prob.m_has_gradient_sparsity, tmp_prob.m_has_hessians, tmp_prob.m_has_hessians_sparsity,
-           tmp_prob.m_has_set_seed, tmp_prob.m_name, tmp_prob.m_gs_dim, tmp_prob.m_hs_dim, tmp_prob.m_thread_safety);
+           tmp_prob.m_has_set_seed, tmp_prob.m_name, tmp_prob.m_gs_dim, tmp_prob.m_hs_dim, tmp_prob.m_thread_safety,
+           tmp_prob.m_cow);
+        tmp_prob.m_fevals.store(fevals, std::memory_order_relaxed);
+        tmp_prob.m_gevals.store(gevals, std::memory_order_relaxed);
+        tmp_prob.m_hevals.store(hevals, std::memory_order_relaxed);
         *this = std::move(tmp_prob);
     }
 
@@ -2109,9 +2612,14 @@ private:
         assert(m_ptr.get() != nullptr);
         return m_ptr.get();
     }
+    // NOTE: the non-const overload is used only when the UDP is about to be (potentially) modified:
+    // if the UDP is shared with other problems (see set_copy_on_write()), clone it first.
     detail::prob_inner_base *ptr()
     {
         assert(m_ptr.get() != nullptr);
+        if (m_ptr.use_count() > 1) {
+            m_ptr = m_ptr->clone();
+        }
         return m_ptr.get();
     }
 
@@ -2205,6 +2713,80 @@ private:
         }
     }
 
+    // Check a batch of decision vectors, and return the number of vectors in the batch.
+    vector_double::size_type check_batch_decision_vectors(const vector_double &dvs) const
+    {
+        return detail::check_batch_dvs(dvs, get_nx(), get_nf());
+    }
+
+    void check_batch_fitness_vectors(const vector_double &fvs, vector_double::size_type n_dvs) const
+    {
+        const auto nf = get_nf();
+        // Checks dimension of returned batch of fitnesses
+        if (fvs.size() != n_dvs * nf) {
+            pagmo_throw(std::invalid_argument, "Length of the batch of fitness vectors is "
+                                                   + std::to_string(fvs.size()) + ", should be "
+                                                   + std::to_string(n_dvs * nf));
+        }
+    }
+
+    // Evaluate the n_dvs decision vectors stored contiguously starting at dvs, writing the fitnesses
+    // into the buffer starting at fvs (which must be able to hold n_dvs * get_nf() values), and increment the
+    // fitness evaluation counter. The decision vectors are assumed to have been checked already.
+    void batch_fitness_impl(const double *dvs, vector_double::size_type n_dvs, double *fvs) const
+    {
+        const auto nx = get_nx();
+        const auto nf = get_nf();
+        if (m_has_batch_fitness) {
+            // NOTE: the UDP works on vectors, the input must be copied here.
+            vector_double tmp;
+            tracked_call(&detail::problem_latencies::m_fitness,
+                         [this, dvs, n_dvs, nx, &tmp]() {
+                             tmp = ptr()->batch_fitness(vector_double(dvs, dvs + n_dvs * nx));
+                         },
+                         n_dvs);
+            check_batch_fitness_vectors(tmp, n_dvs);
+            std::copy(tmp.begin(), tmp.end(), fvs);
+        } else if (m_has_raw_fitness) {
+            // Evaluate directly from/into the contiguous buffers.
+            for (decltype(n_dvs) i = 0u; i < n_dvs; ++i) {
+                tracked_call(&detail::problem_latencies::m_fitness,
+                             [this, dvs, fvs, i, nx, nf]() { ptr()->raw_fitness(dvs + i * nx, fvs + i * nf); });
+            }
+        } else {
+            // Fall back to a loop over the fitness() method of the UDP, re-using
+            // a single decision vector as scratch buffer.
+            vector_double dv(nx);
+            for (decltype(n_dvs) i = 0u; i < n_dvs; ++i) {
+                std::copy(dvs + i * nx, dvs + (i + 1u) * nx, dv.begin());
+                vector_double f;
+                tracked_call(&detail::problem_latencies::m_fitness, [this, &dv, &f]() { f = ptr()->fitness(dv); });
+                check_fitness_vector(f);
+                std::copy(f.begin(), f.end(), fvs + i * nf);
+            }
+        }
+        // Increment the fitness evaluation counter, once for the whole batch.
+        m_fevals.fetch_add(n_dvs, std::memory_order_relaxed);
+    }
+
+    // Invoke f(), recording its latency in the histogram hist of m_latencies, if latency tracking
+    // is enabled. The latency is split evenly among n calls.
+    template <typename F>
+    void tracked_call(latency_histogram detail::problem_latencies::*hist, const F &f, unsigned long long n = 1u) const
+    {
+        if (m_latencies) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            if (n) {
+                const auto d = std::chrono::duration_cast<latency_histogram::duration>(std::chrono::steady_clock::now()
+                                                                                       - start);
+                (m_latencies.get()->*hist).record(d / static_cast<latency_histogram::duration::rep>(n), n);
+            }
+        } else {
+            f();
+        }
+    }
+
     void check_gradient_vector(const vector_double &gr) const
     {
         // Checks that the gradient vector returned has the same dimensions of the sparsity_pattern
@@ -2235,14 +2817,22 @@ private:
     }
 
 private:
-    // Pointer to the inner base problem
-    std::unique_ptr<detail::prob_inner_base> m_ptr;
+    // Pointer to the inner base problem (shared with other problems only if copy-on-write is enabled).
+    std::shared_ptr<detail::prob_inner_base> m_ptr;
     // Counter for calls to the fitness
-    mutable unsigned long long m_fevals;
+    mutable std::atomic<unsigned long long> m_fevals;
     // Counter for calls to the gradient
-    mutable unsigned long long m_gevals;
+    mutable std::atomic<unsigned long long> m_gevals;
     // Counter for calls to the hessians
-    mutable unsigned long long m_hevals;
+    mutable std::atomic<unsigned long long> m_hevals;
+    // Latency histograms (null if latency tracking is disabled).
+    std::unique_ptr<detail::problem_latencies> m_latencies;
+    // Identifier of the state of the UDP: two problems with the same id contain UDPs
+    // in the same state (e.g., because one is a copy of the other). A new id is generated
+    // whenever the UDP might be modified. It is not serialized.
+    unsigned long long m_udp_id;
+    // Copy-on-write flag.
+    bool m_cow;
     // Various problem properties determined at construction time
     // from the concrete problem. These will be constant for the lifetime
     // of problem, but we cannot mark them as such because of serialization.
@@ -2253,6 +2843,8 @@ private:
     vector_double::size_type m_nic;
     vector_double::size_type m_nix;
     vector_double m_c_tol;
+    bool m_has_raw_fitness;
+    bool m_has_batch_fitness;
     bool m_has_gradient;
     bool m_has_gradient_sparsity;
     bool m_has_hessians;
@@ -2268,6 +2860,25 @@ private:
     thread_safety m_thread_safety;
 };
 
+namespace detail
+{
+
+// Fetch the identifier of the state of the UDP of p. This is used by the batch
+// fitness evaluators to detect when their cached copies of a problem become stale.
+inline unsigned long long udp_id(const problem &p)
+{
+    return p.m_udp_id;
+}
+
+// Evaluate via p the n_dvs decision vectors stored contiguously starting at dvs, writing the fitnesses into
+// the buffer starting at fvs. This is used by the batch fitness evaluators in order to evaluate a subrange of
+// a batch without copying it. The size of the batch must have been checked with check_batch_dvs().
+inline void batch_fitness_range(const problem &p, const double *dvs, vector_double::size_type n_dvs, double *fvs)
+{
+    p.batch_fitness_impl(dvs, n_dvs, fvs);
+}
+} // namespace detail
+
 } // namespace pagmo
 
 PAGMO_REGISTER_PROBLEM(pagmo::null_problem)
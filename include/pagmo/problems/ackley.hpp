@@ -29,12 +29,15 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_PROBLEM_ACKLEY_HPP
 #define PAGMO_PROBLEM_ACKLEY_HPP
 
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <pagmo/detail/batch_kernel.hpp>
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp> // needed for cereal registration macro
@@ -43,6 +46,30 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+// Batch kernel for the Ackley function (see batch_kernel_fitness()).
+inline void ackley_batch_kernel(const double *tile, vector_double::size_type n, double *out)
+{
+    constexpr auto w = batch_kernel_width;
+    double omega = 2. * detail::pi();
+    double nepero = std::exp(1.0);
+    double s1[w] = {}, s2[w] = {};
+    for (decltype(n) i = 0u; i < n; i++) {
+        const auto x = tile + i * w;
+        for (std::size_t l = 0; l < w; ++l) {
+            s1[l] += x[l] * x[l];
+            s2[l] += std::cos(omega * x[l]);
+        }
+    }
+    for (std::size_t l = 0; l < w; ++l) {
+        out[l] = -20 * std::exp(-0.2 * std::sqrt(1.0 / static_cast<double>(n) * s1[l]))
+                 - std::exp(1.0 / static_cast<double>(n) * s2[l]) + 20 + nepero;
+    }
+}
+} // namespace detail
+
 /// The Ackley problem.
 /**
  *
@@ -96,6 +123,22 @@ struct ackley {
                - std::exp(1.0 / static_cast<double>(n) * s2) + 20 + nepero;
         return f;
     }
+    /// Batch fitness computation
+    /**
+     * Computes the fitness of a batch of decision vectors stored contiguously in \p dvs.
+     * The decision vectors are processed in blocks, transposed into a structure-of-arrays
+     * layout whose sums over the components the compiler can vectorize. The results are bitwise
+     * identical to those of fitness() (0 ULP error bound) unless value-changing floating-point
+     * optimisations are enabled.
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        return detail::batch_kernel_fitness(dvs, m_dim, detail::ackley_batch_kernel);
+    }
     /// Box-bounds
     /**
      *
@@ -37,13 +37,17 @@ see https://www.gnu.org/licenses/. */
 
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <pagmo/detail/cec2013_data.hpp>
+#include <pagmo/detail/cec_tables.hpp>
+#include <pagmo/detail/cec_workspace.hpp>
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp> // needed for cereal registration macro
@@ -71,6 +75,12 @@ namespace pagmo
  *
  *    All problems are box-bounded, continuous, single objective problems.
  *
+ * .. note::
+ *
+ *    The fitness evaluation does not use any scratch memory stored in the problem, so that concurrent fitness
+ *    evaluations on the same instance are safe. The batch fitness evaluation computes the rotations of blocks of
+ *    decision vectors as matrix-matrix products, producing results identical to the ones of the fitness function.
+ *
  * .. seealso:
  *
  *    http://www.ntu.edu.sg/home/EPNSugan/index_files/CEC2013/CEC2013.htm
@@ -92,7 +102,7 @@ public:
      * [2,5,10,20,30,40,50,60,70,80,90,100]
      */
     cec2013(unsigned int prob_id = 1u, unsigned int dim = 2u)
-        : m_prob_id(prob_id), m_rotation_matrix(), m_origin_shift(), m_y(dim), m_z(dim)
+        : m_prob_id(prob_id), m_dim(dim)
     {
         if (!(dim == 2u || dim == 5u || dim == 10u || dim == 20u || dim == 30u || dim == 40u || dim == 50u || dim == 60u
               || dim == 70u || dim == 80u || dim == 90u || dim == 100u)) {
@@ -105,10 +115,14 @@ public:
                         "Error: CEC2013 Test functions are only defined for prob_id in [1, 28], a prob_id of "
                             + std::to_string(prob_id) + " was detected.");
         }
-        m_origin_shift = detail::cec2013_data::shift_data;
-        auto it = detail::cec2013_data::MD.find(dim);
-        assert(it != detail::cec2013_data::MD.end());
-        m_rotation_matrix = it->second;
+        m_data = detail::cec_shared_tables<cec2013>(prob_id, dim, [dim]() {
+            detail::cec_tables retval;
+            retval.shift = detail::cec2013_data::shift_data;
+            auto it = detail::cec2013_data::MD.find(dim);
+            assert(it != detail::cec2013_data::MD.end());
+            retval.rotation = it->second;
+            return retval;
+        });
     }
     /// Fitness computation
     /**
@@ -120,429 +134,554 @@ public:
      */
     vector_double fitness(const vector_double &x) const
     {
-        unsigned int nx = static_cast<unsigned int>(m_z.size()); // maximum is 100
         vector_double f(1);
+        detail::cec_workspace ws(m_dim);
+        evaluate(x.data(), f.data(), ws);
+        return f;
+    }
+    /// Batch fitness computation
+    /**
+     * Computes the fitness of a batch of decision vectors stored contiguously in \p dvs. For the problems
+     * whose evaluation starts with the shift and rotation of the decision vector, the rotations of blocks of
+     * decision vectors are computed together, as a cache-blocked matrix-matrix product. The results are
+     * identical to those of fitness().
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        const auto nx = m_dim;
+        const auto n_dvs = dvs.size() / nx;
+        const auto block = detail::cec_rotation_block;
+        vector_double retval(n_dvs);
+        detail::cec_workspace ws(nx);
+        std::vector<double> in(block * nx), out(block * nx);
+        for (decltype(dvs.size()) b = 0; b < n_dvs; b += block) {
+            const auto n_block = static_cast<unsigned>(std::min<decltype(dvs.size())>(block, n_dvs - b));
+            const auto x = dvs.data() + b * nx;
+            bool rotated = true;
+            for (unsigned p = 0; p < n_block && rotated; ++p) {
+                rotated = first_rotation_input(x + p * nx, in.data() + p * nx);
+            }
+            if (rotated) {
+                detail::cec_rotate_block(in.data(), out.data(), nx, n_block, m_data->rotation.data());
+            }
+            for (unsigned p = 0; p < n_block; ++p) {
+                if (rotated) {
+                    ws.set_hint(m_data->rotation.data(), in.data() + p * nx, out.data() + p * nx);
+                }
+                evaluate(x + p * nx, retval.data() + b + p, ws);
+            }
+        }
+        return retval;
+    }
+    /// Box-bounds
+    /**
+     *
+     * It returns the box-bounds for this UDP.
+     *
+     * @return the lower and upper bounds for each of the decision vector components
+     */
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        // all CEC 2013 problems have the same bounds
+        vector_double lb(m_dim, -100.);
+        vector_double ub(m_dim, 100.);
+        return std::make_pair(std::move(lb), std::move(ub));
+    }
+    /// Problem name
+    /**
+     *
+     *
+     * @return a string containing the problem name
+     */
+    std::string get_name() const
+    {
+        std::string retval("CEC2013 - f");
+        retval.append(std::to_string(m_prob_id));
         switch (m_prob_id) {
             case 1:
-                sphere_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 0);
-                f[0] += -1400.0;
+                retval.append("(sphere_func)");
                 break;
             case 2:
-                ellips_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -1300.0;
+                retval.append("(ellips_func)");
                 break;
             case 3:
-                bent_cigar_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -1200.0;
+                retval.append("(bent_cigar_func)");
                 break;
             case 4:
-                discus_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -1100.0;
+                retval.append("(discus_func)");
                 break;
             case 5:
-                dif_powers_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 0);
-                f[0] += -1000.0;
+                retval.append("(dif_powers_func_non_rotated)");
                 break;
             case 6:
-                rosenbrock_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -900.0;
+                retval.append("(rosenbrock_func)");
                 break;
             case 7:
-                schaffer_F7_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -800.0;
+                retval.append("(schaffer_F7_func)");
                 break;
             case 8:
-                ackley_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -700.0;
+                retval.append("(ackley_func)");
                 break;
             case 9:
-                weierstrass_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -600.0;
+                retval.append("(weierstrass_func)");
                 break;
             case 10:
-                griewank_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -500.0;
+                retval.append("(griewank_func)");
                 break;
             case 11:
-                rastrigin_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 0);
-                f[0] += -400.0;
+                retval.append("(rastrigin_func_non_rotated)");
                 break;
             case 12:
-                rastrigin_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -300.0;
+                retval.append("(rastrigin_func)");
                 break;
             case 13:
-                step_rastrigin_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += -200.0;
+                retval.append("(step_rastrigin_func)");
                 break;
             case 14:
-                schwefel_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 0);
-                f[0] += -100.0;
+                retval.append("(schwefel_func_non_rotated)");
                 break;
             case 15:
-                schwefel_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 100.0;
+                retval.append("(schwefel_func)");
                 break;
             case 16:
-                katsuura_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 200.0;
+                retval.append("(katsuura_func)");
                 break;
             case 17:
-                bi_rastrigin_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 0);
-                f[0] += 300.0;
+                retval.append("(bi_rastrigin_func_non_rotated)");
                 break;
             case 18:
-                bi_rastrigin_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 400.0;
+                retval.append("(bi_rastrigin_func)");
                 break;
             case 19:
-                grie_rosen_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 500.0;
+                retval.append("(grie_rosen_func)");
                 break;
             case 20:
-                escaffer6_func(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 600.0;
+                retval.append("(escaffer6_func)");
                 break;
             case 21:
-                cf01(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 700.0;
+                retval.append("(cf01)");
                 break;
             case 22:
-                cf02(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 0);
-                f[0] += 800.0;
+                retval.append("(cf02)");
                 break;
             case 23:
-                cf03(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 900.0;
+                retval.append("(cf03)");
                 break;
             case 24:
-                cf04(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 1000.0;
+                retval.append("(cf04)");
                 break;
             case 25:
-                cf05(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 1100.0;
+                retval.append("(cf05)");
                 break;
             case 26:
-                cf06(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 1200.0;
+                retval.append("(cf06)");
                 break;
             case 27:
-                cf07(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 1300.0;
+                retval.append("(cf07)");
                 break;
             case 28:
-                cf08(&x[0], &f[0], nx, &m_origin_shift[0], &m_rotation_matrix[0], 1);
-                f[0] += 1400.0;
+                retval.append("(cf08)");
                 break;
         }
-        return f;
+        return retval;
     }
-    /// Box-bounds
+    /// Save to archive.
     /**
+     * This method will save the problem id and the dimension of \p this into the archive \p ar
+     * (the problem data is not saved, as it is reloaded on deserialization).
      *
-     * It returns the box-bounds for this UDP.
+     * @param ar target archive.
      *
-     * @return the lower and upper bounds for each of the decision vector components
+     * @throws unspecified any exception thrown by the serialization of primitive types.
      */
-    std::pair<vector_double, vector_double> get_bounds() const
+    template <typename Archive>
+    void save(Archive &ar) const
     {
-        // all CEC 2013 problems have the same bounds
-        vector_double lb(m_z.size(), -100.);
-        vector_double ub(m_z.size(), 100.);
-        return std::make_pair(std::move(lb), std::move(ub));
+        ar(m_prob_id, m_dim);
     }
-    /// Problem name
+    /// Load from archive.
     /**
+     * This method will load a pagmo::cec2013 from the archive \p ar into \p this.
      *
+     * @param ar source archive.
      *
-     * @return a string containing the problem name
+     * @throws unspecified any exception thrown by the serialization of primitive types, or by the constructor
+     * of pagmo::cec2013 if the loaded problem id and dimension are invalid.
      */
-    std::string get_name() const
+    template <typename Archive>
+    void load(Archive &ar)
     {
-        std::string retval("CEC2013 - f");
-        retval.append(std::to_string(m_prob_id));
+        unsigned int prob_id, dim;
+        ar(prob_id, dim);
+        *this = cec2013(prob_id, dim);
+    }
+
+private:
+    // Evaluate the fitness of x (of size m_dim) into f, using the scratch memory in ws.
+    void evaluate(const double *x, double *f, detail::cec_workspace &ws) const
+    {
+        unsigned int nx = m_dim; // maximum is 100
         switch (m_prob_id) {
             case 1:
-                retval.append("(sphere_func)");
+                sphere_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 0, ws);
+                f[0] += -1400.0;
                 break;
             case 2:
-                retval.append("(ellips_func)");
+                ellips_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -1300.0;
                 break;
             case 3:
-                retval.append("(bent_cigar_func)");
+                bent_cigar_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -1200.0;
                 break;
             case 4:
-                retval.append("(discus_func)");
+                discus_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -1100.0;
                 break;
             case 5:
-                retval.append("(dif_powers_func_non_rotated)");
+                dif_powers_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 0, ws);
+                f[0] += -1000.0;
                 break;
             case 6:
-                retval.append("(rosenbrock_func)");
+                rosenbrock_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -900.0;
                 break;
             case 7:
-                retval.append("(schaffer_F7_func)");
+                schaffer_F7_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -800.0;
                 break;
             case 8:
-                retval.append("(ackley_func)");
+                ackley_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -700.0;
                 break;
             case 9:
-                retval.append("(weierstrass_func)");
+                weierstrass_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -600.0;
                 break;
             case 10:
-                retval.append("(griewank_func)");
+                griewank_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -500.0;
                 break;
             case 11:
-                retval.append("(rastrigin_func_non_rotated)");
+                rastrigin_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 0, ws);
+                f[0] += -400.0;
                 break;
             case 12:
-                retval.append("(rastrigin_func)");
+                rastrigin_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -300.0;
                 break;
             case 13:
-                retval.append("(step_rastrigin_func)");
+                step_rastrigin_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += -200.0;
                 break;
             case 14:
-                retval.append("(schwefel_func_non_rotated)");
+                schwefel_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 0, ws);
+                f[0] += -100.0;
                 break;
             case 15:
-                retval.append("(schwefel_func)");
+                schwefel_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 100.0;
                 break;
             case 16:
-                retval.append("(katsuura_func)");
+                katsuura_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 200.0;
                 break;
             case 17:
-                retval.append("(bi_rastrigin_func_non_rotated)");
+                bi_rastrigin_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 0, ws);
+                f[0] += 300.0;
                 break;
             case 18:
-                retval.append("(bi_rastrigin_func)");
+                bi_rastrigin_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 400.0;
                 break;
             case 19:
-                retval.append("(grie_rosen_func)");
+                grie_rosen_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 500.0;
                 break;
             case 20:
-                retval.append("(escaffer6_func)");
+                escaffer6_func(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 600.0;
                 break;
             case 21:
-                retval.append("(cf01)");
+                cf01(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 700.0;
                 break;
             case 22:
-                retval.append("(cf02)");
+                cf02(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 0, ws);
+                f[0] += 800.0;
                 break;
             case 23:
-                retval.append("(cf03)");
+                cf03(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 900.0;
                 break;
             case 24:
-                retval.append("(cf04)");
+                cf04(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 1000.0;
                 break;
             case 25:
-                retval.append("(cf05)");
+                cf05(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 1100.0;
                 break;
             case 26:
-                retval.append("(cf06)");
+                cf06(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 1200.0;
                 break;
             case 27:
-                retval.append("(cf07)");
+                cf07(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 1300.0;
                 break;
             case 28:
-                retval.append("(cf08)");
+                cf08(&x[0], &f[0], nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 1400.0;
                 break;
         }
-        return retval;
     }
-    /// Object serialization
-    /**
-     * This method will save/load \p this into the archive \p ar.
-     *
-     * @param ar target archive.
-     *
-     * @throws unspecified any exception thrown by the serialization of primitive types.
-     */
-    template <typename Archive>
-    void serialize(Archive &ar)
+    // Compute into y the input of the first rotation performed by the evaluation of x (i.e., the shifted and
+    // possibly rescaled x, computed with the same operations as the functions below). Returns false for the
+    // problems whose evaluation does not start with the shift and rotation of x.
+    bool first_rotation_input(const double *x, double *y) const
     {
-        ar(m_prob_id, m_rotation_matrix, m_origin_shift, m_y, m_z);
+        const unsigned int nx = m_dim;
+        const double *Os = m_data->shift.data();
+        unsigned int i;
+        switch (m_prob_id) {
+            case 2:
+            case 3:
+            case 4:
+            case 7:
+            case 8:
+            case 20:
+                shiftfunc(x, y, nx, Os);
+                return true;
+            case 6:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] = y[i] * 2.048 / 100.;
+                }
+                return true;
+            case 9:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] = y[i] * 0.5 / 100;
+                }
+                return true;
+            case 10:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] = y[i] * 600.0 / 100.0;
+                }
+                return true;
+            case 12:
+            case 13:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] = y[i] * 5.12 / 100;
+                }
+                return true;
+            case 15:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] *= 1000. / 100.;
+                }
+                return true;
+            case 16:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] *= 5.0 / 100.0;
+                }
+                return true;
+            case 19:
+                shiftfunc(x, y, nx, Os);
+                for (i = 0u; i < nx; ++i) {
+                    y[i] = y[i] * 5 / 100;
+                }
+                return true;
+            default:
+                return false;
+        }
     }
-
-private:
     // For the coverage analysis we do not cover the code below as its derived from a third party source
     // LCOV_EXCL_START
     void sphere_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                     int r_flag) const /* Sphere */
+                     int r_flag, detail::cec_workspace &ws) const /* Sphere */
     {
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (unsigned int i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
         f[0] = 0.0;
         for (unsigned int i = 0u; i < nx; ++i) {
-            f[0] += m_z[i] * m_z[i];
+            f[0] += ws.z[i] * ws.z[i];
         }
     }
 
     void ellips_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                     int r_flag) const /* Ellipsoidal */
+                     int r_flag, detail::cec_workspace &ws) const /* Ellipsoidal */
     {
         unsigned int i;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
-        oszfunc(&m_z[0], &m_y[0], nx);
+                ws.z[i] = ws.y[i];
+        oszfunc(ws.z.data(), ws.y.data(), nx);
         f[0] = 0.0;
         for (i = 0u; i < nx; ++i) {
-            f[0] += std::pow(10.0, (6. * i) / (nx - 1u)) * m_y[i] * m_y[i];
+            f[0] += std::pow(10.0, (6. * i) / (nx - 1u)) * ws.y[i] * ws.y[i];
         }
     }
 
     void bent_cigar_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                         int r_flag) const /* Bent_Cigar */
+                         int r_flag, detail::cec_workspace &ws) const /* Bent_Cigar */
     {
         unsigned int i;
         double beta = 0.5;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
-        asyfunc(&m_z[0], &m_y[0], nx, beta);
+                ws.z[i] = ws.y[i];
+        asyfunc(ws.z.data(), ws.y.data(), nx, beta);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
-        f[0] = m_z[0] * m_z[0];
+        f[0] = ws.z[0] * ws.z[0];
         for (i = 1u; i < nx; ++i) {
-            f[0] += std::pow(10.0, 6.0) * m_z[i] * m_z[i];
+            f[0] += std::pow(10.0, 6.0) * ws.z[i] * ws.z[i];
         }
     }
 
     void discus_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                     int r_flag) const /* Discus */
+                     int r_flag, detail::cec_workspace &ws) const /* Discus */
     {
         unsigned int i;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
-        oszfunc(&m_z[0], &m_y[0], nx);
+                ws.z[i] = ws.y[i];
+        oszfunc(ws.z.data(), ws.y.data(), nx);
 
-        f[0] = std::pow(10.0, 6.0) * m_y[0] * m_y[0];
+        f[0] = std::pow(10.0, 6.0) * ws.y[0] * ws.y[0];
         for (i = 1u; i < nx; ++i) {
-            f[0] += m_y[i] * m_y[i];
+            f[0] += ws.y[i] * ws.y[i];
         }
     }
 
     void dif_powers_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                         int r_flag) const /* Different Powers */
+                         int r_flag, detail::cec_workspace &ws) const /* Different Powers */
     {
         unsigned int i;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
         f[0] = 0.0;
         for (i = 0u; i < nx; ++i) {
-            f[0] += std::pow(std::abs(m_z[i]), 2. + (4. * i) / (nx - 1u));
+            f[0] += std::pow(std::abs(ws.z[i]), 2. + (4. * i) / (nx - 1u));
         }
         f[0] = std::pow(f[0], 0.5);
     }
 
     void rosenbrock_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                         int r_flag) const /* Rosenbrock's */
+                         int r_flag, detail::cec_workspace &ws) const /* Rosenbrock's */
     {
         unsigned int i;
         double tmp1, tmp2;
-        shiftfunc(x, &m_y[0], nx, Os); // shift
+        shiftfunc(x, ws.y.data(), nx, Os); // shift
         for (i = 0u; i < nx; ++i)      // shrink to the orginal search range
         {
-            m_y[i] = m_y[i] * 2.048 / 100.;
+            ws.y[i] = ws.y[i] * 2.048 / 100.;
         }
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr); // rotate
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws); // rotate
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
         for (i = 0u; i < nx; ++i) // shift to orgin
         {
-            m_z[i] = m_z[i] + 1;
+            ws.z[i] = ws.z[i] + 1;
         }
 
         f[0] = 0.0;
         for (i = 0u; i < nx - 1; ++i) {
-            tmp1 = m_z[i] * m_z[i] - m_z[i + 1];
-            tmp2 = m_z[i] - 1.0;
+            tmp1 = ws.z[i] * ws.z[i] - ws.z[i + 1];
+            tmp2 = ws.z[i] - 1.0;
             f[0] += 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
         }
     }
 
     void schaffer_F7_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                          int r_flag) const /* Schwefel's 1.2  */
+                          int r_flag, detail::cec_workspace &ws) const /* Schwefel's 1.2  */
     {
         unsigned int i;
         double tmp;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
-        asyfunc(&m_z[0], &m_y[0], nx, 0.5);
+                ws.z[i] = ws.y[i];
+        asyfunc(ws.z.data(), ws.y.data(), nx, 0.5);
         for (i = 0u; i < nx; ++i)
-            m_z[i] = m_y[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.z[i] = ws.y[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         for (i = 0u; i < nx - 1u; ++i)
-            m_z[i] = std::pow(m_y[i] * m_y[i] + m_y[i + 1] * m_y[i + 1], 0.5);
+            ws.z[i] = std::pow(ws.y[i] * ws.y[i] + ws.y[i + 1] * ws.y[i + 1], 0.5);
         f[0] = 0.0;
         for (i = 0u; i < nx - 1u; ++i) {
-            tmp = std::sin(50.0 * std::pow(m_z[i], 0.2));
-            f[0] += std::pow(m_z[i], 0.5) + std::pow(m_z[i], 0.5) * tmp * tmp;
+            tmp = std::sin(50.0 * std::pow(ws.z[i], 0.2));
+            f[0] += std::pow(ws.z[i], 0.5) + std::pow(ws.z[i], 0.5) * tmp * tmp;
         }
         f[0] = f[0] * f[0] / (nx - 1) / (nx - 1);
     }
 
     void ackley_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                     int r_flag) const /* Ackley's  */
+                     int r_flag, detail::cec_workspace &ws) const /* Ackley's  */
     {
         unsigned int i;
         double sum1, sum2;
 
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
-        asyfunc(&m_z[0], &m_y[0], nx, 0.5);
+        asyfunc(ws.z.data(), ws.y.data(), nx, 0.5);
         for (i = 0u; i < nx; ++i)
-            m_z[i] = m_y[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.z[i] = ws.y[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         sum1 = 0.0;
         sum2 = 0.0;
         for (i = 0u; i < nx; ++i) {
-            sum1 += m_y[i] * m_y[i];
-            sum2 += std::cos(2.0 * detail::pi() * m_y[i]);
+            sum1 += ws.y[i] * ws.y[i];
+            sum2 += std::cos(2.0 * detail::pi() * ws.y[i]);
         }
         sum1 = -0.2 * std::sqrt(sum1 / nx);
         sum2 /= nx;
@@ -550,30 +689,30 @@ private:
     }
 
     void weierstrass_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                          int r_flag) const /* Weierstrass's  */
+                          int r_flag, detail::cec_workspace &ws) const /* Weierstrass's  */
     {
         unsigned int i, j, k_max;
         double sum = 0, sum2 = 0, a, b;
 
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] = m_y[i] * 0.5 / 100;
+            ws.y[i] = ws.y[i] * 0.5 / 100;
         }
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
-        asyfunc(&m_z[0], &m_y[0], nx, 0.5);
+        asyfunc(ws.z.data(), ws.y.data(), nx, 0.5);
         for (i = 0u; i < nx; ++i)
-            m_z[i] = m_y[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.z[i] = ws.y[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         a = 0.5;
         b = 3.0;
@@ -583,7 +722,7 @@ private:
             sum = 0.0;
             sum2 = 0.0;
             for (j = 0u; j <= k_max; ++j) {
-                sum += std::pow(a, j) * std::cos(2.0 * detail::pi() * std::pow(b, j) * (m_y[i] + 0.5));
+                sum += std::pow(a, j) * std::cos(2.0 * detail::pi() * std::pow(b, j) * (ws.y[i] + 0.5));
                 sum2 += std::pow(a, j) * std::cos(2.0 * detail::pi() * std::pow(b, j) * 0.5);
             }
             f[0] += sum;
@@ -592,193 +731,193 @@ private:
     }
 
     void griewank_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                       int r_flag) const /* Griewank's  */
+                       int r_flag, detail::cec_workspace &ws) const /* Griewank's  */
     {
         unsigned int i;
         double s, p;
 
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] = m_y[i] * 600.0 / 100.0;
+            ws.y[i] = ws.y[i] * 600.0 / 100.0;
         }
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         for (i = 0u; i < nx; ++i)
-            m_z[i] = m_z[i] * std::pow(100.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.z[i] = ws.z[i] * std::pow(100.0, (1. * i) / (nx - 1u) / 2.0);
 
         s = 0.0;
         p = 1.0;
         for (i = 0u; i < nx; ++i) {
-            s += m_z[i] * m_z[i];
-            p *= std::cos(m_z[i] / std::sqrt(1.0 + i));
+            s += ws.z[i] * ws.z[i];
+            p *= std::cos(ws.z[i] / std::sqrt(1.0 + i));
         }
         f[0] = 1.0 + s / 4000.0 - p;
     }
 
     void rastrigin_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                        int r_flag) const /* Rastrigin's  */
+                        int r_flag, detail::cec_workspace &ws) const /* Rastrigin's  */
     {
         unsigned int i;
         double alpha = 10.0, beta = 0.2;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] = m_y[i] * 5.12 / 100;
+            ws.y[i] = ws.y[i] * 5.12 / 100;
         }
 
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
-        oszfunc(&m_z[0], &m_y[0], nx);
-        asyfunc(&m_y[0], &m_z[0], nx, beta);
+        oszfunc(ws.z.data(), ws.y.data(), nx);
+        asyfunc(ws.y.data(), ws.z.data(), nx, beta);
 
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         for (i = 0u; i < nx; ++i) {
-            m_y[i] *= std::pow(alpha, (1. * i) / (nx - 1u) / 2);
+            ws.y[i] *= std::pow(alpha, (1. * i) / (nx - 1u) / 2);
         }
 
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         f[0] = 0.0;
         for (i = 0u; i < nx; ++i) {
-            f[0] += (m_z[i] * m_z[i] - 10.0 * std::cos(2.0 * detail::pi() * m_z[i]) + 10.0);
+            f[0] += (ws.z[i] * ws.z[i] - 10.0 * std::cos(2.0 * detail::pi() * ws.z[i]) + 10.0);
         }
     }
 
     void step_rastrigin_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                             int r_flag) const /* Noncontinuous Rastrigin's  */
+                             int r_flag, detail::cec_workspace &ws) const /* Noncontinuous Rastrigin's  */
     {
         unsigned int i;
         double alpha = 10.0, beta = 0.2;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] = m_y[i] * 5.12 / 100;
+            ws.y[i] = ws.y[i] * 5.12 / 100;
         }
 
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         for (i = 0u; i < nx; ++i) {
-            if (std::abs(m_z[i]) > 0.5) m_z[i] = std::floor(2. * m_z[i] + 0.5) / 2.;
+            if (std::abs(ws.z[i]) > 0.5) ws.z[i] = std::floor(2. * ws.z[i] + 0.5) / 2.;
         }
 
-        oszfunc(&m_z[0], &m_y[0], nx);
-        asyfunc(&m_y[0], &m_z[0], nx, beta);
+        oszfunc(ws.z.data(), ws.y.data(), nx);
+        asyfunc(ws.y.data(), ws.z.data(), nx, beta);
 
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         for (i = 0u; i < nx; ++i) {
-            m_y[i] *= std::pow(alpha, (1. * i) / (nx - 1u) / 2.);
+            ws.y[i] *= std::pow(alpha, (1. * i) / (nx - 1u) / 2.);
         }
 
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         f[0] = 0.0;
         for (i = 0u; i < nx; ++i) {
-            f[0] += (m_z[i] * m_z[i] - 10.0 * std::cos(2.0 * detail::pi() * m_z[i]) + 10.0);
+            f[0] += (ws.z[i] * ws.z[i] - 10.0 * std::cos(2.0 * detail::pi() * ws.z[i]) + 10.0);
         }
     }
 
     void schwefel_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                       int r_flag) const /* Schwefel's  */
+                       int r_flag, detail::cec_workspace &ws) const /* Schwefel's  */
     {
         unsigned int i;
         double tmp;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] *= 1000. / 100.;
+            ws.y[i] *= 1000. / 100.;
         }
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         for (i = 0u; i < nx; ++i)
-            m_y[i] = m_z[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.y[i] = ws.z[i] * std::pow(10.0, (1. * i) / (nx - 1u) / 2.0);
 
         for (i = 0u; i < nx; ++i)
-            m_z[i] = m_y[i] + 4.209687462275036e+002;
+            ws.z[i] = ws.y[i] + 4.209687462275036e+002;
 
         f[0] = 0;
         for (i = 0u; i < nx; ++i) {
-            if (m_z[i] > 500) {
-                f[0] -= (500.0 - std::fmod(m_z[i], 500)) * std::sin(std::pow(500.0 - std::fmod(m_z[i], 500), 0.5));
-                tmp = (m_z[i] - 500.0) / 100;
+            if (ws.z[i] > 500) {
+                f[0] -= (500.0 - std::fmod(ws.z[i], 500)) * std::sin(std::pow(500.0 - std::fmod(ws.z[i], 500), 0.5));
+                tmp = (ws.z[i] - 500.0) / 100;
                 f[0] += tmp * tmp / nx;
-            } else if (m_z[i] < -500) {
-                f[0] -= (-500.0 + std::fmod(std::abs(m_z[i]), 500))
-                        * std::sin(std::pow(500.0 - std::fmod(std::abs(m_z[i]), 500), 0.5));
-                tmp = (m_z[i] + 500.0) / 100;
+            } else if (ws.z[i] < -500) {
+                f[0] -= (-500.0 + std::fmod(std::abs(ws.z[i]), 500))
+                        * std::sin(std::pow(500.0 - std::fmod(std::abs(ws.z[i]), 500), 0.5));
+                tmp = (ws.z[i] + 500.0) / 100;
                 f[0] += tmp * tmp / nx;
             } else
-                f[0] -= m_z[i] * std::sin(std::pow(std::abs(m_z[i]), 0.5));
+                f[0] -= ws.z[i] * std::sin(std::pow(std::abs(ws.z[i]), 0.5));
         }
         f[0] = 4.189828872724338e+002 * nx + f[0];
     }
 
     void katsuura_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                       int r_flag) const /* Katsuura  */
+                       int r_flag, detail::cec_workspace &ws) const /* Katsuura  */
     {
         unsigned int i, j;
         double temp, tmp1, tmp2, tmp3;
         tmp3 = std::pow(1.0 * nx, 1.2);
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] *= 5.0 / 100.0;
+            ws.y[i] *= 5.0 / 100.0;
         }
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         for (i = 0u; i < nx; ++i)
-            m_z[i] *= std::pow(100.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.z[i] *= std::pow(100.0, (1. * i) / (nx - 1u) / 2.0);
 
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         f[0] = 1.0;
         for (i = 0u; i < nx; ++i) {
             temp = 0.0;
             for (j = 1u; j <= 32u; ++j) {
                 tmp1 = std::pow(2.0, j);
-                tmp2 = tmp1 * m_y[i];
+                tmp2 = tmp1 * ws.y[i];
                 temp += std::abs(tmp2 - std::floor(tmp2 + 0.5)) / tmp1;
             }
             f[0] *= std::pow(1.0 + (i + 1u) * temp, 10.0 / tmp3);
@@ -788,7 +927,7 @@ private:
     }
 
     void bi_rastrigin_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                           int r_flag) const /* Lunacek Bi_rastrigin Function */
+                           int r_flag, detail::cec_workspace &ws) const /* Lunacek Bi_rastrigin Function */
     {
         unsigned int i;
         double mu0 = 2.5, d = 1.0, s, mu1, tmp, tmp1, tmp2;
@@ -797,34 +936,34 @@ private:
         s = 1.0 - 1.0 / (2.0 * std::pow(nx + 20.0, 0.5) - 8.2);
         mu1 = -std::pow((mu0 * mu0 - d) / s, 0.5);
 
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] *= 10.0 / 100.0;
+            ws.y[i] *= 10.0 / 100.0;
         }
 
         for (i = 0u; i < nx; ++i) {
-            tmpx[i] = 2 * m_y[i];
+            tmpx[i] = 2 * ws.y[i];
             if (Os[i] < 0.) tmpx[i] *= -1.;
         }
 
         for (i = 0u; i < nx; ++i) {
-            m_z[i] = tmpx[i];
+            ws.z[i] = tmpx[i];
             tmpx[i] += mu0;
         }
         if (r_flag == 1)
-            rotatefunc(&m_z[0], &m_y[0], nx, Mr);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_y[i] = m_z[i];
+                ws.y[i] = ws.z[i];
 
         for (i = 0u; i < nx; ++i)
-            m_y[i] *= std::pow(100.0, (1. * i) / (nx - 1u) / 2.0);
+            ws.y[i] *= std::pow(100.0, (1. * i) / (nx - 1u) / 2.0);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         tmp1 = 0.0;
         tmp2 = 0.0;
@@ -838,7 +977,7 @@ private:
         tmp2 += d * nx;
         tmp = 0;
         for (i = 0u; i < nx; ++i) {
-            tmp += std::cos(2.0 * detail::pi() * m_z[i]);
+            tmp += std::cos(2.0 * detail::pi() * ws.z[i]);
         }
 
         if (tmp1 < tmp2)
@@ -850,75 +989,75 @@ private:
     }
 
     void grie_rosen_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                         int r_flag) const /* Griewank-Rosenbrock  */
+                         int r_flag, detail::cec_workspace &ws) const /* Griewank-Rosenbrock  */
     {
         unsigned int i;
         double temp, tmp1, tmp2;
 
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         for (i = 0u; i < nx; ++i) // shrink to the orginal search range
         {
-            m_y[i] = m_y[i] * 5 / 100;
+            ws.y[i] = ws.y[i] * 5 / 100;
         }
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         for (i = 0u; i < nx; ++i) // shift to orgin
         {
-            m_z[i] = m_y[i] + 1;
+            ws.z[i] = ws.y[i] + 1;
         }
 
         f[0] = 0.0;
         for (i = 0u; i < nx - 1u; ++i) {
-            tmp1 = m_z[i] * m_z[i] - m_z[i + 1];
-            tmp2 = m_z[i] - 1.0;
+            tmp1 = ws.z[i] * ws.z[i] - ws.z[i + 1];
+            tmp2 = ws.z[i] - 1.0;
             temp = 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
             f[0] += (temp * temp) / 4000.0 - std::cos(temp) + 1.0;
         }
-        tmp1 = m_z[nx - 1] * m_z[nx - 1] - m_z[0];
-        tmp2 = m_z[nx - 1] - 1.0;
+        tmp1 = ws.z[nx - 1] * ws.z[nx - 1] - ws.z[0];
+        tmp2 = ws.z[nx - 1] - 1.0;
         temp = 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
         ;
         f[0] += (temp * temp) / 4000.0 - std::cos(temp) + 1.0;
     }
 
     void escaffer6_func(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-                        int r_flag) const /* Expanded Scaffer¡¯s F6  */
+                        int r_flag, detail::cec_workspace &ws) const /* Expanded Scaffer¡¯s F6  */
     {
         unsigned int i;
         double temp1, temp2;
-        shiftfunc(x, &m_y[0], nx, Os);
+        shiftfunc(x, ws.y.data(), nx, Os);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, Mr);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, Mr, ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
-        asyfunc(&m_z[0], &m_y[0], nx, 0.5);
+        asyfunc(ws.z.data(), ws.y.data(), nx, 0.5);
         if (r_flag == 1)
-            rotatefunc(&m_y[0], &m_z[0], nx, &Mr[nx * nx]);
+            rotatefunc(ws.y.data(), ws.z.data(), nx, &Mr[nx * nx], ws);
         else
             for (i = 0u; i < nx; ++i)
-                m_z[i] = m_y[i];
+                ws.z[i] = ws.y[i];
 
         f[0] = 0.0;
         for (i = 0u; i < nx - 1u; ++i) {
-            temp1 = std::sin(std::sqrt(m_z[i] * m_z[i] + m_z[i + 1] * m_z[i + 1]));
+            temp1 = std::sin(std::sqrt(ws.z[i] * ws.z[i] + ws.z[i + 1] * ws.z[i + 1]));
             temp1 = temp1 * temp1;
-            temp2 = 1.0 + 0.001 * (m_z[i] * m_z[i] + m_z[i + 1] * m_z[i + 1]);
+            temp2 = 1.0 + 0.001 * (ws.z[i] * ws.z[i] + ws.z[i + 1] * ws.z[i + 1]);
             f[0] += 0.5 + (temp1 - 0.5) / (temp2 * temp2);
         }
-        temp1 = std::sin(std::sqrt(m_z[nx - 1] * m_z[nx - 1] + m_z[0] * m_z[0]));
+        temp1 = std::sin(std::sqrt(ws.z[nx - 1] * ws.z[nx - 1] + ws.z[0] * ws.z[0]));
         temp1 = temp1 * temp1;
-        temp2 = 1.0 + 0.001 * (m_z[nx - 1] * m_z[nx - 1] + m_z[0] * m_z[0]);
+        temp2 = 1.0 + 0.001 * (ws.z[nx - 1] * ws.z[nx - 1] + ws.z[0] * ws.z[0]);
         f[0] += 0.5 + (temp1 - 0.5) / (temp2 * temp2);
     }
 
     void cf01(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 1 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 1 */
     {
         unsigned int i, cf_num = 5;
         double fit[5];
@@ -926,158 +1065,158 @@ private:
         double bias[5] = {0, 100, 200, 300, 400};
 
         i = 0u;
-        rosenbrock_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        rosenbrock_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+4;
         i = 1u;
-        dif_powers_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        dif_powers_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         i = 2u;
-        bent_cigar_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        bent_cigar_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+30;
         i = 3u;
-        discus_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        discus_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         i = 4u;
-        sphere_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 0);
+        sphere_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 0, ws);
         fit[i] = 10000 * fit[i] / 1e+5;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf02(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 2 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 2 */
     {
         unsigned int i, cf_num = 3u;
         double fit[3];
         double delta[3] = {20, 20, 20};
         double bias[3] = {0, 100, 200};
         for (i = 0u; i < cf_num; ++i) {
-            schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+            schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         }
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf03(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 3 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 3 */
     {
         unsigned int i, cf_num = 3u;
         double fit[3];
         double delta[3] = {20, 20, 20};
         double bias[3] = {0, 100, 200};
         for (i = 0u; i < cf_num; ++i) {
-            schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+            schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         }
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf04(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 4 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 4 */
     {
         unsigned int i, cf_num = 3u;
         double fit[3];
         double delta[3] = {20, 20, 20};
         double bias[3] = {0, 100, 200};
         i = 0u;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 4e+3;
         i = 1u;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+3;
         i = 2u;
-        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 400;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf05(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 4 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 4 */
     {
         unsigned int i, cf_num = 3u;
         double fit[3];
         double delta[3] = {10, 30, 50};
         double bias[3] = {0, 100, 200};
         i = 0u;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 4e+3;
         i = 1u;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+3;
         i = 2u;
-        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 400;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf06(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 6 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 6 */
     {
         unsigned int i, cf_num = 5u;
         double fit[5];
         double delta[5] = {10, 10, 10, 10, 10};
         double bias[5] = {0, 100, 200, 300, 400};
         i = 0u;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 4e+3;
         i = 1u;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+3;
         i = 2u;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+10;
         i = 3u;
-        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 400;
         i = 4u;
-        griewank_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        griewank_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 1000 * fit[i] / 100;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf07(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 7 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 7 */
     {
         unsigned int i, cf_num = 5u;
         double fit[5];
         double delta[5] = {10, 10, 10, 20, 20};
         double bias[5] = {0, 100, 200, 300, 400};
         i = 0u;
-        griewank_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        griewank_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 100;
         i = 1u;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+3;
         i = 2u;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+3;
         i = 3u;
-        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 400;
         i = 4u;
-        sphere_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 0);
+        sphere_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 0, ws);
         fit[i] = 10000 * fit[i] / 1e+5;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     void cf08(const double *x, double *f, const unsigned int nx, const double *Os, const double *Mr,
-              int r_flag) const /* Composition Function 8 */
+              int r_flag, detail::cec_workspace &ws) const /* Composition Function 8 */
     {
         unsigned int i, cf_num = 5u;
         double fit[5];
         double delta[5] = {10, 20, 30, 40, 50};
         double bias[5] = {0, 100, 200, 300, 400};
         i = 0u;
-        grie_rosen_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        grie_rosen_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+3;
         i = 1u;
-        schaffer_F7_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        schaffer_F7_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+6;
         i = 2u;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+3;
         i = 3u;
-        escaffer6_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag);
+        escaffer6_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], r_flag, ws);
         fit[i] = 10000 * fit[i] / 2e+7;
         i = 4u;
-        sphere_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 0);
+        sphere_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 0, ws);
         fit[i] = 10000 * fit[i] / 1e+5;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
@@ -1090,8 +1229,13 @@ private:
         }
     }
 
-    void rotatefunc(const double *x, double *xrot, const unsigned int nx, const double *Mr) const
+    void rotatefunc(const double *x, double *xrot, const unsigned int nx, const double *Mr,
+                    detail::cec_workspace &ws) const
     {
+        // Reuse the rotation precomputed by batch_fitness(), if any.
+        if (ws.use_hint(x, xrot, nx, Mr)) {
+            return;
+        }
         unsigned int i, j;
         for (i = 0u; i < nx; ++i) {
             xrot[i] = 0;
@@ -1174,13 +1318,11 @@ private:
 
     // problem id
     unsigned int m_prob_id;
-    // problem data
-    std::vector<double> m_rotation_matrix;
-    std::vector<double> m_origin_shift;
-
-    // pre-allocated stuff for speed
-    mutable std::vector<double> m_y;
-    mutable std::vector<double> m_z;
+    // problem data (rotation matrices and shift vectors), shared among all the instances with the same id
+    // and dimension
+    std::shared_ptr<const detail::cec_tables> m_data;
+    // problem dimension
+    unsigned int m_dim;
 };
 
 } // namespace pagmo
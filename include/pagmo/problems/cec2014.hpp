@@ -14,17 +14,21 @@
 
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <math.h>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <stdio.h>
 #include <vector>
 
 #include <pagmo/detail/cec2014_data.hpp>
+#include <pagmo/detail/cec_tables.hpp>
+#include <pagmo/detail/cec_workspace.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp> // needed for cereal registration macro
 #include <pagmo/types.hpp>
@@ -54,6 +58,12 @@ namespace pagmo
  *
  *    All problems are box-bounded, continuous, single objective problems.
  *
+ * .. note::
+ *
+ *    The fitness evaluation does not use any scratch memory stored in the problem, so that concurrent fitness
+ *    evaluations on the same instance are safe. The batch fitness evaluation computes the rotations of blocks of
+ *    decision vectors as matrix-matrix products, producing results identical to the ones of the fitness function.
+ *
  * .. seealso:
  *
  *    http://www.ntu.edu.sg/home/EPNSugan/index_files/CEC2014/CEC2014.htm
@@ -75,7 +85,7 @@ public:
      * @throws invalid_argument if \p prob_id is not in [1,30] or if \p dim is not one of
      * [2,10,20,30,50,100]
      */
-    cec2014(unsigned prob_id = 1u, unsigned dim = 2u) : m_z(dim), m_y(dim), func_num(prob_id)
+    cec2014(unsigned prob_id = 1u, unsigned dim = 2u) : m_dim(dim), func_num(prob_id)
     {
         if (!(dim == 2u || dim == 10u || dim == 20u || dim == 30u || dim == 50u || dim == 100u)) {
             pagmo_throw(std::invalid_argument, "Error: CEC2014 Test functions are only defined for dimensions "
@@ -92,35 +102,29 @@ public:
             pagmo_throw(std::invalid_argument, "hf01,hf02,hf03,hf04,hf05,hf06,cf07&cf08 are NOT defined for D=2.");
         }
 
-        /* Load Rotation Matrix */
-        auto rotation_func_it = detail::cec2014_data::rotation_data.find(func_num);
-        auto rotation_data_dim = rotation_func_it->second;
-        auto rotation_dim_it = rotation_data_dim.find(dim);
-        m_rotation_matrix = rotation_dim_it->second;
+        m_data = detail::cec_shared_tables<cec2014>(prob_id, dim, [prob_id, dim]() {
+            detail::cec_tables retval;
+            /* Load Rotation Matrix */
+            const auto &rotation_data_dim = detail::cec2014_data::rotation_data.find(prob_id)->second;
+            retval.rotation = rotation_data_dim.find(dim)->second;
 
-        /* Load shift_data */
-        auto loader_it = detail::cec2014_data::shift_data.find(func_num);
-        m_origin_shift = loader_it->second;
+            /* Load shift_data */
+            const auto &shift_data = detail::cec2014_data::shift_data.find(prob_id)->second;
 
-        // Uses first dim elements of each line for multidimensional functions (id > 23)
-        auto it = m_origin_shift.begin();
-        int i = -1;
-        while (it != m_origin_shift.end()) {
-            i++;
-            if ((i % 100) >= static_cast<int>(dim)) {
-                it = m_origin_shift.erase(it);
-            } else {
-                ++it;
+            // Uses first dim elements of each line for multidimensional functions (id > 23)
+            for (decltype(shift_data.size()) i = 0; i < shift_data.size(); ++i) {
+                if (i % 100u < dim) {
+                    retval.shift.push_back(shift_data[i]);
+                }
             }
-        }
 
-        /* Load shuffle data */
-        if (((func_num >= 17) && (func_num <= 22)) || (func_num == 29) || (func_num == 30)) {
-            auto shuffle_func_it = detail::cec2014_data::shuffle_data.find(func_num);
-            auto shuffle_data_dim = shuffle_func_it->second;
-            auto shuffle_dim_it = shuffle_data_dim.find(dim);
-            m_shuffle = shuffle_dim_it->second;
-        }
+            /* Load shuffle data */
+            if (((prob_id >= 17) && (prob_id <= 22)) || (prob_id == 29) || (prob_id == 30)) {
+                const auto &shuffle_data_dim = detail::cec2014_data::shuffle_data.find(prob_id)->second;
+                retval.shuffle = shuffle_data_dim.find(dim)->second;
+            }
+            return retval;
+        });
     }
 
     /// Box-bounds
@@ -133,8 +137,8 @@ public:
     std::pair<vector_double, vector_double> get_bounds() const
     {
         // all CEC 2014 problems have the same bounds
-        vector_double lb(m_z.size(), -100.);
-        vector_double ub(m_z.size(), 100.);
+        vector_double lb(m_dim, -100.);
+        vector_double ub(m_dim, 100.);
         return std::make_pair(std::move(lb), std::move(ub));
     }
 
@@ -149,372 +153,480 @@ public:
     vector_double fitness(const vector_double &x) const
     {
         vector_double f(1);
-        auto nx = static_cast<unsigned>(m_z.size());
+        detail::cec_workspace ws(m_dim);
+        evaluate(x.data(), f.data(), ws);
+        return f;
+    }
+
+    /// Batch fitness computation
+    /**
+     * Computes the fitness of a batch of decision vectors stored contiguously in \p dvs. For the problems
+     * whose evaluation starts with the shift and rotation of the decision vector, the rotations of blocks of
+     * decision vectors are computed together, as a cache-blocked matrix-matrix product. The results are
+     * identical to those of fitness().
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        const auto nx = m_dim;
+        const auto n_dvs = dvs.size() / nx;
+        const auto block = detail::cec_rotation_block;
+        vector_double retval(n_dvs);
+        detail::cec_workspace ws(nx);
+        vector_double in(block * nx), out(block * nx);
+        for (decltype(dvs.size()) b = 0; b < n_dvs; b += block) {
+            const auto n_block = static_cast<unsigned>(std::min<decltype(dvs.size())>(block, n_dvs - b));
+            const auto x = dvs.data() + b * nx;
+            bool rotated = true;
+            for (unsigned p = 0; p < n_block && rotated; ++p) {
+                rotated = first_rotation_input(x + p * nx, in.data() + p * nx);
+            }
+            if (rotated) {
+                detail::cec_rotate_block(in.data(), out.data(), nx, n_block, m_data->rotation.data());
+            }
+            for (unsigned p = 0; p < n_block; ++p) {
+                if (rotated) {
+                    ws.set_hint(m_data->rotation.data(), in.data() + p * nx, out.data() + p * nx);
+                }
+                evaluate(x + p * nx, retval.data() + b + p, ws);
+            }
+        }
+        return retval;
+    }
+
+    /// Problem name
+    /**
+     *
+     *
+     * @return a string containing the problem name
+     */
+    std::string get_name() const
+    {
+        std::string retval("CEC2014 - f");
+        retval.append(std::to_string(func_num));
         switch (func_num) {
             case 1:
-                ellips_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 100.0;
+                retval.append("(ellips_func)");
                 break;
             case 2:
-                bent_cigar_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 200.0;
+                retval.append("(bent_cigar_func)");
                 break;
             case 3:
-                discus_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 300.0;
+                retval.append("(discus_func)");
                 break;
             case 4:
-                rosenbrock_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 400.0;
+                retval.append("(rosenbrock_func)");
                 break;
             case 5:
-                ackley_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 500.0;
+                retval.append("(ackley_func)");
                 break;
             case 6:
-                weierstrass_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 600.0;
+                retval.append("(weierstrass_func)");
                 break;
             case 7:
-                griewank_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 700.0;
+                retval.append("(griewank_func)");
                 break;
             case 8:
-                rastrigin_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 0);
-                f[0] += 800.0;
+                retval.append("(rastrigin_func_non_rotated)");
                 break;
             case 9:
-                rastrigin_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 900.0;
+                retval.append("(rastrigin_func)");
                 break;
             case 10:
-                schwefel_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 0);
-                f[0] += 1000.0;
+                retval.append("(schwefel_func_non_rotated)");
                 break;
             case 11:
-                schwefel_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 1100.0;
+                retval.append("(schwefel_func)");
                 break;
             case 12:
-                katsuura_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 1200.0;
+                retval.append("(katsuura_func)");
                 break;
             case 13:
-                happycat_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 1300.0;
+                retval.append("(happycat_func)");
                 break;
             case 14:
-                hgbat_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 1400.0;
+                retval.append("(hgbat_func)");
                 break;
             case 15:
-                grie_rosen_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 1500.0;
+                retval.append("(grie_rosen_func)");
                 break;
             case 16:
-                escaffer6_func(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1, 1);
-                f[0] += 1600.0;
+                retval.append("(escaffer6_func)");
                 break;
             case 17:
-                hf01(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1, 1);
-                f[0] += 1700.0;
+                retval.append("(hf01)");
                 break;
             case 18:
-                hf02(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1, 1);
-                f[0] += 1800.0;
+                retval.append("(hf02)");
                 break;
             case 19:
-                hf03(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1, 1);
-                f[0] += 1900.0;
+                retval.append("(hf03)");
                 break;
             case 20:
-                hf04(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1, 1);
-                f[0] += 2000.0;
+                retval.append("(hf04)");
                 break;
             case 21:
-                hf05(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1, 1);
-                f[0] += 2100.0;
+                retval.append("(hf05)");
                 break;
             case 22:
-                hf06(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1, 1);
-                f[0] += 2200.0;
+                retval.append("(hf06)");
                 break;
             case 23:
-                cf01(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1);
-                f[0] += 2300.0;
+                retval.append("(cf01)");
                 break;
             case 24:
-                cf02(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1);
-                f[0] += 2400.0;
+                retval.append("(cf02)");
                 break;
             case 25:
-                cf03(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1);
-                f[0] += 2500.0;
+                retval.append("(cf03)");
                 break;
             case 26:
-                cf04(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1);
-                f[0] += 2600.0;
+                retval.append("(cf04)");
                 break;
             case 27:
-                cf05(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1);
-                f[0] += 2700.0;
+                retval.append("(cf05)");
                 break;
             case 28:
-                cf06(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), 1);
-                f[0] += 2800.0;
+                retval.append("(cf06)");
                 break;
             case 29:
-                cf07(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1);
-                f[0] += 2900.0;
+                retval.append("(cf07)");
                 break;
             case 30:
-                cf08(x.data(), f.data(), nx, m_origin_shift.data(), m_rotation_matrix.data(), m_shuffle.data(), 1);
-                f[0] += 3000.0;
+                retval.append("(cf08)");
                 break;
         }
+        return retval;
+    }
 
-        return f;
+    /// Returns the origin shift
+    /**
+     * This method will return the origin shift.
+     *
+     * @return The origin shift.
+     */
+    const vector_double &get_origin_shift() const
+    {
+        return m_data->shift;
     }
 
-    /// Problem name
+    /// Save to archive.
     /**
+     * This method will save the problem id and the dimension of \p this into the archive \p ar
+     * (the problem data is not saved, as it is reloaded on deserialization).
      *
+     * @param ar target archive.
      *
-     * @return a string containing the problem name
+     * @throws unspecified any exception thrown by the serialization of primitive types.
      */
-    std::string get_name() const
+    template <typename Archive>
+    void save(Archive &ar) const
     {
-        std::string retval("CEC2014 - f");
-        retval.append(std::to_string(func_num));
+        ar(func_num, m_dim);
+    }
+
+    /// Load from archive.
+    /**
+     * This method will load a pagmo::cec2014 from the archive \p ar into \p this.
+     *
+     * @param ar source archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types, or by the constructor
+     * of pagmo::cec2014 if the loaded problem id and dimension are invalid.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        unsigned prob_id, dim;
+        ar(prob_id, dim);
+        *this = cec2014(prob_id, dim);
+    }
+
+private:
+    // Evaluate the fitness of x (of size m_dim) into f, using the scratch memory in ws.
+    void evaluate(const double *x, double *f, detail::cec_workspace &ws) const
+    {
+        const auto nx = m_dim;
         switch (func_num) {
             case 1:
-                retval.append("(ellips_func)");
+                ellips_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 100.0;
                 break;
             case 2:
-                retval.append("(bent_cigar_func)");
+                bent_cigar_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 200.0;
                 break;
             case 3:
-                retval.append("(discus_func)");
+                discus_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 300.0;
                 break;
             case 4:
-                retval.append("(rosenbrock_func)");
+                rosenbrock_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 400.0;
                 break;
             case 5:
-                retval.append("(ackley_func)");
+                ackley_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 500.0;
                 break;
             case 6:
-                retval.append("(weierstrass_func)");
+                weierstrass_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 600.0;
                 break;
             case 7:
-                retval.append("(griewank_func)");
+                griewank_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 700.0;
                 break;
             case 8:
-                retval.append("(rastrigin_func_non_rotated)");
+                rastrigin_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 0, ws);
+                f[0] += 800.0;
                 break;
             case 9:
-                retval.append("(rastrigin_func)");
+                rastrigin_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 900.0;
                 break;
             case 10:
-                retval.append("(schwefel_func_non_rotated)");
+                schwefel_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 0, ws);
+                f[0] += 1000.0;
                 break;
             case 11:
-                retval.append("(schwefel_func)");
+                schwefel_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 1100.0;
                 break;
             case 12:
-                retval.append("(katsuura_func)");
+                katsuura_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 1200.0;
                 break;
             case 13:
-                retval.append("(happycat_func)");
+                happycat_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 1300.0;
                 break;
             case 14:
-                retval.append("(hgbat_func)");
+                hgbat_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 1400.0;
                 break;
             case 15:
-                retval.append("(grie_rosen_func)");
+                grie_rosen_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 1500.0;
                 break;
             case 16:
-                retval.append("(escaffer6_func)");
+                escaffer6_func(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, 1, ws);
+                f[0] += 1600.0;
                 break;
             case 17:
-                retval.append("(hf01)");
+                hf01(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, 1, ws);
+                f[0] += 1700.0;
                 break;
             case 18:
-                retval.append("(hf02)");
+                hf02(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, 1, ws);
+                f[0] += 1800.0;
                 break;
             case 19:
-                retval.append("(hf03)");
+                hf03(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, 1, ws);
+                f[0] += 1900.0;
                 break;
             case 20:
-                retval.append("(hf04)");
+                hf04(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, 1, ws);
+                f[0] += 2000.0;
                 break;
             case 21:
-                retval.append("(hf05)");
+                hf05(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, 1, ws);
+                f[0] += 2100.0;
                 break;
             case 22:
-                retval.append("(hf06)");
+                hf06(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, 1, ws);
+                f[0] += 2200.0;
                 break;
             case 23:
-                retval.append("(cf01)");
+                cf01(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 2300.0;
                 break;
             case 24:
-                retval.append("(cf02)");
+                cf02(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 2400.0;
                 break;
             case 25:
-                retval.append("(cf03)");
+                cf03(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 2500.0;
                 break;
             case 26:
-                retval.append("(cf04)");
+                cf04(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 2600.0;
                 break;
             case 27:
-                retval.append("(cf05)");
+                cf05(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 2700.0;
                 break;
             case 28:
-                retval.append("(cf06)");
+                cf06(x, f, nx, m_data->shift.data(), m_data->rotation.data(), 1, ws);
+                f[0] += 2800.0;
                 break;
             case 29:
-                retval.append("(cf07)");
+                cf07(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, ws);
+                f[0] += 2900.0;
                 break;
             case 30:
-                retval.append("(cf08)");
+                cf08(x, f, nx, m_data->shift.data(), m_data->rotation.data(), m_data->shuffle.data(), 1, ws);
+                f[0] += 3000.0;
                 break;
         }
-        return retval;
-    }
 
-    /// Returns the origin shift
-    /**
-     * This method will return the origin shift.
-     *
-     * @return The origin shift.
-     */
-    const vector_double &get_origin_shift() const
-    {
-        return m_origin_shift;
     }
 
-    /// Object serialization
-    /**
-     * This method will save/load \p this into the archive \p ar.
-     *
-     * @param ar target archive.
-     *
-     * @throws unspecified any exception thrown by the serialization of primitive types.
-     */
-    template <typename Archive>
-    void serialize(Archive &ar)
+    // Compute into y the input of the first rotation performed by the evaluation of x (i.e., the output of
+    // the shift and shrink steps of sr_func()). Returns false for the problems whose evaluation does not
+    // start with the shift and rotation of x.
+    bool first_rotation_input(const double *x, double *y) const
     {
-        ar(func_num, m_rotation_matrix, m_origin_shift, m_shuffle, m_y, m_z);
+        double sh_rate;
+        switch (func_num) {
+            case 4:
+                sh_rate = 2.048 / 100.0;
+                break;
+            case 6:
+                sh_rate = 0.5 / 100.0;
+                break;
+            case 7:
+                sh_rate = 600.0 / 100.0;
+                break;
+            case 9:
+                sh_rate = 5.12 / 100.0;
+                break;
+            case 11:
+                sh_rate = 1000.0 / 100.0;
+                break;
+            case 12:
+            case 13:
+            case 14:
+            case 15:
+                sh_rate = 5.0 / 100.0;
+                break;
+            case 8:
+            case 10:
+                return false;
+            default:
+                if (func_num > 22u) {
+                    return false;
+                }
+                sh_rate = 1.0;
+        }
+        shiftfunc(x, y, m_dim, m_data->shift.data());
+        for (unsigned i = 0; i < m_dim; i++) {
+            y[i] = y[i] * sh_rate;
+        }
+        return true;
     }
 
-private:
     // For the coverage analysis we do not cover the code below as its derived from a third party source
     // LCOV_EXCL_START
     /* Sphere */
     void sphere_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                     int r_flag) const
+                     int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         f[0] = 0.0;
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
         for (i = 0; i < nx; i++) {
-            f[0] += m_z[i] * m_z[i];
+            f[0] += ws.z[i] * ws.z[i];
         }
     }
 
     /* Ellipsoidal */
     void ellips_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                     int r_flag) const
+                     int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         f[0] = 0.0;
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
         for (i = 0; i < nx; i++) {
-            f[0] += pow(10.0, 6.0 * i / (nx - 1)) * m_z[i] * m_z[i];
+            f[0] += pow(10.0, 6.0 * i / (nx - 1)) * ws.z[i] * ws.z[i];
         }
     }
 
     /* Bent_Cigar */
     void bent_cigar_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                         int r_flag) const
+                         int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
-        f[0] = m_z[0] * m_z[0];
+        f[0] = ws.z[0] * ws.z[0];
         for (i = 1; i < nx; i++) {
-            f[0] += pow(10.0, 6.0) * m_z[i] * m_z[i];
+            f[0] += pow(10.0, 6.0) * ws.z[i] * ws.z[i];
         }
     }
 
     /* Discus */
     void discus_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                     int r_flag) const
+                     int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
-        f[0] = pow(10.0, 6.0) * m_z[0] * m_z[0];
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
+        f[0] = pow(10.0, 6.0) * ws.z[0] * ws.z[0];
         for (i = 1; i < nx; i++) {
-            f[0] += m_z[i] * m_z[i];
+            f[0] += ws.z[i] * ws.z[i];
         }
     }
 
     /* Different Powers */
     void dif_powers_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                         int r_flag) const
+                         int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         f[0] = 0.0;
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
-            f[0] += pow(fabs(m_z[i]), 2 + 4 * i / (nx - 1));
+            f[0] += pow(fabs(ws.z[i]), 2 + 4 * i / (nx - 1));
         }
         f[0] = pow(f[0], 0.5);
     }
 
     /* Rosenbrock's */
     void rosenbrock_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                         int r_flag) const
+                         int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double tmp1, tmp2;
         f[0] = 0.0;
-        sr_func(x, m_z.data(), nx, Os, Mr, 2.048 / 100.0, s_flag, r_flag); /* shift and rotate */
-        m_z[0] += 1.0;                                                     // shift to orgin
+        sr_func(x, ws.z.data(), nx, Os, Mr, 2.048 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
+        ws.z[0] += 1.0;                                                     // shift to orgin
         for (i = 0; i < nx - 1; i++) {
-            m_z[i + 1] += 1.0; // shift to orgin
-            tmp1 = m_z[i] * m_z[i] - m_z[i + 1];
-            tmp2 = m_z[i] - 1.0;
+            ws.z[i + 1] += 1.0; // shift to orgin
+            tmp1 = ws.z[i] * ws.z[i] - ws.z[i + 1];
+            tmp2 = ws.z[i] - 1.0;
             f[0] += 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
         }
     }
 
     /* Schwefel's 1.2  */
     void schaffer_F7_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                          int r_flag) const
+                          int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double tmp;
         f[0] = 0.0;
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
         for (i = 0; i < nx - 1; i++) {
-            m_z[i] = pow(m_y[i] * m_y[i] + m_y[i + 1] * m_y[i + 1], 0.5);
-            tmp = sin(50.0 * pow(m_z[i], 0.2));
-            f[0] += pow(m_z[i], 0.5) + pow(m_z[i], 0.5) * tmp * tmp;
+            ws.z[i] = pow(ws.y[i] * ws.y[i] + ws.y[i + 1] * ws.y[i + 1], 0.5);
+            tmp = sin(50.0 * pow(ws.z[i], 0.2));
+            f[0] += pow(ws.z[i], 0.5) + pow(ws.z[i], 0.5) * tmp * tmp;
         }
         f[0] = f[0] * f[0] / (nx - 1) / (nx - 1);
     }
 
     /* Ackley's  */
     void ackley_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                     int r_flag) const
+                     int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
@@ -522,11 +634,11 @@ private:
         sum1 = 0.0;
         sum2 = 0.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
-            sum1 += m_z[i] * m_z[i];
-            sum2 += cos(2.0 * PI * m_z[i]);
+            sum1 += ws.z[i] * ws.z[i];
+            sum2 += cos(2.0 * PI * ws.z[i]);
         }
         sum1 = -0.2 * sqrt(sum1 / nx);
         sum2 /= nx;
@@ -535,7 +647,7 @@ private:
 
     /* Weierstrass's  */
     void weierstrass_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                          int r_flag) const
+                          int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i, j, k_max;
@@ -545,13 +657,13 @@ private:
         k_max = 20;
         f[0] = 0.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 0.5 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 0.5 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
             sum = 0.0;
             sum2 = 0.0;
             for (j = 0; j <= k_max; j++) {
-                sum += pow(a, j) * cos(2.0 * PI * pow(b, j) * (m_z[i] + 0.5));
+                sum += pow(a, j) * cos(2.0 * PI * pow(b, j) * (ws.z[i] + 0.5));
                 sum2 += pow(a, j) * cos(2.0 * PI * pow(b, j) * 0.5);
             }
             f[0] += sum;
@@ -561,7 +673,7 @@ private:
 
     /* Griewank's  */
     void griewank_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                       int r_flag) const
+                       int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
@@ -569,78 +681,78 @@ private:
         s = 0.0;
         p = 1.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 600.0 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 600.0 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
-            s += m_z[i] * m_z[i];
-            p *= cos(m_z[i] / sqrt(1.0 + i));
+            s += ws.z[i] * ws.z[i];
+            p *= cos(ws.z[i] / sqrt(1.0 + i));
         }
         f[0] = 1.0 + s / 4000.0 - p;
     }
 
     /* Rastrigin's  */
     void rastrigin_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                        int r_flag) const
+                        int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         f[0] = 0.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 5.12 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 5.12 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
-            f[0] += (m_z[i] * m_z[i] - 10.0 * cos(2.0 * PI * m_z[i]) + 10.0);
+            f[0] += (ws.z[i] * ws.z[i] - 10.0 * cos(2.0 * PI * ws.z[i]) + 10.0);
         }
     }
 
     /* Noncontinuous Rastrigin's  */
     void step_rastrigin_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr,
-                             int s_flag, int r_flag) const
+                             int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         f[0] = 0.0;
         for (i = 0; i < nx; i++) {
-            if (fabs(m_y[i] - Os[i]) > 0.5) m_y[i] = Os[i] + floor(2 * (m_y[i] - Os[i]) + 0.5) / 2;
+            if (fabs(ws.y[i] - Os[i]) > 0.5) ws.y[i] = Os[i] + floor(2 * (ws.y[i] - Os[i]) + 0.5) / 2;
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 5.12 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 5.12 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
-            f[0] += (m_z[i] * m_z[i] - 10.0 * cos(2.0 * PI * m_z[i]) + 10.0);
+            f[0] += (ws.z[i] * ws.z[i] - 10.0 * cos(2.0 * PI * ws.z[i]) + 10.0);
         }
     }
 
     /* Schwefel's  */
     void schwefel_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                       int r_flag) const
+                       int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double tmp;
         f[0] = 0.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1000.0 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1000.0 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
-            m_z[i] += 4.209687462275036e+002;
-            if (m_z[i] > 500) {
-                f[0] -= (500.0 - fmod(m_z[i], 500)) * sin(pow(500.0 - fmod(m_z[i], 500), 0.5));
-                tmp = (m_z[i] - 500.0) / 100;
+            ws.z[i] += 4.209687462275036e+002;
+            if (ws.z[i] > 500) {
+                f[0] -= (500.0 - fmod(ws.z[i], 500)) * sin(pow(500.0 - fmod(ws.z[i], 500), 0.5));
+                tmp = (ws.z[i] - 500.0) / 100;
                 f[0] += tmp * tmp / nx;
-            } else if (m_z[i] < -500) {
-                f[0] -= (-500.0 + fmod(fabs(m_z[i]), 500)) * sin(pow(500.0 - fmod(fabs(m_z[i]), 500), 0.5));
-                tmp = (m_z[i] + 500.0) / 100;
+            } else if (ws.z[i] < -500) {
+                f[0] -= (-500.0 + fmod(fabs(ws.z[i]), 500)) * sin(pow(500.0 - fmod(fabs(ws.z[i]), 500), 0.5));
+                tmp = (ws.z[i] + 500.0) / 100;
                 f[0] += tmp * tmp / nx;
             } else
-                f[0] -= m_z[i] * sin(pow(fabs(m_z[i]), 0.5));
+                f[0] -= ws.z[i] * sin(pow(fabs(ws.z[i]), 0.5));
         }
         f[0] += 4.189828872724338e+002 * nx;
     }
 
     /* Katsuura  */
     void katsuura_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                       int r_flag) const
+                       int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i, j;
@@ -648,13 +760,13 @@ private:
         f[0] = 1.0;
         tmp3 = pow(1.0 * nx, 1.2);
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (i = 0; i < nx; i++) {
             temp = 0.0;
             for (j = 1; j <= 32; j++) {
                 tmp1 = pow(2.0, j);
-                tmp2 = tmp1 * m_z[i];
+                tmp2 = tmp1 * ws.z[i];
                 temp += fabs(tmp2 - floor(tmp2 + 0.5)) / tmp1;
             }
             f[0] *= pow(1.0 + (i + 1) * temp, 10.0 / tmp3);
@@ -665,7 +777,7 @@ private:
 
     /* Lunacek Bi_rastrigin Function */
     void bi_rastrigin_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr,
-                           int s_flag, int r_flag) const
+                           int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
@@ -676,26 +788,26 @@ private:
         mu1 = -pow((mu0 * mu0 - d) / s, 0.5);
 
         if (s_flag == 1) {
-            shiftfunc(x, m_y.data(), nx, Os);
+            shiftfunc(x, ws.y.data(), nx, Os);
         } else {
             // shrink to the orginal search range
             for (i = 0; i < nx; i++) {
-                m_y[i] = x[i];
+                ws.y[i] = x[i];
             }
         }
         // shrink to the orginal search range
         for (i = 0; i < nx; i++) {
-            m_y[i] *= 10.0 / 100.0;
+            ws.y[i] *= 10.0 / 100.0;
         }
 
         for (i = 0; i < nx; i++) {
-            tmpx[i] = 2 * m_y[i];
+            tmpx[i] = 2 * ws.y[i];
             if (Os[i] < 0.0) {
                 tmpx[i] *= -1.;
             }
         }
         for (i = 0; i < nx; i++) {
-            m_z[i] = tmpx[i];
+            ws.z[i] = tmpx[i];
             tmpx[i] += mu0;
         }
         tmp1 = 0.0;
@@ -712,9 +824,9 @@ private:
         tmp = 0.0;
 
         if (r_flag == 1) {
-            rotatefunc(m_z.data(), m_y.data(), nx, Mr);
+            rotatefunc(ws.z.data(), ws.y.data(), nx, Mr, ws);
             for (i = 0; i < nx; i++) {
-                tmp += cos(2.0 * PI * m_y[i]);
+                tmp += cos(2.0 * PI * ws.y[i]);
             }
             if (tmp1 < tmp2) {
                 f[0] = tmp1;
@@ -724,7 +836,7 @@ private:
             f[0] += 10.0 * (nx - tmp);
         } else {
             for (i = 0; i < nx; i++) {
-                tmp += cos(2.0 * PI * m_z[i]);
+                tmp += cos(2.0 * PI * ws.z[i]);
             }
             if (tmp1 < tmp2) {
                 f[0] = tmp1;
@@ -739,70 +851,70 @@ private:
 
     /* Griewank-Rosenbrock  */
     void grie_rosen_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                         int r_flag) const
+                         int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double temp, tmp1, tmp2;
         f[0] = 0.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
-        m_z[0] += 1.0; // shift to orgin
+        ws.z[0] += 1.0; // shift to orgin
         for (i = 0; i < nx - 1; i++) {
-            m_z[i + 1] += 1.0; // shift to orgin
-            tmp1 = m_z[i] * m_z[i] - m_z[i + 1];
-            tmp2 = m_z[i] - 1.0;
+            ws.z[i + 1] += 1.0; // shift to orgin
+            tmp1 = ws.z[i] * ws.z[i] - ws.z[i + 1];
+            tmp2 = ws.z[i] - 1.0;
             temp = 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
             f[0] += (temp * temp) / 4000.0 - cos(temp) + 1.0;
         }
-        tmp1 = m_z[nx - 1] * m_z[nx - 1] - m_z[0];
-        tmp2 = m_z[nx - 1] - 1.0;
+        tmp1 = ws.z[nx - 1] * ws.z[nx - 1] - ws.z[0];
+        tmp2 = ws.z[nx - 1] - 1.0;
         temp = 100.0 * tmp1 * tmp1 + tmp2 * tmp2;
         f[0] += (temp * temp) / 4000.0 - cos(temp) + 1.0;
     }
 
     /* Expanded Scaffer??s F6  */
     void escaffer6_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                        int r_flag) const
+                        int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double temp1, temp2;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         f[0] = 0.0;
         for (i = 0; i < nx - 1; i++) {
-            temp1 = sin(sqrt(m_z[i] * m_z[i] + m_z[i + 1] * m_z[i + 1]));
+            temp1 = sin(sqrt(ws.z[i] * ws.z[i] + ws.z[i + 1] * ws.z[i + 1]));
             temp1 = temp1 * temp1;
-            temp2 = 1.0 + 0.001 * (m_z[i] * m_z[i] + m_z[i + 1] * m_z[i + 1]);
+            temp2 = 1.0 + 0.001 * (ws.z[i] * ws.z[i] + ws.z[i + 1] * ws.z[i + 1]);
             f[0] += 0.5 + (temp1 - 0.5) / (temp2 * temp2);
         }
-        temp1 = sin(sqrt(m_z[nx - 1] * m_z[nx - 1] + m_z[0] * m_z[0]));
+        temp1 = sin(sqrt(ws.z[nx - 1] * ws.z[nx - 1] + ws.z[0] * ws.z[0]));
         temp1 = temp1 * temp1;
-        temp2 = 1.0 + 0.001 * (m_z[nx - 1] * m_z[nx - 1] + m_z[0] * m_z[0]);
+        temp2 = 1.0 + 0.001 * (ws.z[nx - 1] * ws.z[nx - 1] + ws.z[0] * ws.z[0]);
         f[0] += 0.5 + (temp1 - 0.5) / (temp2 * temp2);
     }
 
     /* HappyCat, provdided by Hans-Georg Beyer (HGB) */
     /* original global optimum: [-1,-1,...,-1] */
     void happycat_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                       int r_flag) const
+                       int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double alpha, r2, sum_z;
         alpha = 1.0 / 8.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         r2 = 0.0;
         sum_z = 0.0;
         for (i = 0; i < nx; i++) {
-            m_z[i] = m_z[i] - 1.0; // shift to orgin
-            r2 += m_z[i] * m_z[i];
-            sum_z += m_z[i];
+            ws.z[i] = ws.z[i] - 1.0; // shift to orgin
+            r2 += ws.z[i] * ws.z[i];
+            sum_z += ws.z[i];
         }
 
         f[0] = pow(fabs(r2 - nx), 2 * alpha) + (0.5 * r2 + sum_z) / nx + 0.5;
@@ -811,21 +923,21 @@ private:
     /* HGBat, provdided by Hans-Georg Beyer (HGB)*/
     /* original global optimum: [-1,-1,...,-1] */
     void hgbat_func(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int s_flag,
-                    int r_flag) const
+                    int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         double alpha, r2, sum_z;
         alpha = 1.0 / 4.0;
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 5.0 / 100.0, s_flag, r_flag, ws); /* shift and rotate */
 
         r2 = 0.0;
         sum_z = 0.0;
         for (i = 0; i < nx; i++) {
-            m_z[i] = m_z[i] - 1.0; // shift to orgin
-            r2 += m_z[i] * m_z[i];
-            sum_z += m_z[i];
+            ws.z[i] = ws.z[i] - 1.0; // shift to orgin
+            r2 += ws.z[i] * ws.z[i];
+            sum_z += ws.z[i];
         }
 
         f[0] = pow(fabs(pow(r2, 2.0) - pow(sum_z, 2.0)), 2 * alpha) + (0.5 * r2 + sum_z) / nx + 0.5;
@@ -833,7 +945,7 @@ private:
 
     /* Hybrid Function 1 */
     void hf01(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *S,
-              int s_flag, int r_flag) const
+              int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
         unsigned i, tmp, cf_num = 3;
         double fit[3];
@@ -851,17 +963,17 @@ private:
             G[i] = G[i - 1] + G_nx[i - 1];
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (auto j = 0u; j < nx; j++) {
-            m_y[j] = m_z[static_cast<unsigned>(S[j] - 1)];
+            ws.y[j] = ws.z[static_cast<unsigned>(S[j] - 1)];
         }
         i = 0;
-        schwefel_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        schwefel_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 1;
-        rastrigin_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        rastrigin_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 2;
-        ellips_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        ellips_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         f[0] = 0.0;
         for (i = 0; i < cf_num; i++) {
             f[0] += fit[i];
@@ -870,7 +982,7 @@ private:
 
     /* Hybrid Function 2 */
     void hf02(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *S,
-              int s_flag, int r_flag) const
+              int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
         unsigned i, tmp, cf_num = 3;
         double fit[3];
@@ -889,17 +1001,17 @@ private:
             G[i] = G[i - 1] + G_nx[i - 1];
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (auto j = 0u; j < nx; j++) {
-            m_y[j] = m_z[static_cast<unsigned>(S[j] - 1)];
+            ws.y[j] = ws.z[static_cast<unsigned>(S[j] - 1)];
         }
         i = 0;
-        bent_cigar_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        bent_cigar_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 1;
-        hgbat_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        hgbat_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 2;
-        rastrigin_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        rastrigin_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
 
         f[0] = 0.0;
         for (i = 0; i < cf_num; i++) {
@@ -909,7 +1021,7 @@ private:
 
     /* Hybrid Function 3 */
     void hf03(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *S,
-              int s_flag, int r_flag) const
+              int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i, tmp, cf_num = 4;
@@ -929,19 +1041,19 @@ private:
             G[i] = G[i - 1] + G_nx[i - 1];
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (auto j = 0u; j < nx; j++) {
-            m_y[j] = m_z[static_cast<unsigned>(S[j] - 1)];
+            ws.y[j] = ws.z[static_cast<unsigned>(S[j] - 1)];
         }
         i = 0;
-        griewank_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        griewank_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 1;
-        weierstrass_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        weierstrass_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 2;
-        rosenbrock_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        rosenbrock_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 3;
-        escaffer6_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        escaffer6_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
 
         f[0] = 0.0;
         for (i = 0; i < cf_num; i++) {
@@ -951,7 +1063,7 @@ private:
 
     /* Hybrid Function 4 */
     void hf04(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *S,
-              int s_flag, int r_flag) const
+              int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i, tmp, cf_num = 4;
@@ -971,19 +1083,19 @@ private:
             G[i] = G[i - 1] + G_nx[i - 1];
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (auto j = 0u; j < nx; j++) {
-            m_y[j] = m_z[static_cast<unsigned>(S[j] - 1)];
+            ws.y[j] = ws.z[static_cast<unsigned>(S[j] - 1)];
         }
         i = 0;
-        hgbat_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        hgbat_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 1;
-        discus_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        discus_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 2;
-        grie_rosen_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        grie_rosen_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 3;
-        rastrigin_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        rastrigin_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
 
         f[0] = 0.0;
         for (i = 0; i < cf_num; i++) {
@@ -993,7 +1105,7 @@ private:
 
     /* Hybrid Function 5 */
     void hf05(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *S,
-              int s_flag, int r_flag) const
+              int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i, tmp, cf_num = 5;
@@ -1014,22 +1126,22 @@ private:
             G[i] = G[i - 1] + G_nx[i - 1];
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (auto j = 0u; j < nx; j++) {
-            m_y[j] = m_z[static_cast<unsigned>(S[j] - 1)];
+            ws.y[j] = ws.z[static_cast<unsigned>(S[j] - 1)];
         }
 
         i = 0;
-        escaffer6_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        escaffer6_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 1;
-        hgbat_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        hgbat_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 2;
-        rosenbrock_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        rosenbrock_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 3;
-        schwefel_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        schwefel_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 4;
-        ellips_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        ellips_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
 
         f[0] = 0.0;
         for (i = 0; i < cf_num; i++) {
@@ -1039,7 +1151,7 @@ private:
 
     /* Hybrid Function 6 */
     void hf06(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *S,
-              int s_flag, int r_flag) const
+              int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i, tmp, cf_num = 5;
@@ -1060,22 +1172,22 @@ private:
             G[i] = G[i - 1] + G_nx[i - 1];
         }
 
-        sr_func(x, m_z.data(), nx, Os, Mr, 1.0, s_flag, r_flag); /* shift and rotate */
+        sr_func(x, ws.z.data(), nx, Os, Mr, 1.0, s_flag, r_flag, ws); /* shift and rotate */
 
         for (auto j = 0u; j < nx; j++) {
-            m_y[j] = m_z[static_cast<unsigned>(S[j] - 1)];
+            ws.y[j] = ws.z[static_cast<unsigned>(S[j] - 1)];
         }
 
         i = 0;
-        katsuura_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        katsuura_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 1;
-        happycat_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        happycat_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 2;
-        grie_rosen_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        grie_rosen_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 3;
-        schwefel_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        schwefel_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         i = 4;
-        ackley_func(&m_y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0);
+        ackley_func(&ws.y[G[i]], &fit[i], G_nx[i], Os, Mr, 0, 0, ws);
         f[0] = 0.0;
         for (i = 0; i < cf_num; i++) {
             f[0] += fit[i];
@@ -1083,7 +1195,8 @@ private:
     }
 
     /* Composition Function 1 */
-    void cf01(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag) const
+    void cf01(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag,
+              detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 5;
@@ -1092,25 +1205,26 @@ private:
         double bias[5] = {0, 100, 200, 300, 400};
 
         i = 0;
-        rosenbrock_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        rosenbrock_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+4;
         i = 1;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         i = 2;
-        bent_cigar_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        bent_cigar_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+30;
         i = 3;
-        discus_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        discus_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         i = 4;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, 0);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, 0, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 2 */
-    void cf02(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag) const
+    void cf02(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag,
+              detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 3;
@@ -1119,16 +1233,17 @@ private:
         double bias[3] = {0, 100, 200};
 
         i = 0;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, 0);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, 0, ws);
         i = 1;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         i = 2;
-        hgbat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        hgbat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 3 */
-    void cf03(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag) const
+    void cf03(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag,
+              detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 3;
@@ -1136,19 +1251,20 @@ private:
         double delta[3] = {10, 30, 50};
         double bias[3] = {0, 100, 200};
         i = 0;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 4e+3;
         i = 1;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+3;
         i = 2;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+10;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 4 */
-    void cf04(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag) const
+    void cf04(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag,
+              detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 5;
@@ -1156,25 +1272,26 @@ private:
         double delta[5] = {10, 10, 10, 10, 10};
         double bias[5] = {0, 100, 200, 300, 400};
         i = 0;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 4e+3;
         i = 1;
-        happycat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        happycat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+3;
         i = 2;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 1e+10;
         i = 3;
-        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 400;
         i = 4;
-        griewank_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        griewank_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 1000 * fit[i] / 100;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 4 */
-    void cf05(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag) const
+    void cf05(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag,
+              detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 5;
@@ -1182,25 +1299,26 @@ private:
         double delta[5] = {10, 10, 10, 20, 20};
         double bias[5] = {0, 100, 200, 300, 400};
         i = 0;
-        hgbat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        hgbat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1000;
         i = 1;
-        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        rastrigin_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+3;
         i = 2;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+3;
         i = 3;
-        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        weierstrass_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 400;
         i = 4;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 6 */
-    void cf06(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag) const
+    void cf06(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, int r_flag,
+              detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 5;
@@ -1208,26 +1326,26 @@ private:
         double delta[5] = {10, 20, 30, 40, 50};
         double bias[5] = {0, 100, 200, 300, 400};
         i = 0;
-        grie_rosen_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        grie_rosen_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+3;
         i = 1;
-        happycat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        happycat_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+3;
         i = 2;
-        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        schwefel_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 4e+3;
         i = 3;
-        escaffer6_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        escaffer6_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 2e+7;
         i = 4;
-        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag);
+        ellips_func(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], 1, r_flag, ws);
         fit[i] = 10000 * fit[i] / 1e+10;
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 7 */
     void cf07(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *SS,
-              int r_flag) const
+              int r_flag, detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 3;
@@ -1235,17 +1353,17 @@ private:
         double delta[3] = {10, 30, 50};
         double bias[3] = {0, 100, 200};
         i = 0;
-        hf01(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag);
+        hf01(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag, ws);
         i = 1;
-        hf02(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag);
+        hf02(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag, ws);
         i = 2;
-        hf03(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag);
+        hf03(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag, ws);
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
     /* Composition Function 8 */
     void cf08(const double *x, double *f, const unsigned nx, const double *Os, const double *Mr, const int *SS,
-              int r_flag) const
+              int r_flag, detail::cec_workspace &ws) const
     {
         unsigned i;
         int cf_num = 3;
@@ -1253,11 +1371,11 @@ private:
         double delta[3] = {10, 30, 50};
         double bias[3] = {0, 100, 200};
         i = 0;
-        hf04(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag);
+        hf04(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag, ws);
         i = 1;
-        hf05(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag);
+        hf05(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag, ws);
         i = 2;
-        hf06(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag);
+        hf06(x, &fit[i], nx, &Os[i * nx], &Mr[i * nx * nx], &SS[i * nx], 1, r_flag, ws);
         cf_cal(x, f, nx, Os, delta, bias, fit, cf_num);
     }
 
@@ -1270,8 +1388,13 @@ private:
         }
     }
 
-    void rotatefunc(const double *x, double *xrot, const unsigned nx, const double *Mr) const
+    void rotatefunc(const double *x, double *xrot, const unsigned nx, const double *Mr,
+                    detail::cec_workspace &ws) const
     {
+        // Reuse the rotation precomputed by batch_fitness(), if any.
+        if (ws.use_hint(x, xrot, nx, Mr)) {
+            return;
+        }
         unsigned j;
         unsigned i;
         for (i = 0; i < nx; i++) {
@@ -1285,19 +1408,19 @@ private:
 
     /* shift and rotate */
     void sr_func(const double *x, double *sr_x, const unsigned nx, const double *Os, const double *Mr, double sh_rate,
-                 int s_flag, int r_flag) const
+                 int s_flag, int r_flag, detail::cec_workspace &ws) const
     {
 
         unsigned i;
         if (s_flag == 1) {
             if (r_flag == 1) {
-                shiftfunc(x, m_y.data(), nx, Os);
+                shiftfunc(x, ws.y.data(), nx, Os);
 
                 // shrink to the original search range
                 for (i = 0; i < nx; i++) {
-                    m_y[i] = m_y[i] * sh_rate;
+                    ws.y[i] = ws.y[i] * sh_rate;
                 }
-                rotatefunc(m_y.data(), sr_x, nx, Mr);
+                rotatefunc(ws.y.data(), sr_x, nx, Mr, ws);
             } else {
                 shiftfunc(x, sr_x, nx, Os);
 
@@ -1310,9 +1433,9 @@ private:
             if (r_flag == 1) {
                 // shrink to the original search range
                 for (i = 0; i < nx; i++) {
-                    m_y[i] = x[i] * sh_rate;
+                    ws.y[i] = x[i] * sh_rate;
                 }
-                rotatefunc(m_y.data(), sr_x, nx, Mr);
+                rotatefunc(ws.y.data(), sr_x, nx, Mr, ws);
             } else {
                 // shrink to the original search range
                 for (i = 0; i < nx; i++) {
@@ -1401,14 +1524,12 @@ private:
     }
     // LCOV_EXCL_STOP
 
-    // problem data
-    vector_double m_origin_shift;
-    vector_double m_rotation_matrix;
-    std::vector<int> m_shuffle;
+    // problem data (rotation matrices, shift and shuffle vectors), shared among all the instances with the
+    // same id and dimension
+    std::shared_ptr<const detail::cec_tables> m_data;
 
-    // auxiliary vectors
-    mutable vector_double m_z;
-    mutable vector_double m_y;
+    // problem dimension
+    unsigned m_dim;
 
     // problem id
     unsigned func_num;
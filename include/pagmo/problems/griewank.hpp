@@ -29,12 +29,16 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_PROBLEM_GRIEWANK_HPP
 #define PAGMO_PROBLEM_GRIEWANK_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <pagmo/detail/batch_kernel.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp> // needed for cereal registration macro
 #include <pagmo/types.hpp>
@@ -42,6 +46,35 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+// Batch kernel for the Griewank function (see batch_kernel_fitness()).
+inline void griewank_batch_kernel(const double *tile, vector_double::size_type n, double *out)
+{
+    constexpr auto w = batch_kernel_width;
+    double fr = 4000.;
+    double retval[w] = {}, p[w];
+    std::fill(p, p + w, 1.);
+    for (decltype(n) i = 0u; i < n; i++) {
+        const auto x = tile + i * w;
+        for (std::size_t l = 0; l < w; ++l) {
+            retval[l] += x[l] * x[l];
+        }
+    }
+    for (decltype(n) i = 0u; i < n; i++) {
+        const auto x = tile + i * w;
+        const auto sq = std::sqrt(static_cast<double>(i) + 1.0);
+        for (std::size_t l = 0; l < w; ++l) {
+            p[l] *= std::cos(x[l] / sq);
+        }
+    }
+    for (std::size_t l = 0; l < w; ++l) {
+        out[l] = (retval[l] / fr - p[l] + 1.);
+    }
+}
+} // namespace detail
+
 /// The Griewank problem.
 /**
  *
@@ -96,6 +129,21 @@ struct griewank {
         f[0] = (retval / fr - p + 1.);
         return f;
     }
+    /// Batch fitness computation
+    /**
+     * Computes the fitness of a batch of decision vectors stored contiguously in \p dvs.
+     * The blocked structure-of-arrays evaluation (see also pagmo::rastrigin::batch_fitness()) produces
+     * results bitwise identical to fitness(), i.e., within 0 ULP, unless value-changing floating-point
+     * optimisations are enabled.
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        return detail::batch_kernel_fitness(dvs, m_dim, detail::griewank_batch_kernel);
+    }
     /// Box-bounds
     /**
      *
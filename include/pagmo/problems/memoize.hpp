@@ -0,0 +1,682 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PROBLEM_MEMOIZE_HPP
+#define PAGMO_PROBLEM_MEMOIZE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// The memoize meta-problem.
+/**
+ * This meta-problem wraps an input problem and stores the fitness vectors it computes in a bounded
+ * cache, so that the fitness of a decision vector which was evaluated recently is not computed again.
+ * The cache is a hash table whose entries are evicted in least-recently-used (LRU) order once the
+ * number of entries exceeds the capacity selected upon construction. pagmo::memoize objects are
+ * user-defined problems that can be used in the definition of a pagmo::problem.
+ *
+ * By default, the cache key is the decision vector itself, compared exactly (NaNs are considered equal
+ * to each other). Optionally, a positive quantum \f$ q \f$ can be selected, in which case each component
+ * \f$ x_i \f$ of the decision vector is replaced in the key by \f$ \mathrm{round}\left( x_i / q \right) \f$:
+ * decision vectors whose components fall in the same cells of width \f$ q \f$ will then share the same
+ * fitness, which is the fitness of the first of them that was evaluated.
+ *
+ * The fitness evaluations counted by the outer pagmo::problem include cache hits, while the evaluations
+ * counted by the inner problem (see memoize::get_inner_problem()) are the ones which were actually computed.
+ * Gradients and hessians are not cached, and they are always computed by the inner problem at the exact
+ * decision vector.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    The cache is updated by the const fitness methods without synchronisation: as per the
+ *    :cpp:enumerator:`pagmo::thread_safety::basic` guarantee, distinct instances (e.g., the problem copies
+ *    held by :cpp:class:`pagmo::thread_bfe` or by different islands) can be used concurrently,
+ *    but each copy has its own cache.
+ *
+ * .. note::
+ *
+ *    If the inner problem is stochastic, the cache is cleared whenever a new seed is set.
+ *
+ * \endverbatim
+ */
+class memoize
+{
+    // Enabler for the ctor from UDP or problem. In this case we also allow construction from type problem.
+    // NOTE: memoize itself is excluded so that copies of non-const lvalues are not wrapped again.
+    template <typename T>
+    using ctor_enabler = enable_if_t<
+        std::is_constructible<problem, T &&>::value && !std::is_same<memoize, uncvref_t<T>>::value, int>;
+    // The LRU list stores pointers to the keys in the hash table (which are stable across rehashing),
+    // most recently used first.
+    using lru_list = std::list<const vector_double *>;
+    using cache_map = std::unordered_map<vector_double, std::pair<vector_double, lru_list::iterator>,
+                                         detail::hash_vf<double>, detail::equal_to_vf<double>>;
+
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will initialize a memoized pagmo::null_problem with a capacity of 1000 entries
+     * and exact keys.
+     */
+    memoize() : memoize(null_problem{}) {}
+
+    /// Constructor from problem, capacity and quantum.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is enabled only if ``T`` can be used to construct a :cpp:class:`pagmo::problem`
+     *    and ``T`` is not :cpp:class:`pagmo::memoize`.
+     *
+     * \endverbatim
+     *
+     * Wraps a user-defined problem so that its fitness evaluations will be cached.
+     *
+     * @param p a pagmo::problem or a user-defined problem (UDP).
+     * @param capacity the maximum number of entries in the cache.
+     * @param quantum the width of the cells used to quantise the decision vectors into cache keys
+     * (0 means that decision vectors are used as keys as they are).
+     *
+     * @throws std::invalid_argument if \p capacity is zero, or if \p quantum is negative or not finite.
+     * @throws unspecified any exception thrown by the pagmo::problem constructor.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit memoize(T &&p, std::size_t capacity = 1000u, double quantum = 0.)
+        : m_problem(std::forward<T>(p)), m_capacity(capacity), m_quantum(quantum)
+    {
+        if (!capacity) {
+            pagmo_throw(std::invalid_argument, "The capacity of the cache of a memoized problem must be nonzero");
+        }
+        if (!std::isfinite(quantum) || quantum < 0.) {
+            pagmo_throw(std::invalid_argument,
+                        "The quantum of a memoized problem must be finite and non-negative, but a value of "
+                            + std::to_string(quantum) + " was provided instead");
+        }
+    }
+
+    /// Copy constructor.
+    /**
+     * The cache of \p other, including its LRU order, is deep-copied.
+     *
+     * @param other the memoize object that will be copied.
+     *
+     * @throws unspecified any exception thrown by the copy constructor of pagmo::problem or
+     * by memory errors in standard containers.
+     */
+    memoize(const memoize &other)
+        : m_problem(other.m_problem), m_capacity(other.m_capacity), m_quantum(other.m_quantum), m_hits(other.m_hits),
+          m_misses(other.m_misses)
+    {
+        // Insert starting from the least recently used entry, so that the LRU order is preserved.
+        for (auto it = other.m_lru.rbegin(); it != other.m_lru.rend(); ++it) {
+            insert(**it, other.m_cache.find(**it)->second.first);
+        }
+    }
+
+    /// Move constructor.
+    memoize(memoize &&) = default;
+
+    /// Copy assignment operator.
+    /**
+     * @param other the assignment argument.
+     *
+     * @return a reference to \p this.
+     *
+     * @throws unspecified any exception thrown by the copy constructor.
+     */
+    memoize &operator=(const memoize &other)
+    {
+        if (this != &other) {
+            *this = memoize(other);
+        }
+        return *this;
+    }
+
+    /// Move assignment operator.
+    /**
+     * @return a reference to \p this.
+     */
+    memoize &operator=(memoize &&) = default;
+
+    /// Fitness.
+    /**
+     * If the cache contains the key of \p x, the cached fitness is returned. Otherwise, the fitness computation
+     * is forwarded to the inner problem and the result is stored in the cache, possibly evicting
+     * the least recently used entry.
+     *
+     * @param x the decision vector.
+     *
+     * @return the fitness of \p x.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers,
+     * or by problem::fitness().
+     */
+    vector_double fitness(const vector_double &x) const
+    {
+        if (m_quantum == 0.) {
+            return cached_fitness(x, x);
+        }
+        return cached_fitness(make_key(x), x);
+    }
+
+    /// Batch fitness.
+    /**
+     * The cached fitness vectors are fetched from the cache, while the decision vectors which are not in the
+     * cache are evaluated with a single call to problem::batch_fitness() on the inner problem (so that
+     * an inner problem implementing batch fitness evaluation retains its benefits). Decision vectors
+     * sharing the same key within \p dvs are evaluated only once.
+     *
+     * @param dvs the input decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers,
+     * or by problem::batch_fitness().
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        const auto nx = m_problem.get_nx(), nf = m_problem.get_nf();
+        // NOTE: the size of dvs has been checked by the outer problem.
+        assert(nx && dvs.size() % nx == 0u);
+        const auto n_dvs = dvs.size() / nx;
+        vector_double retval(n_dvs * nf), miss_dvs, x(nx);
+        // For each key which is not in the cache, its position in the batch of misses.
+        std::unordered_map<vector_double, vector_double::size_type, detail::hash_vf<double>,
+                           detail::equal_to_vf<double>>
+            pending;
+        // The indices in dvs of the decision vectors which will be filled in from the batch of misses,
+        // together with their positions in the batch of misses.
+        std::vector<std::pair<vector_double::size_type, vector_double::size_type>> fill;
+        for (decltype(dvs.size()) i = 0; i < n_dvs; ++i) {
+            std::copy(dvs.data() + i * nx, dvs.data() + (i + 1u) * nx, x.begin());
+            auto key = make_key(x);
+            if (const auto f = lookup(key)) {
+                ++m_hits;
+                std::copy(f->begin(), f->end(), retval.data() + i * nf);
+                continue;
+            }
+            const auto p = pending.emplace(std::move(key), pending.size());
+            if (p.second) {
+                miss_dvs.insert(miss_dvs.end(), x.begin(), x.end());
+            } else {
+                ++m_hits;
+            }
+            fill.emplace_back(i, p.first->second);
+        }
+        if (!pending.empty()) {
+            const auto miss_fvs = m_problem.batch_fitness(miss_dvs);
+            m_misses += pending.size();
+            for (const auto &q : fill) {
+                std::copy(miss_fvs.data() + q.second * nf, miss_fvs.data() + (q.second + 1u) * nf,
+                          retval.data() + q.first * nf);
+            }
+            // Insert the new entries in the order in which they appear in dvs, so that the last
+            // ones are the most recently used.
+            std::vector<const vector_double *> keys(pending.size());
+            for (const auto &q : pending) {
+                keys[q.second] = &q.first;
+            }
+            for (decltype(keys.size()) j = 0; j < keys.size(); ++j) {
+                insert(*keys[j], vector_double(miss_fvs.data() + j * nf, miss_fvs.data() + (j + 1u) * nf));
+            }
+        }
+        return retval;
+    }
+
+    /// Box-bounds.
+    /**
+     * @return the box-bounds of the inner problem.
+     *
+     * @throws unspecified any exception thrown by <tt>problem::get_bounds()</tt>.
+     */
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return m_problem.get_bounds();
+    }
+
+    /// Number of objectives.
+    /**
+     * @return the number of objectives of the inner problem.
+     */
+    vector_double::size_type get_nobj() const
+    {
+        return m_problem.get_nobj();
+    }
+
+    /// Equality constraint dimension.
+    /**
+     * @return the number of equality constraints of the inner problem.
+     */
+    vector_double::size_type get_nec() const
+    {
+        return m_problem.get_nec();
+    }
+
+    /// Inequality constraint dimension.
+    /**
+     * @return the number of inequality constraints of the inner problem.
+     */
+    vector_double::size_type get_nic() const
+    {
+        return m_problem.get_nic();
+    }
+
+    /// Integer dimension
+    /**
+     * @return the integer dimension of the inner problem.
+     */
+    vector_double::size_type get_nix() const
+    {
+        return m_problem.get_nix();
+    }
+
+    /// Checks if the inner problem has gradients.
+    /**
+     * @return a flag signalling the availability of the gradient in the inner problem.
+     */
+    bool has_gradient() const
+    {
+        return m_problem.has_gradient();
+    }
+
+    /// Gradients.
+    /**
+     * The gradients computation is forwarded to the inner problem, bypassing the cache.
+     *
+     * @param x the decision vector.
+     *
+     * @return the gradient of the fitness function.
+     *
+     * @throws unspecified any exception thrown by <tt>problem::gradient()</tt>.
+     */
+    vector_double gradient(const vector_double &x) const
+    {
+        return m_problem.gradient(x);
+    }
+
+    /// Checks if the inner problem has gradient sparisty implemented.
+    /**
+     * @return a flag signalling the availability of the gradient sparisty in the inner problem.
+     */
+    bool has_gradient_sparsity() const
+    {
+        return m_problem.has_gradient_sparsity();
+    }
+
+    /// Gradient sparsity.
+    /**
+     * @return the gradient sparsity of the inner problem.
+     */
+    sparsity_pattern gradient_sparsity() const
+    {
+        return m_problem.gradient_sparsity();
+    }
+
+    /// Checks if the inner problem has hessians.
+    /**
+     * @return a flag signalling the availability of the hessians in the inner problem.
+     */
+    bool has_hessians() const
+    {
+        return m_problem.has_hessians();
+    }
+
+    /// Hessians.
+    /**
+     * The hessians computation is forwarded to the inner problem, bypassing the cache.
+     *
+     * @param x the decision vector.
+     *
+     * @return the hessians of the fitness function computed at \p x.
+     *
+     * @throws unspecified any exception thrown by problem::hessians().
+     */
+    std::vector<vector_double> hessians(const vector_double &x) const
+    {
+        return m_problem.hessians(x);
+    }
+
+    /// Checks if the inner problem has hessians sparisty implemented.
+    /**
+     * @return a flag signalling the availability of the hessians sparisty in the inner problem.
+     */
+    bool has_hessians_sparsity() const
+    {
+        return m_problem.has_hessians_sparsity();
+    }
+
+    /// Hessians sparsity.
+    /**
+     * @return the hessians sparsity of the inner problem.
+     */
+    std::vector<sparsity_pattern> hessians_sparsity() const
+    {
+        return m_problem.hessians_sparsity();
+    }
+
+    /// Calls <tt>has_set_seed()</tt> of the inner problem.
+    /**
+     * @return a flag signalling wether the inner problem is stochastic.
+     */
+    bool has_set_seed() const
+    {
+        return m_problem.has_set_seed();
+    }
+
+    /// Calls <tt>set_seed()</tt> of the inner problem.
+    /**
+     * Calls the method <tt>set_seed()</tt> of the inner problem and clears the cache, as the cached
+     * fitness vectors refer to the previous seed.
+     *
+     * @param seed seed to be set.
+     *
+     * @throws unspecified any exception thrown by the method <tt>set_seed()</tt> of the inner problem.
+     */
+    void set_seed(unsigned seed)
+    {
+        m_problem.set_seed(seed);
+        clear_cache();
+    }
+
+    /// Problem name
+    /**
+     * This method will add <tt>[memoized]</tt> to the name provided by the inner problem.
+     *
+     * @return a string containing the problem name.
+     *
+     * @throws unspecified any exception thrown by <tt>problem::get_name()</tt> or memory errors in standard classes.
+     */
+    std::string get_name() const
+    {
+        return m_problem.get_name() + " [memoized]";
+    }
+
+    /// Extra info
+    /**
+     * This method will append a description of the cache to the extra info provided
+     * by the inner problem.
+     *
+     * @return a string containing extra info on the problem.
+     *
+     * @throws unspecified any exception thrown by problem::get_extra_info(), the public interface of
+     * \p std::ostringstream or memory errors in standard classes.
+     */
+    std::string get_extra_info() const
+    {
+        std::ostringstream oss;
+        stream(oss, "\n\tCache capacity: ", m_capacity, "\n\tCache size: ", m_cache.size());
+        if (m_quantum > 0.) {
+            stream(oss, "\n\tKey quantum: ", m_quantum);
+        }
+        stream(oss, "\n\tCache hits: ", m_hits, "\n\tCache misses: ", m_misses);
+        return m_problem.get_extra_info() + oss.str();
+    }
+
+    /// Problem's thread safety level.
+    /**
+     * The thread safety of a meta-problem is defined by the thread safety of the inner pagmo::problem.
+     *
+     * @return the thread safety level of the inner pagmo::problem.
+     */
+    thread_safety get_thread_safety() const
+    {
+        return m_problem.get_thread_safety();
+    }
+
+    /// Get the capacity of the cache.
+    /**
+     * @return the maximum number of entries in the cache.
+     */
+    std::size_t get_capacity() const
+    {
+        return m_capacity;
+    }
+
+    /// Get the quantum.
+    /**
+     * @return the width of the cells used to quantise the cache keys (0 if the keys are exact).
+     */
+    double get_quantum() const
+    {
+        return m_quantum;
+    }
+
+    /// Get the number of entries in the cache.
+    /**
+     * @return the number of fitness vectors currently stored in the cache.
+     */
+    std::size_t get_cache_size() const
+    {
+        return m_cache.size();
+    }
+
+    /// Get the number of cache hits.
+    /**
+     * @return the number of fitness vectors that were fetched from the cache (or shared within a batch)
+     * instead of being computed.
+     */
+    unsigned long long get_hits() const
+    {
+        return m_hits;
+    }
+
+    /// Get the number of cache misses.
+    /**
+     * @return the number of fitness vectors that were computed by the inner problem.
+     */
+    unsigned long long get_misses() const
+    {
+        return m_misses;
+    }
+
+    /// Clear the cache.
+    /**
+     * All the entries of the cache are removed. The hit/miss statistics are preserved.
+     */
+    void clear_cache()
+    {
+        m_cache.clear();
+        m_lru.clear();
+    }
+
+    /// Getter for the inner problem.
+    /**
+     * Returns a const reference to the inner pagmo::problem.
+     *
+     * @return a const reference to the inner pagmo::problem.
+     */
+    const problem &get_inner_problem() const
+    {
+        return m_problem;
+    }
+
+    /// Getter for the inner problem.
+    /**
+     * Returns a reference to the inner pagmo::problem.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The ability to extract a non const reference is provided only in order to allow to call
+     *    non-const methods on the internal :cpp:class:`pagmo::problem` instance. Assigning a new
+     *    :cpp:class:`pagmo::problem` via this reference is undefined behaviour. If the non-const methods
+     *    alter the fitness function, the cache must be cleared via memoize::clear_cache().
+     *
+     * \endverbatim
+     *
+     * @return a reference to the inner pagmo::problem.
+     */
+    problem &get_inner_problem()
+    {
+        return m_problem;
+    }
+
+    /// Save to archive.
+    /**
+     * This method will save \p this, including the content of the cache, into the archive \p ar.
+     *
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the inner problem and of primitive types.
+     */
+    template <typename Archive>
+    void save(Archive &ar) const
+    {
+        std::vector<vector_double> keys, fvs;
+        for (const auto k : m_lru) {
+            keys.push_back(*k);
+            fvs.push_back(m_cache.find(*k)->second.first);
+        }
+        ar(m_problem, m_capacity, m_quantum, m_hits, m_misses, keys, fvs);
+    }
+
+    /// Load from archive.
+    /**
+     * This method will load a pagmo::memoize from the archive \p ar into \p this.
+     *
+     * @param ar source archive.
+     *
+     * @throws std::invalid_argument if the loaded cache is inconsistent.
+     * @throws unspecified any exception thrown by the deserialization of the inner problem and of primitive types.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        memoize tmp;
+        std::vector<vector_double> keys, fvs;
+        ar(tmp.m_problem, tmp.m_capacity, tmp.m_quantum, tmp.m_hits, tmp.m_misses, keys, fvs);
+        if (!tmp.m_capacity || keys.size() != fvs.size() || keys.size() > tmp.m_capacity) {
+            pagmo_throw(std::invalid_argument, "Inconsistent cache detected while deserializing a memoized problem");
+        }
+        for (auto i = keys.size(); i > 0u; --i) {
+            tmp.insert(keys[i - 1u], fvs[i - 1u]);
+        }
+        *this = std::move(tmp);
+    }
+
+private:
+    vector_double cached_fitness(const vector_double &key, const vector_double &x) const
+    {
+        if (const auto f = lookup(key)) {
+            ++m_hits;
+            return *f;
+        }
+        auto retval = m_problem.fitness(x);
+        ++m_misses;
+        insert(key, retval);
+        return retval;
+    }
+    vector_double make_key(const vector_double &x) const
+    {
+        if (m_quantum == 0.) {
+            return x;
+        }
+        vector_double retval(x.size());
+        const auto q = m_quantum;
+        std::transform(x.begin(), x.end(), retval.begin(), [q](double v) { return std::round(v / q); });
+        return retval;
+    }
+    // Look up a key in the cache. On a hit, the entry becomes the most recently used one
+    // and a pointer to its fitness is returned, otherwise nullptr is returned.
+    const vector_double *lookup(const vector_double &key) const
+    {
+        const auto it = m_cache.find(key);
+        if (it == m_cache.end()) {
+            return nullptr;
+        }
+        m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+        return &it->second.first;
+    }
+    // Insert (or replace) an entry as the most recently used one, evicting the
+    // least recently used entries in excess of the capacity.
+    void insert(const vector_double &key, const vector_double &f) const
+    {
+        const auto it = m_cache.find(key);
+        if (it != m_cache.end()) {
+            it->second.first = f;
+            m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+            return;
+        }
+        const auto p = m_cache.emplace(key, std::make_pair(f, lru_list::iterator{}));
+        assert(p.second);
+        try {
+            m_lru.push_front(&p.first->first);
+        } catch (...) {
+            m_cache.erase(p.first);
+            throw;
+        }
+        p.first->second.second = m_lru.begin();
+        while (m_cache.size() > m_capacity) {
+            const auto it_lru = m_cache.find(*m_lru.back());
+            assert(it_lru != m_cache.end());
+            m_lru.pop_back();
+            m_cache.erase(it_lru);
+        }
+    }
+
+    // Inner problem.
+    problem m_problem;
+    // Maximum number of entries in the cache.
+    std::size_t m_capacity;
+    // Width of the quantisation cells for the keys (0 for exact keys).
+    double m_quantum;
+    // The cache and the LRU order of its entries.
+    mutable cache_map m_cache;
+    mutable lru_list m_lru;
+    // Statistics.
+    mutable unsigned long long m_hits = 0;
+    mutable unsigned long long m_misses = 0;
+};
+} // namespace pagmo
+
+PAGMO_REGISTER_PROBLEM(pagmo::memoize)
+
+#endif
@@ -29,12 +29,14 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_PROBLEM_RASTRIGIN_HPP
 #define PAGMO_PROBLEM_RASTRIGIN_HPP
 
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <pagmo/detail/batch_kernel.hpp>
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
@@ -44,6 +46,38 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+// The Rastrigin function of the n-dimensional vector starting at x.
+inline double rastrigin_fitness(const double *x, vector_double::size_type n)
+{
+    const auto omega = 2. * pagmo::detail::pi();
+    double retval = 0.;
+    for (decltype(n) i = 0u; i < n; ++i) {
+        retval += x[i] * x[i] - 10. * std::cos(omega * x[i]);
+    }
+    return retval + 10. * static_cast<double>(n);
+}
+
+// Batch kernel for the Rastrigin function (see batch_kernel_fitness()).
+inline void rastrigin_batch_kernel(const double *tile, vector_double::size_type n, double *out)
+{
+    constexpr auto w = batch_kernel_width;
+    const auto omega = 2. * pagmo::detail::pi();
+    double retval[w] = {};
+    for (decltype(n) i = 0u; i < n; ++i) {
+        const auto x = tile + i * w;
+        for (std::size_t l = 0; l < w; ++l) {
+            retval[l] += x[l] * x[l] - 10. * std::cos(omega * x[l]);
+        }
+    }
+    for (std::size_t l = 0; l < w; ++l) {
+        out[l] = retval[l] + 10. * static_cast<double>(n);
+    }
+}
+} // namespace detail
+
 /// The Rastrigin problem.
 /**
  *
@@ -92,14 +126,33 @@ struct rastrigin {
      */
     vector_double fitness(const vector_double &x) const
     {
-        vector_double f(1, 0.);
-        const auto omega = 2. * pagmo::detail::pi();
-        auto n = x.size();
-        for (decltype(n) i = 0u; i < n; ++i) {
-            f[0] += x[i] * x[i] - 10. * std::cos(omega * x[i]);
-        }
-        f[0] += 10. * static_cast<double>(n);
-        return f;
+        return {detail::rastrigin_fitness(x.data(), x.size())};
+    }
+    /// Fitness computation (raw version)
+    /**
+     * Computes the fitness for this UDP, writing it into a caller-owned buffer.
+     *
+     * @param x a pointer to the decision vector (of size equal to the problem dimension).
+     * @param f a pointer to the output fitness (of size 1).
+     */
+    void fitness(const double *x, double *f) const
+    {
+        f[0] = detail::rastrigin_fitness(x, m_dim);
+    }
+    /// Batch fitness computation
+    /**
+     * Computes the fitness of a batch of decision vectors, stored contiguously in \p dvs,
+     * processing them in blocks in a structure-of-arrays layout that can be vectorized by the compiler.
+     * The result is bitwise identical to the one of fitness() (i.e., the error bound is 0 ULP), unless
+     * value-changing floating-point optimisations are enabled.
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        return detail::batch_kernel_fitness(dvs, m_dim, detail::rastrigin_batch_kernel);
     }
 
     /// Box-bounds
@@ -28,12 +28,15 @@ see https://www.gnu.org/licenses/. */
 
 #ifndef PAGMO_PROBLEM_SCHWEFEL_HPP
 #define PAGMO_PROBLEM_SCHWEFEL_HPP
+#include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <pagmo/detail/batch_kernel.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp> // needed for cereal registration macro
 #include <pagmo/types.hpp>
@@ -41,6 +44,26 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+// Batch kernel for the Schwefel function (see batch_kernel_fitness()).
+inline void schwefel_batch_kernel(const double *tile, vector_double::size_type n, double *out)
+{
+    constexpr auto w = batch_kernel_width;
+    double f[w] = {};
+    for (decltype(n) i = 0u; i < n; i++) {
+        const auto x = tile + i * w;
+        for (std::size_t l = 0; l < w; ++l) {
+            f[l] += x[l] * std::sin(std::sqrt(std::abs(x[l])));
+        }
+    }
+    for (std::size_t l = 0; l < w; ++l) {
+        out[l] = 418.9828872724338 * static_cast<double>(n) - f[l];
+    }
+}
+} // namespace detail
+
 /// The Schwefel problem.
 /**
  * \image html schwefel.png "Two-dimensional Schwefel function." width=3cm
@@ -87,6 +110,21 @@ struct schwefel {
         f[0] = 418.9828872724338 * static_cast<double>(n) - f[0];
         return f;
     }
+    /// Batch fitness computation
+    /**
+     * Computes the fitness of a batch of decision vectors stored contiguously in \p dvs.
+     * The blocked structure-of-arrays evaluation (see also pagmo::rastrigin::batch_fitness()) produces
+     * results bitwise identical to fitness(), i.e., within 0 ULP, unless value-changing floating-point
+     * optimisations are enabled.
+     *
+     * @param dvs the decision vectors.
+     *
+     * @return the fitness vectors of \p dvs.
+     */
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        return detail::batch_kernel_fitness(dvs, m_dim, detail::schwefel_batch_kernel);
+    }
     /// Box-bounds
     /**
      *
@@ -0,0 +1,195 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_R_POLICIES_FAIR_REPLACE_HPP
+#define PAGMO_R_POLICIES_FAIR_REPLACE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/detail/migration_utils.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+namespace pagmo
+{
+
+/// Fair replacement policy.
+/**
+ * This user-defined replacement policy (UDRP) will replace individuals of a population with
+ * immigrants only if the immigrants are better than the individuals being replaced. The maximum
+ * number of individuals that can be replaced can be specified either as an absolute number
+ * or as a fraction of the population size.
+ *
+ * The replacement is performed by merging the population with the best immigrants, ranking the merged
+ * set and keeping its best individuals: the population slots of the discarded individuals are then overwritten
+ * by the surviving immigrants. In single-objective problems the ranking is established via
+ * pagmo::sort_population_con() (which reduces to a plain fitness comparison in the unconstrained case), in
+ * unconstrained multi-objective problems via pagmo::select_best_N_mo(). Constrained multi-objective problems
+ * are not supported.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    The IDs of the replaced individuals are preserved.
+ *
+ * \endverbatim
+ */
+class fair_replace
+{
+    template <typename T>
+    using ctor_enabler = enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>;
+
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will allow at most one individual to be replaced.
+     */
+    fair_replace() : fair_replace(1) {}
+    /// Constructor from a migration rate.
+    /**
+     * If \p x is an integral value, it will be interpreted as the maximum number of individuals to replace.
+     * If \p x is a floating-point value, it will be interpreted as the maximum fraction of the population to replace.
+     *
+     * @param x the migration rate.
+     *
+     * @throws std::invalid_argument if \p x is a negative integral value, or a floating-point value outside
+     * the \f$\left[0,1\right]\f$ range.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit fair_replace(T x) : m_rate(x)
+    {
+    }
+    /// Replace individuals.
+    /**
+     * @param pop the population whose individuals will be replaced.
+     * @param inds the immigrants.
+     *
+     * @throws std::invalid_argument if the problem of \p pop is a constrained multi-objective problem.
+     * @throws unspecified any exception thrown by pagmo::sort_population_con(), pagmo::select_best_N_mo()
+     * or pagmo::population::set_xf().
+     */
+    void replace(population &pop, const individuals_group_t &inds) const
+    {
+        const auto pop_size = pop.size();
+        const auto n_migr = std::min(m_rate.get(pop_size), std::get<0>(inds).size());
+        if (!n_migr) {
+            return;
+        }
+        const auto &prob = pop.get_problem();
+        const auto &imm_f = std::get<2>(inds);
+        if (prob.get_nobj() > 1u && prob.get_nc()) {
+            pagmo_throw(std::invalid_argument, "The 'Fair replace' replacement policy does not support constrained "
+                                               "multi-objective problems");
+        }
+        // Determine the best n_migr immigrants.
+        std::vector<vector_double::size_type> imm_idx;
+        if (prob.get_nobj() == 1u) {
+            imm_idx = sort_population_con(imm_f, prob.get_nec(), prob.get_c_tol());
+            imm_idx.resize(n_migr);
+        } else {
+            imm_idx = select_best_N_mo(imm_f, n_migr);
+        }
+        // Merge them with the population (population first, immigrants last).
+        auto merged_f = pop.get_f();
+        merged_f.reserve(pop_size + n_migr);
+        for (auto i : imm_idx) {
+            merged_f.push_back(imm_f[i]);
+        }
+        // Rank the merged set and keep the best pop_size individuals.
+        std::vector<vector_double::size_type> survivors;
+        if (prob.get_nobj() == 1u) {
+            survivors = sort_population_con(merged_f, prob.get_nec(), prob.get_c_tol());
+            survivors.resize(pop_size);
+        } else {
+            survivors = select_best_N_mo(merged_f, pop_size);
+        }
+        std::vector<char> keep(merged_f.size(), 0);
+        for (auto i : survivors) {
+            keep[i] = 1;
+        }
+        // Pair the discarded population slots with the surviving immigrants. The two
+        // counts are necessarily equal, as exactly pop_size individuals survive.
+        vector_double::size_type slot = 0;
+        for (auto j = pop_size; j < merged_f.size(); ++j) {
+            if (!keep[j]) {
+                continue;
+            }
+            while (keep[slot]) {
+                ++slot;
+            }
+            const auto i = imm_idx[j - pop_size];
+            pop.set_xf(slot++, std::get<1>(inds)[i], imm_f[i]);
+        }
+    }
+    /// Name of the policy.
+    /**
+     * @return <tt>"Fair replace"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Fair replace";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the migration rate.
+     */
+    std::string get_extra_info() const
+    {
+        return m_rate.get_extra_info();
+    }
+    /// Object serialization
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_rate);
+    }
+
+private:
+    detail::migr_rate m_rate;
+};
+
+} // namespace pagmo
+
+#endif
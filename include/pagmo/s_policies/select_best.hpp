@@ -0,0 +1,162 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_S_POLICIES_SELECT_BEST_HPP
+#define PAGMO_S_POLICIES_SELECT_BEST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/detail/migration_utils.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/constrained.hpp>
+#include <pagmo/utils/multi_objective.hpp>
+
+namespace pagmo
+{
+
+/// Select best selection policy.
+/**
+ * This user-defined selection policy (UDSP) selects, as emigrants, the best individuals of a population.
+ * The number of selected individuals can be specified either as an absolute number or as a fraction
+ * of the population size.
+ *
+ * In single-objective problems, the individuals are ranked according to their fitness
+ * (taking into account the constraints via pagmo::sort_population_con(), if present).
+ * In unconstrained multi-objective problems, the individuals are ranked via
+ * pagmo::select_best_N_mo(). Constrained multi-objective problems are not supported.
+ */
+class select_best
+{
+    template <typename T>
+    using ctor_enabler = enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>;
+
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will select a single individual.
+     */
+    select_best() : select_best(1) {}
+    /// Constructor from a migration rate.
+    /**
+     * If \p x is an integral value, it will be interpreted as the absolute number of individuals to select.
+     * If \p x is a floating-point value, it will be interpreted as the fraction of the population to select.
+     *
+     * @param x the migration rate.
+     *
+     * @throws std::invalid_argument if \p x is a negative integral value, or a floating-point value outside
+     * the \f$\left[0,1\right]\f$ range.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit select_best(T x) : m_rate(x)
+    {
+    }
+    /// Select individuals.
+    /**
+     * @param pop the population from which the individuals will be selected.
+     *
+     * @return the best individuals of \p pop, sorted from best to worst.
+     *
+     * @throws std::invalid_argument if the problem of \p pop is a constrained multi-objective problem.
+     * @throws unspecified any exception thrown by pagmo::sort_population_con() or pagmo::select_best_N_mo().
+     */
+    individuals_group_t select(const population &pop) const
+    {
+        const auto n = m_rate.get(pop.size());
+        if (!n) {
+            return individuals_group_t{};
+        }
+        const auto &prob = pop.get_problem();
+        const auto &f = pop.get_f();
+        std::vector<vector_double::size_type> idx;
+        if (prob.get_nobj() == 1u) {
+            if (prob.get_nc()) {
+                idx = sort_population_con(f, prob.get_nec(), prob.get_c_tol());
+            } else {
+                idx.resize(f.size());
+                std::iota(idx.begin(), idx.end(), vector_double::size_type(0));
+                std::partial_sort(idx.begin(), idx.begin() + static_cast<std::ptrdiff_t>(n), idx.end(),
+                                  [&f](vector_double::size_type a, vector_double::size_type b) {
+                                      return detail::less_than_f(f[a][0], f[b][0]);
+                                  });
+            }
+            idx.resize(n);
+        } else {
+            if (prob.get_nc()) {
+                pagmo_throw(std::invalid_argument, "The 'Select best' selection policy does not support constrained "
+                                                   "multi-objective problems");
+            }
+            idx = select_best_N_mo(f, n);
+        }
+        return detail::extract_individuals(pop, idx);
+    }
+    /// Name of the policy.
+    /**
+     * @return <tt>"Select best"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Select best";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the migration rate.
+     */
+    std::string get_extra_info() const
+    {
+        return m_rate.get_extra_info();
+    }
+    /// Object serialization
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_rate);
+    }
+
+private:
+    detail::migr_rate m_rate;
+};
+
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,459 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_S_POLICY_HPP
+#define PAGMO_S_POLICY_HPP
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <pagmo/detail/make_unique.hpp>
+#include <pagmo/detail/migration_utils.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/s_policies/select_best.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+
+/// Macro for the registration of the serialization functionality for user-defined selection policies.
+/**
+ * This macro should always be invoked after the declaration of a user-defined selection policy: it will register
+ * the policy with pagmo's serialization machinery. The macro should be called in the root namespace
+ * and using the fully qualified name of the policy to be registered. For example:
+ * @code{.unparsed}
+ * namespace my_namespace
+ * {
+ *
+ * class my_s_policy
+ * {
+ *    // ...
+ * };
+ *
+ * }
+ *
+ * PAGMO_REGISTER_S_POLICY(my_namespace::my_s_policy)
+ * @endcode
+ */
+#define PAGMO_REGISTER_S_POLICY(s) CEREAL_REGISTER_TYPE_WITH_NAME(pagmo::detail::s_pol_inner<s>, "udsp " #s)
+
+namespace pagmo
+{
+
+/// Detect \p select() method.
+/**
+ * This type trait will be \p true if \p T provides a method with
+ * the following signature:
+ * @code{.unparsed}
+ * individuals_group_t select(const population &) const;
+ * @endcode
+ * The \p select() method is part of the interface for the definition of a selection policy
+ * (see pagmo::s_policy).
+ */
+template <typename T>
+class has_select
+{
+    template <typename U>
+    using select_t = decltype(std::declval<const U &>().select(std::declval<const population &>()));
+    static const bool implementation_defined = std::is_same<individuals_group_t, detected_t<select_t, T>>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool has_select<T>::value;
+
+/// Detect user-defined selection policies (UDSP).
+/**
+ * This type trait will be \p true if \p T is not cv/reference qualified, it is destructible, default, copy and move
+ * constructible, and if it satisfies the pagmo::has_select type trait.
+ *
+ * Types satisfying this type trait can be used as user-defined selection policies (UDSP) in pagmo::s_policy.
+ */
+template <typename T>
+class is_udsp
+{
+    static const bool implementation_defined
+        = std::is_same<T, uncvref_t<T>>::value && std::is_default_constructible<T>::value
+          && std::is_copy_constructible<T>::value && std::is_move_constructible<T>::value
+          && std::is_destructible<T>::value && has_select<T>::value;
+
+public:
+    /// Value of the type trait.
+    static const bool value = implementation_defined;
+};
+
+template <typename T>
+const bool is_udsp<T>::value;
+
+namespace detail
+{
+
+struct s_pol_inner_base {
+    virtual ~s_pol_inner_base() {}
+    virtual std::unique_ptr<s_pol_inner_base> clone() const = 0;
+    virtual individuals_group_t select(const population &) const = 0;
+    virtual std::string get_name() const = 0;
+    virtual std::string get_extra_info() const = 0;
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+template <typename T>
+struct s_pol_inner final : s_pol_inner_base {
+    // We just need the def ctor, delete everything else.
+    s_pol_inner() = default;
+    s_pol_inner(const s_pol_inner &) = delete;
+    s_pol_inner(s_pol_inner &&) = delete;
+    s_pol_inner &operator=(const s_pol_inner &) = delete;
+    s_pol_inner &operator=(s_pol_inner &&) = delete;
+    // Constructors from T (copy and move variants).
+    explicit s_pol_inner(const T &x) : m_value(x) {}
+    explicit s_pol_inner(T &&x) : m_value(std::move(x)) {}
+    // The clone method, used in the copy constructor of s_policy.
+    virtual std::unique_ptr<s_pol_inner_base> clone() const override final
+    {
+        return make_unique<s_pol_inner>(m_value);
+    }
+    // Mandatory methods.
+    virtual individuals_group_t select(const population &pop) const override final
+    {
+        return m_value.select(pop);
+    }
+    // Optional methods.
+    virtual std::string get_name() const override final
+    {
+        return get_name_impl(m_value);
+    }
+    virtual std::string get_extra_info() const override final
+    {
+        return get_extra_info_impl(m_value);
+    }
+    template <typename U, enable_if_t<has_name<U>::value, int> = 0>
+    static std::string get_name_impl(const U &value)
+    {
+        return value.get_name();
+    }
+    template <typename U, enable_if_t<!has_name<U>::value, int> = 0>
+    static std::string get_name_impl(const U &)
+    {
+        return typeid(U).name();
+    }
+    template <typename U, enable_if_t<has_extra_info<U>::value, int> = 0>
+    static std::string get_extra_info_impl(const U &value)
+    {
+        return value.get_extra_info();
+    }
+    template <typename U, enable_if_t<!has_extra_info<U>::value, int> = 0>
+    static std::string get_extra_info_impl(const U &)
+    {
+        return "";
+    }
+    // Serialization
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(cereal::base_class<s_pol_inner_base>(this), m_value);
+    }
+    T m_value;
+};
+
+} // namespace detail
+
+/// Selection policy.
+/**
+ * This class represents a selection policy, that is, the strategy used by a pagmo::island to select, from its
+ * population, the individuals that will be offered as emigrants to the other islands of a pagmo::archipelago.
+ *
+ * In order to define a selection policy, the user must first define a class (or a struct) whose methods
+ * describe the policy. We refer to such a class as a **user-defined selection policy**, or UDSP for short.
+ * Every UDSP must implement at least the following method:
+ * @code{.unparsed}
+ * individuals_group_t select(const population &) const;
+ * @endcode
+ *
+ * The <tt>%select()</tt> method takes as input a population and it returns a group of individuals
+ * (see pagmo::individuals_group_t). In addition to providing the above method, a UDSP must also be default,
+ * copy and move constructible.
+ *
+ * Additional optional methods can be implemented in a UDSP:
+ * @code{.unparsed}
+ * std::string get_name() const;
+ * std::string get_extra_info() const;
+ * @endcode
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    A moved-from :cpp:class:`pagmo::s_policy` is destructible and assignable. Any other operation will result
+ *    in undefined behaviour.
+ *
+ * \endverbatim
+ */
+class s_policy
+{
+    // Enable the generic ctor only if T is not an s_policy (after removing
+    // const/reference qualifiers), and if T is a udsp.
+    template <typename T>
+    using generic_ctor_enabler
+        = enable_if_t<!std::is_same<s_policy, uncvref_t<T>>::value && is_udsp<uncvref_t<T>>::value, int>;
+
+public:
+    /// Default constructor.
+    /**
+     * The default constructor will initialize a pagmo::s_policy containing a pagmo::select_best
+     * constructed with default arguments.
+     *
+     * @throws unspecified any exception thrown by the constructor from UDSP.
+     */
+    s_policy() : s_policy(select_best{}) {}
+    /// Constructor from a user-defined selection policy of type \p T
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is not enabled if, after the removal of cv and reference qualifiers,
+     *    ``T`` is of type :cpp:class:`pagmo::s_policy` (that is, this constructor does not compete with the copy/move
+     *    constructors of :cpp:class:`pagmo::s_policy`), or if ``T`` does not satisfy :cpp:class:`pagmo::is_udsp`.
+     *
+     * \endverbatim
+     *
+     * @param x the UDSP.
+     *
+     * @throws unspecified any exception thrown by methods of the UDSP invoked during construction or by memory errors
+     * in strings and standard containers.
+     */
+    template <typename T, generic_ctor_enabler<T> = 0>
+    explicit s_policy(T &&x) : m_ptr(detail::make_unique<detail::s_pol_inner<uncvref_t<T>>>(std::forward<T>(x)))
+    {
+        m_name = ptr()->get_name();
+    }
+    /// Copy constructor
+    /**
+     * The copy constructor will deep copy the input policy \p other.
+     *
+     * @param other the policy to be copied.
+     *
+     * @throws unspecified any exception thrown by:
+     * - memory allocation errors in standard containers,
+     * - the copying of the internal UDSP.
+     */
+    s_policy(const s_policy &other) : m_ptr(other.m_ptr->clone()), m_name(other.m_name) {}
+    /// Move constructor
+    /**
+     * @param other the policy from which \p this will be move-constructed.
+     */
+    s_policy(s_policy &&other) noexcept : m_ptr(std::move(other.m_ptr)), m_name(std::move(other.m_name)) {}
+    /// Move assignment operator
+    /**
+     * @param other the assignment target.
+     *
+     * @return a reference to \p this.
+     */
+    s_policy &operator=(s_policy &&other) noexcept
+    {
+        if (this != &other) {
+            m_ptr = std::move(other.m_ptr);
+            m_name = std::move(other.m_name);
+        }
+        return *this;
+    }
+    /// Copy assignment operator
+    /**
+     * Copy assignment is implemented as a copy constructor followed by a move assignment.
+     *
+     * @param other the assignment target.
+     *
+     * @return a reference to \p this.
+     *
+     * @throws unspecified any exception thrown by the copy constructor.
+     */
+    s_policy &operator=(const s_policy &other)
+    {
+        // Copy ctor + move assignment.
+        return *this = s_policy(other);
+    }
+    /// Extract a const pointer to the UDSP.
+    /**
+     * @return a const pointer to the internal UDSP, or \p nullptr
+     * if \p T does not correspond exactly to the original UDSP type used
+     * in the constructor.
+     */
+    template <typename T>
+    const T *extract() const
+    {
+        auto p = dynamic_cast<const detail::s_pol_inner<T> *>(ptr());
+        return p == nullptr ? nullptr : &(p->m_value);
+    }
+    /// Extract a pointer to the UDSP.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The ability to extract a mutable pointer is provided only in order to allow to call non-const
+     *    methods on the internal UDSP instance. Assigning a new UDSP via this pointer is undefined behaviour.
+     *
+     * \endverbatim
+     *
+     * @return a pointer to the internal UDSP, or \p nullptr
+     * if \p T does not correspond exactly to the original UDSP type used
+     * in the constructor.
+     */
+    template <typename T>
+    T *extract()
+    {
+        auto p = dynamic_cast<detail::s_pol_inner<T> *>(ptr());
+        return p == nullptr ? nullptr : &(p->m_value);
+    }
+    /// Checks the user-defined selection policy type at run-time.
+    /**
+     * @return \p true if the user-defined selection policy is \p T, \p false otherwise.
+     */
+    template <typename T>
+    bool is() const
+    {
+        return extract<T>() != nullptr;
+    }
+    /// Select individuals.
+    /**
+     * This method will invoke the <tt>%select()</tt> method of the UDSP, and it will check its output.
+     *
+     * @param pop the population from which the individuals will be selected.
+     *
+     * @return the selected individuals.
+     *
+     * @throws std::invalid_argument if the group of individuals returned by the UDSP is inconsistent, or
+     * incompatible with the problem of \p pop.
+     * @throws unspecified any exception thrown by the <tt>%select()</tt> method of the UDSP.
+     */
+    individuals_group_t select(const population &pop) const
+    {
+        auto retval = ptr()->select(pop);
+        detail::check_individuals_group(retval, pop.get_problem(),
+                                        "in the output of the '" + get_name() + "' selection policy");
+        return retval;
+    }
+    /// Selection policy's name.
+    /**
+     * If the UDSP satisfies pagmo::has_name, then this method will return the output of its <tt>%get_name()</tt>
+     * method. Otherwise, an implementation-defined name based on the type of the UDSP will be returned.
+     *
+     * @return the policy's name.
+     */
+    std::string get_name() const
+    {
+        return m_name;
+    }
+    /// Selection policy's extra info.
+    /**
+     * If the UDSP satisfies pagmo::has_extra_info, then this method will return the output of its
+     * <tt>%get_extra_info()</tt> method. Otherwise, an empty string will be returned.
+     *
+     * @return extra info about the UDSP.
+     *
+     * @throws unspecified any exception thrown by the <tt>%get_extra_info()</tt> method of the UDSP.
+     */
+    std::string get_extra_info() const
+    {
+        return ptr()->get_extra_info();
+    }
+    /// Streaming operator
+    /**
+     * @param os input <tt>std::ostream</tt>.
+     * @param s pagmo::s_policy object to be streamed.
+     *
+     * @return a reference to \p os.
+     *
+     * @throws unspecified any exception thrown by querying various policy properties and streaming them into \p os.
+     */
+    friend std::ostream &operator<<(std::ostream &os, const s_policy &s)
+    {
+        os << "Selection policy name: " << s.get_name();
+        const auto extra_str = s.get_extra_info();
+        if (!extra_str.empty()) {
+            stream(os, "\n\nExtra info:\n", extra_str);
+        }
+        return os;
+    }
+    /// Save to archive.
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of the UDSP and of primitive types.
+     */
+    template <typename Archive>
+    void save(Archive &ar) const
+    {
+        ar(m_ptr, m_name);
+    }
+    /// Load from archive.
+    /**
+     * @param ar source archive.
+     *
+     * @throws unspecified any exception thrown by the deserialization of the UDSP and of primitive types.
+     */
+    template <typename Archive>
+    void load(Archive &ar)
+    {
+        s_policy tmp;
+        ar(tmp.m_ptr, tmp.m_name);
+        *this = std::move(tmp);
+    }
+
+private:
+    // Two small helpers to make sure that whenever we require
+    // access to the pointer it actually points to something.
+    detail::s_pol_inner_base const *ptr() const
+    {
+        assert(m_ptr.get() != nullptr);
+        return m_ptr.get();
+    }
+    detail::s_pol_inner_base *ptr()
+    {
+        assert(m_ptr.get() != nullptr);
+        return m_ptr.get();
+    }
+
+private:
+    std::unique_ptr<detail::s_pol_inner_base> m_ptr;
+    std::string m_name;
+};
+} // namespace pagmo
+
+PAGMO_REGISTER_S_POLICY(pagmo::select_best)
+
+#endif
@@ -0,0 +1,104 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_STOP_TOKEN_HPP
+#define PAGMO_STOP_TOKEN_HPP
+
+#include <atomic>
+#include <chrono>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+// The cancellation state of an evolution. A stop is requested when the counter pointed to
+// by gen no longer holds the value it had when the evolution was started, or when the
+// deadline has passed.
+struct stop_token {
+    using clock_t = std::chrono::steady_clock;
+    const std::atomic<unsigned long long> *gen = nullptr;
+    unsigned long long expected = 0;
+    clock_t::time_point deadline = clock_t::time_point::max();
+    bool stop_requested() const
+    {
+        return (gen && gen->load(std::memory_order_relaxed) != expected)
+               || (deadline != clock_t::time_point::max() && clock_t::now() >= deadline);
+    }
+};
+
+// The token of the evolution running in the calling thread, if any.
+inline const stop_token *&current_stop_token()
+{
+    static thread_local const stop_token *t = nullptr;
+    return t;
+}
+
+// RAII helper to install a token as the current one for the calling thread. The
+// previous token is restored on destruction, so that evolutions nested in the
+// same thread (e.g., when a worker of the thread pool runs other tasks while waiting)
+// see the right token.
+struct stop_token_setter {
+    explicit stop_token_setter(const stop_token &t) : m_prev(current_stop_token())
+    {
+        current_stop_token() = &t;
+    }
+    stop_token_setter(const stop_token_setter &) = delete;
+    stop_token_setter &operator=(const stop_token_setter &) = delete;
+    ~stop_token_setter()
+    {
+        current_stop_token() = m_prev;
+    }
+    const stop_token *m_prev;
+};
+
+} // namespace detail
+
+/// Check if the running evolution should stop.
+/**
+ * Evolutions started via pagmo::island and pagmo::archipelago can be stopped cooperatively, either explicitly
+ * (see island::cancel() and archipelago::cancel()) or because a deadline has passed (see island::evolve_for() and
+ * archipelago::evolve_for()). Algorithms can call this function, e.g., at the beginning of each generation, and
+ * return the best population found so far if it returns \p true. The check is cheap (an atomic load and,
+ * if a deadline was set, a read of the steady clock).
+ *
+ * If the calling thread is not running an evolution on behalf of an island (e.g., if
+ * algorithm::evolve() is invoked directly), this function returns \p false.
+ *
+ * @return \p true if a stop of the evolution running in the calling thread was requested, \p false otherwise.
+ */
+inline bool stop_requested()
+{
+    const auto t = detail::current_stop_token();
+    return t && t->stop_requested();
+}
+
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,178 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_TOPOLOGIES_FREE_FORM_HPP
+#define PAGMO_TOPOLOGIES_FREE_FORM_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/topology.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Free-form topology.
+/**
+ * This user-defined topology (UDT) represents a user-defined directed graph, whose edges are added explicitly
+ * via free_form::add_edge(). Edges may refer to vertices which have not been added yet: such edges become
+ * active as soon as both their endpoints have been added via free_form::push_back(). This makes it possible
+ * to describe the graph before passing it to archipelago::set_topology(), which adds one vertex per island.
+ */
+class free_form
+{
+public:
+    /// Constructor.
+    /**
+     * @param n the initial number of (disconnected) vertices.
+     */
+    explicit free_form(std::size_t n = 0) : m_num_vertices(n) {}
+    /// Get the list of connections.
+    /**
+     * @param i the index of a vertex.
+     *
+     * @return the sources of the active edges pointing to \p i, and the weights of such edges.
+     *
+     * @throws std::invalid_argument if \p i is not smaller than the number of vertices.
+     */
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t i) const
+    {
+        detail::topology_check_vertex(i, m_num_vertices);
+        std::pair<std::vector<std::size_t>, vector_double> retval;
+        if (i < m_in_edges.size()) {
+            const auto &in = m_in_edges[i];
+            for (decltype(in.first.size()) k = 0; k < in.first.size(); ++k) {
+                if (in.first[k] < m_num_vertices) {
+                    retval.first.push_back(in.first[k]);
+                    retval.second.push_back(in.second[k]);
+                }
+            }
+        }
+        return retval;
+    }
+    /// Add a vertex.
+    /**
+     * The new vertex will be connected by the edges previously added via add_edge(), if any.
+     */
+    void push_back()
+    {
+        ++m_num_vertices;
+    }
+    /// Add an edge.
+    /**
+     * This method will add a directed edge from vertex \p i to vertex \p j: migrants will flow from the island
+     * corresponding to \p i to the island corresponding to \p j.
+     *
+     * @param i the source vertex.
+     * @param j the destination vertex.
+     * @param w the weight of the edge.
+     *
+     * @throws std::invalid_argument if either:
+     * - \p i and \p j are equal,
+     * - the edge already exists,
+     * - \p w is not finite or not in the \f$\left[0,1\right]\f$ range.
+     */
+    void add_edge(std::size_t i, std::size_t j, double w = 1.)
+    {
+        detail::topology_check_weight(w);
+        if (i == j) {
+            pagmo_throw(std::invalid_argument,
+                        "Cannot add a self-loop to the vertex " + std::to_string(i) + " of a free-form topology");
+        }
+        if (j >= m_in_edges.size()) {
+            m_in_edges.resize(j + 1u);
+        }
+        auto &in = m_in_edges[j];
+        for (auto src : in.first) {
+            if (src == i) {
+                pagmo_throw(std::invalid_argument, "Cannot add an edge from the vertex " + std::to_string(i)
+                                                       + " to the vertex " + std::to_string(j)
+                                                       + " of a free-form topology: the edge already exists");
+            }
+        }
+        in.first.push_back(i);
+        in.second.push_back(w);
+    }
+    /// Get the number of vertices.
+    /**
+     * @return the number of vertices in the graph.
+     */
+    std::size_t num_vertices() const
+    {
+        return m_num_vertices;
+    }
+    /// Name of the topology.
+    /**
+     * @return <tt>"Free form"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Free form";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the number of vertices and edges.
+     */
+    std::string get_extra_info() const
+    {
+        std::size_t n_edges = 0;
+        for (const auto &in : m_in_edges) {
+            n_edges += in.first.size();
+        }
+        return "\tNumber of vertices: " + std::to_string(m_num_vertices)
+               + "\n\tNumber of edges: " + std::to_string(n_edges) + "\n";
+    }
+    /// Object serialization
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types and standard containers.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_num_vertices, m_in_edges);
+    }
+
+private:
+    std::size_t m_num_vertices;
+    // For each vertex, the sources and weights of its incoming edges.
+    std::vector<std::pair<std::vector<std::size_t>, vector_double>> m_in_edges;
+};
+
+} // namespace pagmo
+
+PAGMO_REGISTER_TOPOLOGY(pagmo::free_form)
+
+#endif
@@ -0,0 +1,143 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_TOPOLOGIES_FULLY_CONNECTED_HPP
+#define PAGMO_TOPOLOGIES_FULLY_CONNECTED_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/serialization.hpp>
+#include <pagmo/topology.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Fully connected topology.
+/**
+ * This user-defined topology (UDT) represents a complete graph: each vertex is connected to all the
+ * other vertices via edges with the same, constant, weight.
+ */
+class fully_connected
+{
+public:
+    /// Constructor.
+    /**
+     * @param n the initial number of vertices.
+     * @param w the weight of the edges.
+     *
+     * @throws std::invalid_argument if \p w is not finite or not in the \f$\left[0,1\right]\f$ range.
+     */
+    explicit fully_connected(std::size_t n = 0, double w = 1.) : m_num_vertices(n), m_weight(w)
+    {
+        detail::topology_check_weight(w);
+    }
+    /// Get the list of connections.
+    /**
+     * @param i the index of a vertex.
+     *
+     * @return the indices of all the vertices except \p i, and the weights of the corresponding edges.
+     *
+     * @throws std::invalid_argument if \p i is not smaller than the number of vertices.
+     */
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t i) const
+    {
+        detail::topology_check_vertex(i, m_num_vertices);
+        std::pair<std::vector<std::size_t>, vector_double> retval;
+        retval.first.reserve(m_num_vertices - 1u);
+        for (std::size_t j = 0; j < m_num_vertices; ++j) {
+            if (j != i) {
+                retval.first.push_back(j);
+            }
+        }
+        retval.second.resize(retval.first.size(), m_weight);
+        return retval;
+    }
+    /// Add a vertex.
+    void push_back()
+    {
+        ++m_num_vertices;
+    }
+    /// Get the number of vertices.
+    /**
+     * @return the number of vertices in the graph.
+     */
+    std::size_t num_vertices() const
+    {
+        return m_num_vertices;
+    }
+    /// Get the weight of the edges.
+    /**
+     * @return the weight of the edges.
+     */
+    double get_weight() const
+    {
+        return m_weight;
+    }
+    /// Name of the topology.
+    /**
+     * @return <tt>"Fully connected"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Fully connected";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the number of vertices and the weight of the edges.
+     */
+    std::string get_extra_info() const
+    {
+        return "\tNumber of vertices: " + std::to_string(m_num_vertices) + "\n\tWeight: " + std::to_string(m_weight)
+               + "\n";
+    }
+    /// Object serialization
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_num_vertices, m_weight);
+    }
+
+private:
+    std::size_t m_num_vertices;
+    double m_weight;
+};
+
+} // namespace pagmo
+
+PAGMO_REGISTER_TOPOLOGY(pagmo::fully_connected)
+
+#endif
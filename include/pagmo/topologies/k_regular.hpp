@@ -0,0 +1,176 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_TOPOLOGIES_K_REGULAR_HPP
+#define PAGMO_TOPOLOGIES_K_REGULAR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/rng.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/topology.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Random k-regular topology.
+/**
+ * This user-defined topology (UDT) represents a random directed graph in which every vertex has
+ * exactly \f$\min\left(k, n-1\right)\f$ incoming and \f$\min\left(k, n-1\right)\f$ outgoing edges, \f$n\f$ being the
+ * number of vertices. All edges have the same, constant, weight.
+ *
+ * The graph is built by arranging the vertices along a cycle according to a random permutation, and by connecting
+ * each vertex to the \f$k\f$ vertices that precede it along the cycle. The permutation is redrawn every time
+ * a vertex is added.
+ */
+class k_regular
+{
+public:
+    /// Constructor.
+    /**
+     * @param n the initial number of vertices.
+     * @param k the degree of the graph.
+     * @param w the weight of the edges.
+     * @param seed the seed used to initialise the random number generator.
+     *
+     * @throws std::invalid_argument if \p w is not finite or not in the \f$\left[0,1\right]\f$ range.
+     */
+    explicit k_regular(std::size_t n = 0, std::size_t k = 1, double w = 1.,
+                       unsigned seed = pagmo::random_device::next())
+        : m_k(k), m_weight(w), m_e(seed), m_seed(seed)
+    {
+        detail::topology_check_weight(w);
+        resize(n);
+    }
+    /// Get the list of connections.
+    /**
+     * @param i the index of a vertex.
+     *
+     * @return the sources of the edges pointing to \p i, and the weights of such edges.
+     *
+     * @throws std::invalid_argument if \p i is not smaller than the number of vertices.
+     */
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t i) const
+    {
+        const auto n = m_perm.size();
+        detail::topology_check_vertex(i, n);
+        const auto deg = n ? std::min(m_k, n - 1u) : std::size_t(0);
+        std::pair<std::vector<std::size_t>, vector_double> retval;
+        retval.first.reserve(deg);
+        for (std::size_t d = 1; d <= deg; ++d) {
+            retval.first.push_back(m_perm[(m_pos[i] + n - d) % n]);
+        }
+        retval.second.resize(deg, m_weight);
+        return retval;
+    }
+    /// Add a vertex.
+    /**
+     * This method will add a new vertex and redraw the graph.
+     */
+    void push_back()
+    {
+        resize(m_perm.size() + 1u);
+    }
+    /// Get the number of vertices.
+    /**
+     * @return the number of vertices in the graph.
+     */
+    std::size_t num_vertices() const
+    {
+        return m_perm.size();
+    }
+    /// Get the seed.
+    /**
+     * @return the seed used to initialise the random number generator.
+     */
+    unsigned get_seed() const
+    {
+        return m_seed;
+    }
+    /// Name of the topology.
+    /**
+     * @return <tt>"Random k-regular"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Random k-regular";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the parameters of the graph.
+     */
+    std::string get_extra_info() const
+    {
+        return "\tNumber of vertices: " + std::to_string(m_perm.size()) + "\n\tDegree: " + std::to_string(m_k)
+               + "\n\tWeight: " + std::to_string(m_weight) + "\n\tSeed: " + std::to_string(m_seed) + "\n";
+    }
+    /// Object serialization
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types and standard containers.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_k, m_weight, m_e, m_seed, m_perm, m_pos);
+    }
+
+private:
+    void resize(std::size_t n)
+    {
+        m_perm.resize(n);
+        std::iota(m_perm.begin(), m_perm.end(), std::size_t(0));
+        std::shuffle(m_perm.begin(), m_perm.end(), m_e);
+        m_pos.resize(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            m_pos[m_perm[j]] = j;
+        }
+    }
+
+private:
+    std::size_t m_k;
+    double m_weight;
+    detail::random_engine_type m_e;
+    unsigned m_seed;
+    // The vertices in cycle order, and the position of each vertex along the cycle.
+    std::vector<std::size_t> m_perm;
+    std::vector<std::size_t> m_pos;
+};
+
+} // namespace pagmo
+
+PAGMO_REGISTER_TOPOLOGY(pagmo::k_regular)
+
+#endif
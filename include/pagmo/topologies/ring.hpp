@@ -0,0 +1,144 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_TOPOLOGIES_RING_HPP
+#define PAGMO_TOPOLOGIES_RING_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/serialization.hpp>
+#include <pagmo/topology.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Ring topology.
+/**
+ * This user-defined topology (UDT) represents a bidirectional ring: each vertex \f$i\f$ is connected
+ * to the vertices \f$i-1\f$ and \f$i+1\f$ (modulo the number of vertices) via edges with the same, constant, weight.
+ * New vertices are inserted in the ring between the last and the first vertex.
+ */
+class ring
+{
+public:
+    /// Constructor.
+    /**
+     * @param n the initial number of vertices.
+     * @param w the weight of the edges.
+     *
+     * @throws std::invalid_argument if \p w is not finite or not in the \f$\left[0,1\right]\f$ range.
+     */
+    explicit ring(std::size_t n = 0, double w = 1.) : m_num_vertices(n), m_weight(w)
+    {
+        detail::topology_check_weight(w);
+    }
+    /// Get the list of connections.
+    /**
+     * @param i the index of a vertex.
+     *
+     * @return the indices of the vertices adjacent to \p i in the ring, and the weights of the corresponding edges.
+     *
+     * @throws std::invalid_argument if \p i is not smaller than the number of vertices.
+     */
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t i) const
+    {
+        detail::topology_check_vertex(i, m_num_vertices);
+        std::pair<std::vector<std::size_t>, vector_double> retval;
+        if (m_num_vertices > 1u) {
+            retval.first.push_back(i == 0u ? m_num_vertices - 1u : i - 1u);
+            if (m_num_vertices > 2u) {
+                retval.first.push_back(i == m_num_vertices - 1u ? 0u : i + 1u);
+            }
+            retval.second.resize(retval.first.size(), m_weight);
+        }
+        return retval;
+    }
+    /// Add a vertex.
+    void push_back()
+    {
+        ++m_num_vertices;
+    }
+    /// Get the number of vertices.
+    /**
+     * @return the number of vertices in the ring.
+     */
+    std::size_t num_vertices() const
+    {
+        return m_num_vertices;
+    }
+    /// Get the weight of the edges.
+    /**
+     * @return the weight of the edges.
+     */
+    double get_weight() const
+    {
+        return m_weight;
+    }
+    /// Name of the topology.
+    /**
+     * @return <tt>"Ring"</tt>.
+     */
+    std::string get_name() const
+    {
+        return "Ring";
+    }
+    /// Extra info.
+    /**
+     * @return a string containing the number of vertices and the weight of the edges.
+     */
+    std::string get_extra_info() const
+    {
+        return "\tNumber of vertices: " + std::to_string(m_num_vertices) + "\n\tWeight: " + std::to_string(m_weight)
+               + "\n";
+    }
+    /// Object serialization
+    /**
+     * @param ar target archive.
+     *
+     * @throws unspecified any exception thrown by the serialization of primitive types.
+     */
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_num_vertices, m_weight);
+    }
+
+private:
+    std::size_t m_num_vertices;
+    double m_weight;
+};
+
+} // namespace pagmo
+
+PAGMO_REGISTER_TOPOLOGY(pagmo::ring)
+
+#endif
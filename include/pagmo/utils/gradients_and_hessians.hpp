@@ -36,16 +36,175 @@ see https://www.gnu.org/licenses/. */
  */
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/types.hpp>
 
 namespace pagmo
 {
+
+namespace detail
+{
+
+// Greedy Curtis-Powell-Reid colouring of the columns of a sparse Jacobian with nx columns. Two columns
+// receive the same colour only if they do not have nonzero elements in the same row (i.e., they are structurally
+// orthogonal), so that all the columns of a colour can be perturbed at the same time. The columns are visited in
+// order of decreasing number of nonzero elements. The colour of each column is returned together with the number of
+// colours. Columns without nonzero elements are not coloured, and they are assigned the number of colours
+// as colour.
+inline std::pair<std::vector<vector_double::size_type>, vector_double::size_type>
+cpr_colouring(const sparsity_pattern &sp, vector_double::size_type nx)
+{
+    using size_type = vector_double::size_type;
+    const auto none = std::numeric_limits<size_type>::max();
+    size_type nr = 0;
+    for (const auto &e : sp) {
+        nr = std::max(nr, e.first + 1u);
+    }
+    std::vector<std::vector<size_type>> cols(nx), rows(nr);
+    for (const auto &e : sp) {
+        assert(e.second < nx);
+        cols[e.second].push_back(e.first);
+        rows[e.first].push_back(e.second);
+    }
+    std::vector<size_type> order(nx);
+    for (size_type j = 0; j < nx; ++j) {
+        order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&cols](size_type a, size_type b) { return cols[a].size() > cols[b].size(); });
+    std::vector<size_type> colour(nx, none), forbidden;
+    size_type n_colours = 0;
+    for (auto j : order) {
+        if (cols[j].empty()) {
+            continue;
+        }
+        // Mark with j the colours of the columns sharing a row with j.
+        for (auto r : cols[j]) {
+            for (auto k : rows[r]) {
+                if (colour[k] != none) {
+                    forbidden[colour[k]] = j;
+                }
+            }
+        }
+        size_type c = 0;
+        while (c < n_colours && forbidden[c] == j) {
+            ++c;
+        }
+        if (c == n_colours) {
+            ++n_colours;
+            forbidden.push_back(none);
+        }
+        colour[j] = c;
+    }
+    std::replace(colour.begin(), colour.end(), none, n_colours);
+    return {std::move(colour), n_colours};
+}
+
+// Greedy star colouring of the adjacency graph of a symmetric matrix with n rows, whose nonzero elements are
+// described by the union of the lower-triangular sparsity patterns in hs. In a star colouring, adjacent vertices
+// have different colours and every path on four vertices uses at least three colours. As a consequence,
+// for each off-diagonal nonzero element (k, j), either j is the only column of its colour with a nonzero element in
+// row k, or k is the only column of its colour with a nonzero element in row j, so that all the elements can be
+// recovered from the products of the matrix with the sums of the columns of each colour (Powell-Toint symmetric
+// colouring). The vertices are visited in order of decreasing degree. The return value has the same format as
+// cpr_colouring(), together with the adjacency lists of the graph.
+inline std::pair<std::pair<std::vector<vector_double::size_type>, vector_double::size_type>,
+                 std::vector<std::vector<vector_double::size_type>>>
+star_colouring(const std::vector<sparsity_pattern> &hs, vector_double::size_type n)
+{
+    using size_type = vector_double::size_type;
+    const auto none = std::numeric_limits<size_type>::max();
+    std::vector<std::vector<size_type>> adj(n);
+    std::vector<char> active(n, 0);
+    for (const auto &sp : hs) {
+        for (const auto &e : sp) {
+            assert(e.first < n && e.second <= e.first);
+            active[e.first] = active[e.second] = 1;
+            if (e.first != e.second) {
+                adj[e.first].push_back(e.second);
+                adj[e.second].push_back(e.first);
+            }
+        }
+    }
+    for (auto &a : adj) {
+        std::sort(a.begin(), a.end());
+        a.erase(std::unique(a.begin(), a.end()), a.end());
+    }
+    std::vector<size_type> order(n);
+    for (size_type j = 0; j < n; ++j) {
+        order[j] = j;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&adj](size_type a, size_type b) { return adj[a].size() > adj[b].size(); });
+    std::vector<size_type> colour(n, none), forbidden, n_neigh;
+    size_type n_colours = 0;
+    // Number of neighbours of v (other than w) with colour d.
+    const auto count_other = [&adj, &colour](size_type v, size_type w, size_type d) {
+        size_type retval = 0;
+        for (auto y : adj[v]) {
+            retval += static_cast<size_type>(y != w && colour[y] == d);
+        }
+        return retval;
+    };
+    for (auto v : order) {
+        if (!active[v]) {
+            continue;
+        }
+        // Adjacent vertices must have different colours.
+        for (auto w : adj[v]) {
+            if (colour[w] != none) {
+                forbidden[colour[w]] = v;
+            }
+        }
+        // Giving to v the colour of a vertex x at distance 2 via w must not create a path
+        // on four vertices with only two colours, either through another neighbour of v
+        // or through another neighbour of x with the colour of w.
+        for (auto w : adj[v]) {
+            const auto d = colour[w];
+            if (d == none) {
+                continue;
+            }
+            for (auto x : adj[w]) {
+                if (x == v || colour[x] == none || forbidden[colour[x]] == v) {
+                    continue;
+                }
+                if (count_other(v, w, d) || count_other(x, w, d)) {
+                    forbidden[colour[x]] = v;
+                }
+            }
+        }
+        size_type c = 0;
+        while (c < n_colours && forbidden[c] == v) {
+            ++c;
+        }
+        if (c == n_colours) {
+            ++n_colours;
+            forbidden.push_back(none);
+        }
+        colour[v] = c;
+    }
+    std::replace(colour.begin(), colour.end(), none, n_colours);
+    return {{std::move(colour), n_colours}, std::move(adj)};
+}
+
+// Step used in the finite differences along the j-th component of x.
+inline double fd_step(const vector_double &x, vector_double::size_type j, double dx)
+{
+    return std::max(std::abs(x[j]), 1.0) * dx;
+}
+
+} // namespace detail
+
 /// Heuristic to estimate the sparsity pattern
 /**
  * A numerical estimation of the sparsity pattern of same callable object is made by numerically
@@ -248,7 +407,324 @@ vector_double estimate_gradient_h(Func f, const vector_double &x, double dx = 1e
     }
     return gradient;
 }
+
+/// Numerical computation of a sparse gradient with coloured perturbations
+/**
+ * A numerical estimation of the nonzero elements of the gradient of a callable batch function is made by
+ * central differences, perturbing several variables at the same time.
+ *
+ * The callable function \p bf must have the prototype:
+ *
+ * @code{.unparsed}
+ * vector_double bf(const vector_double &)
+ * @endcode
+ *
+ * and it must compute, like pagmo::problem::batch_fitness(), the fitness vectors of a batch of decision vectors
+ * stored contiguously in its argument (otherwise compiler errors will be generated). In order to evaluate the
+ * batch in parallel, \p bf can wrap, e.g., a pagmo::thread_bfe.
+ *
+ * The columns of the sparsity pattern \p sp (which can be the output of pagmo::estimate_sparsity() or
+ * of pagmo::problem::gradient_sparsity()) are partitioned greedily into groups of structurally orthogonal columns
+ * (Curtis-Powell-Reid colouring). All the variables of a group are perturbed together, and each derivative is
+ * computed, as in pagmo::estimate_gradient(), according to the formula:
+ *
+ * \f[
+ * \frac{df_i}{dx_j} \approx \frac{f_i(x+d_c) - f_i(x-d_c)}{2dx_j} + O(dx^2)
+ * \f]
+ *
+ * where \f$ d_c \f$ is the perturbation of the group \f$ c \f$ containing \f$ j \f$. The overall cost,
+ * in terms of fitness evaluations, is thus \f$2n_c\f$ (in a single call to \p bf), where \f$n_c\f$ is the
+ * number of groups. For banded or block-structured Jacobians, \f$n_c\f$ does not depend on the size of \p x.
+ *
+ * @param bf instance of the callable batch function.
+ * @param x decision vector around which the gradient is computed.
+ * @param sp the sparsity pattern of the gradient.
+ * @param dx To compute the numerical derivative each component of the input decision vector \p x will be varied by
+ * \f$\max(|x_i|,1) * \f$ \p dx.
+ *
+ * @return the values of the gradient of \p bf approximated around \p x, in the order of the elements of \p sp.
+ *
+ * @throw std::invalid_argument if an element of \p sp refers to a variable beyond the size of \p x
+ * or to a fitness component beyond the size of the fitness vectors computed by \p bf, or
+ * if the size of the output of \p bf is not consistent with the size of the batch.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    The estimate is correct only if \p sp contains all the nonzero elements of the gradient: a dependency
+ *    missing from \p sp will pollute the derivatives of the variables in the same group.
+ *
+ * \endverbatim
+ */
+template <typename BatchFunc>
+vector_double estimate_gradient_sparse(BatchFunc bf, const vector_double &x, const sparsity_pattern &sp,
+                                       double dx = 1e-8)
+{
+    const auto nx = x.size();
+    for (const auto &e : sp) {
+        if (e.second >= nx) {
+            pagmo_throw(std::invalid_argument, "Invalid sparsity pattern: the element (" + std::to_string(e.first)
+                                                   + ", " + std::to_string(e.second)
+                                                   + ") refers to a variable beyond the size of the decision vector ("
+                                                   + std::to_string(nx) + ")");
+        }
+    }
+    const auto col = detail::cpr_colouring(sp, nx);
+    const auto n_colours = col.second;
+    if (!n_colours) {
+        return vector_double{};
+    }
+    // Build the batch: for each colour c, x + d_c at position 2c and x - d_c at position 2c + 1.
+    vector_double dvs(2u * n_colours * nx), h(nx);
+    for (decltype(dvs.size()) k = 0; k < 2u * n_colours; ++k) {
+        std::copy(x.begin(), x.end(), dvs.data() + k * nx);
+    }
+    for (decltype(x.size()) j = 0; j < nx; ++j) {
+        const auto c = col.first[j];
+        if (c < n_colours) {
+            h[j] = detail::fd_step(x, j, dx);
+            dvs[2u * c * nx + j] += h[j];
+            dvs[(2u * c + 1u) * nx + j] -= h[j];
+        }
+    }
+    const auto fvs = bf(dvs);
+    if (fvs.size() % (2u * n_colours)) {
+        pagmo_throw(std::invalid_argument, "The size of the output of the batch function (" + std::to_string(fvs.size())
+                                               + ") is not a multiple of the number of decision vectors ("
+                                               + std::to_string(2u * n_colours) + ")");
+    }
+    const auto nf = fvs.size() / (2u * n_colours);
+    vector_double retval(sp.size());
+    for (decltype(sp.size()) k = 0; k < sp.size(); ++k) {
+        const auto i = sp[k].first, j = sp[k].second;
+        if (i >= nf) {
+            pagmo_throw(std::invalid_argument, "Invalid sparsity pattern: the element (" + std::to_string(i) + ", "
+                                                   + std::to_string(j)
+                                                   + ") refers to a fitness component beyond the fitness dimension ("
+                                                   + std::to_string(nf) + ")");
+        }
+        const auto c = col.first[j];
+        retval[k] = (fvs[2u * c * nf + i] - fvs[(2u * c + 1u) * nf + i]) / 2. / h[j];
+    }
+    return retval;
+}
+
+/// Numerical computation of the gradient of a problem with coloured perturbations
+/**
+ * This function will estimate, via pagmo::estimate_gradient_sparse(), the gradient of \p p in the sparsity
+ * pattern returned by pagmo::problem::gradient_sparsity() (i.e., in the format required by
+ * pagmo::problem::gradient()). The perturbed decision vectors are evaluated in parallel by \p bfe.
+ *
+ * @param p the problem.
+ * @param x decision vector around which the gradient is computed.
+ * @param bfe the batch evaluator used to compute the fitness of the perturbed decision vectors.
+ * @param dx the relative perturbation (see pagmo::estimate_gradient_sparse()).
+ *
+ * @return the gradient of \p p approximated around \p x.
+ *
+ * @throw std::invalid_argument if the size of \p x is not equal to the dimension of \p p.
+ * @throw unspecified any exception thrown by pagmo::problem::gradient_sparsity(),
+ * by the invocation of \p bfe or by pagmo::estimate_gradient_sparse().
+ */
+inline vector_double estimate_gradient_sparse(problem &p, const vector_double &x, const thread_bfe &bfe,
+                                              double dx = 1e-8)
+{
+    if (x.size() != p.get_nx()) {
+        pagmo_throw(std::invalid_argument, "The size of the decision vector (" + std::to_string(x.size())
+                                               + ") is not equal to the problem dimension ("
+                                               + std::to_string(p.get_nx()) + ")");
+    }
+    return estimate_gradient_sparse([&p, &bfe](const vector_double &dvs) { return bfe(p, dvs); }, x,
+                                    p.gradient_sparsity(), dx);
+}
+
+
+/// Numerical computation of sparse hessians with coloured perturbations
+/**
+ * A numerical estimation of the nonzero elements of the hessians of the components of a callable batch function
+ * is made by finite differences, perturbing several variables at the same time.
+ *
+ * The callable function \p bf must have the prototype:
+ *
+ * @code{.unparsed}
+ * vector_double bf(const vector_double &)
+ * @endcode
+ *
+ * and it must compute, like pagmo::problem::batch_fitness(), the fitness vectors of a batch of decision vectors
+ * stored contiguously in its argument (otherwise compiler errors will be generated). In order to evaluate the
+ * batch in parallel, \p bf can wrap, e.g., a pagmo::thread_bfe.
+ *
+ * The sparsity patterns \p hs have the format of pagmo::problem::hessians_sparsity(): each pattern lists the
+ * nonzero elements of the lower triangular half of the hessian of a fitness component, and the size of \p hs must
+ * be equal to the fitness dimension. The variables are partitioned twice:
+ *
+ * - a symmetric (star) colouring of the union of the patterns partitions the columns of the hessians into groups
+ *   \f$ c \f$ with perturbation \f$ d_c \f$, such that each nonzero element can be recovered, exploiting symmetry,
+ *   from the products \f$ \mathbf H d_c \f$;
+ * - a Curtis-Powell-Reid colouring of the gradient sparsity implied by the patterns partitions the rows into groups
+ *   \f$ g \f$ with perturbation \f$ d_g \f$, such that each component of \f$ \mathbf H_i d_c \f$ can be isolated.
+ *
+ * Each element is then computed according to the formula:
+ *
+ * \f[
+ * \frac{\partial^2 f_i}{\partial x_k \partial x_j} \approx
+ * \frac{f_i(x+d_c+d_g) - f_i(x+d_c-d_g) - f_i(x-d_c+d_g) + f_i(x-d_c-d_g)}{4 dx_k dx_j} + O(dx^2)
+ * \f]
+ *
+ * The overall cost, in terms of fitness evaluations, is thus \f$4 n_c n_g\f$ (in a single call to \p bf),
+ * where \f$n_c\f$ and \f$n_g\f$ are the number of groups of the two colourings. For banded or arrowhead
+ * hessians, \f$n_c\f$ does not depend on the size of \p x.
+ *
+ * @param bf instance of the callable batch function.
+ * @param x decision vector around which the hessians are computed.
+ * @param hs the sparsity patterns of the hessians.
+ * @param dx To compute the numerical derivatives each component of the input decision vector \p x will be varied by
+ * \f$\max(|x_i|,1) * \f$ \p dx.
+ *
+ * @return the values of the hessians of \p bf approximated around \p x, in the order of the elements of \p hs.
+ *
+ * @throw std::invalid_argument if an element of \p hs refers to a variable beyond the size of \p x or is not in
+ * the lower triangular half, or if the size of the output of \p bf is not consistent with the size of
+ * the batch and of \p hs.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    The estimate is correct only if \p hs contains all the nonzero elements of the hessians: a dependency
+ *    missing from \p hs will pollute the derivatives of the variables in the same groups.
+ *
+ * \endverbatim
+ */
+template <typename BatchFunc>
+std::vector<vector_double> estimate_hessians(BatchFunc bf, const vector_double &x,
+                                             const std::vector<sparsity_pattern> &hs, double dx = 1e-4)
+{
+    using size_type = vector_double::size_type;
+    const auto nx = x.size();
+    for (const auto &sp : hs) {
+        for (const auto &e : sp) {
+            if (e.first >= nx || e.second > e.first) {
+                pagmo_throw(std::invalid_argument,
+                            "Invalid hessians sparsity pattern: the element (" + std::to_string(e.first) + ", "
+                                + std::to_string(e.second)
+                                + ") is not in the lower triangular half of a square matrix of size "
+                                + std::to_string(nx));
+            }
+        }
+    }
+    // Symmetric colouring of the columns.
+    const auto sc = detail::star_colouring(hs, nx);
+    const auto &h_col = sc.first.first;
+    const auto n_h_colours = sc.first.second;
+    const auto &adj = sc.second;
+    // The gradient sparsity implied by hs, and its colouring.
+    sparsity_pattern gs;
+    for (decltype(hs.size()) i = 0; i < hs.size(); ++i) {
+        for (const auto &e : hs[i]) {
+            gs.emplace_back(i, e.first);
+            gs.emplace_back(i, e.second);
+        }
+    }
+    std::sort(gs.begin(), gs.end());
+    gs.erase(std::unique(gs.begin(), gs.end()), gs.end());
+    const auto gc = detail::cpr_colouring(gs, nx);
+    const auto &g_col = gc.first;
+    const auto n_g_colours = gc.second;
+    std::vector<vector_double> retval;
+    for (const auto &sp : hs) {
+        retval.emplace_back(sp.size());
+    }
+    if (!n_h_colours) {
+        return retval;
+    }
+    // Build the batch: for each pair of colours (c, g), the points x + d_c + d_g, x + d_c - d_g, x - d_c + d_g
+    // and x - d_c - d_g at the positions starting from 4 * (c * n_g_colours + g).
+    const auto n_dvs = 4u * n_h_colours * n_g_colours;
+    vector_double dvs(n_dvs * nx), h(nx);
+    for (size_type k = 0; k < n_dvs; ++k) {
+        std::copy(x.begin(), x.end(), dvs.data() + k * nx);
+    }
+    for (size_type j = 0; j < nx; ++j) {
+        h[j] = detail::fd_step(x, j, dx);
+    }
+    for (size_type c = 0; c < n_h_colours; ++c) {
+        for (size_type g = 0; g < n_g_colours; ++g) {
+            auto ptr = dvs.data() + 4u * (c * n_g_colours + g) * nx;
+            for (size_type j = 0; j < nx; ++j) {
+                const auto dc = (h_col[j] == c) ? h[j] : 0., dg = (g_col[j] == g) ? h[j] : 0.;
+                ptr[j] += dc + dg;
+                ptr[nx + j] += dc - dg;
+                ptr[2u * nx + j] += -dc + dg;
+                ptr[3u * nx + j] += -dc - dg;
+            }
+        }
+    }
+    const auto fvs = bf(dvs);
+    if (fvs.size() != n_dvs * hs.size()) {
+        pagmo_throw(std::invalid_argument, "The size of the output of the batch function (" + std::to_string(fvs.size())
+                                               + ") is not equal to the number of decision vectors ("
+                                               + std::to_string(n_dvs)
+                                               + ") times the number of hessians sparsity patterns ("
+                                               + std::to_string(hs.size()) + ")");
+    }
+    const auto nf = hs.size();
+    // Row k of H_i d_c, times 4 dx_k dx_j.
+    const auto hd = [&](size_type i, size_type k, size_type c) {
+        const auto base = 4u * (c * n_g_colours + g_col[k]) * nf + i;
+        return fvs[base] - fvs[base + nf] - fvs[base + 2u * nf] + fvs[base + 3u * nf];
+    };
+    // Check if j is the only vertex adjacent to k with its colour.
+    const auto unique_in_row = [&adj, &h_col](size_type k, size_type j) {
+        for (auto y : adj[k]) {
+            if (y != j && h_col[y] == h_col[j]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (decltype(hs.size()) i = 0; i < nf; ++i) {
+        for (decltype(hs[i].size()) m = 0; m < hs[i].size(); ++m) {
+            const auto k = hs[i][m].first, j = hs[i][m].second;
+            if (k == j || unique_in_row(k, j)) {
+                retval[i][m] = hd(i, k, h_col[j]) / (4. * h[k] * h[j]);
+            } else {
+                assert(unique_in_row(j, k));
+                retval[i][m] = hd(i, j, h_col[k]) / (4. * h[k] * h[j]);
+            }
+        }
+    }
+    return retval;
+}
+
+/// Numerical computation of the hessians of a problem with coloured perturbations
+/**
+ * This function will estimate, via pagmo::estimate_hessians(), the hessians of \p p in the sparsity
+ * patterns returned by pagmo::problem::hessians_sparsity() (i.e., in the format required by
+ * pagmo::problem::hessians()). The perturbed decision vectors are evaluated in parallel by \p bfe.
+ *
+ * @param p the problem.
+ * @param x decision vector around which the hessians are computed.
+ * @param bfe the batch evaluator used to compute the fitness of the perturbed decision vectors.
+ * @param dx the relative perturbation (see pagmo::estimate_hessians()).
+ *
+ * @return the hessians of \p p approximated around \p x.
+ *
+ * @throw std::invalid_argument if the size of \p x is not equal to the dimension of \p p.
+ * @throw unspecified any exception thrown by pagmo::problem::hessians_sparsity(),
+ * by the invocation of \p bfe or by pagmo::estimate_hessians().
+ */
+inline std::vector<vector_double> estimate_hessians(problem &p, const vector_double &x, const thread_bfe &bfe,
+                                                    double dx = 1e-4)
+{
+    if (x.size() != p.get_nx()) {
+        pagmo_throw(std::invalid_argument, "The size of the decision vector (" + std::to_string(x.size())
+                                               + ") is not equal to the problem dimension ("
+                                               + std::to_string(p.get_nx()) + ")");
+    }
+    return estimate_hessians([&p, &bfe](const vector_double &dvs) { return bfe(p, dvs); }, x, p.hessians_sparsity(),
+                             dx);
+}
+
 } // namespace pagmo
-// namespace pagmo
 
 #endif
@@ -39,6 +39,7 @@ see https://www.gnu.org/licenses/. */
 #include <boost/python/object.hpp>
 #include <boost/python/stl_iterator.hpp>
 #include <boost/python/tuple.hpp>
+#include <cassert>
 #include <iterator>
 #include <memory>
 #include <sstream>
@@ -146,6 +147,52 @@ struct prob_inner<bp::object> final : prob_inner_base, pygmo::common_base {
     {
         return getter_wrapper<std::string>(m_value, "get_extra_info", std::string{});
     }
+    // NOTE: the raw fitness interface is not available for Python problems.
+    virtual bool has_raw_fitness() const override final
+    {
+        return false;
+    }
+    // LCOV_EXCL_START
+    [[noreturn]] virtual void raw_fitness(const double *, double *) const override final
+    {
+        // NOTE: this will never be called, as problem invokes raw_fitness()
+        // only if has_raw_fitness() returned true.
+        assert(false);
+        throw;
+    }
+    // LCOV_EXCL_STOP
+    virtual bool has_batch_fitness() const override final
+    {
+        // Same logic as in C++:
+        // - without a batch_fitness() method, return false;
+        // - with a batch_fitness() and no override, return true;
+        // - with a batch_fitness() and override, return the value from the override.
+        auto bf = pygmo::callable_attribute(m_value, "batch_fitness");
+        if (bf.is_none()) {
+            return false;
+        }
+        auto hbf = pygmo::callable_attribute(m_value, "has_batch_fitness");
+        if (hbf.is_none()) {
+            return true;
+        }
+        return bp::extract<bool>(hbf());
+    }
+    virtual vector_double batch_fitness(const vector_double &dvs) const override final
+    {
+        auto bf = pygmo::callable_attribute(m_value, "batch_fitness");
+        if (bf.is_none()) {
+            // NOTE: as for gradient_sparsity(), we get here only if batch_fitness() was
+            // erased from the UDP after the problem construction.
+            pygmo_throw(PyExc_RuntimeError,
+                        ("batch fitness evaluation has been requested but it is not implemented."
+                         "This indicates a logical error in the implementation of the user-defined Python problem "
+                         + pygmo::str(m_value) + "' of type '" + pygmo::str(pygmo::type(m_value))
+                         + "': the batch fitness was available at problem construction but it has been removed "
+                           "at a later stage")
+                            .c_str());
+        }
+        return pygmo::to_vd(bf(pygmo::v_to_a(dvs)));
+    }
     virtual bool has_gradient() const override final
     {
         // Same logic as in C++:
@@ -36,7 +36,9 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/ackley.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/types.hpp>
+#include <pagmo/utils/generic.hpp>
 
 using namespace pagmo;
 
@@ -84,3 +86,24 @@ BOOST_AUTO_TEST_CASE(ackley_serialization_test)
     auto after = boost::lexical_cast<std::string>(p);
     BOOST_CHECK_EQUAL(before, after);
 }
+
+BOOST_AUTO_TEST_CASE(ackley_batch_test)
+{
+    problem p{ackley{13u}};
+    BOOST_CHECK(p.has_batch_fitness());
+    detail::random_engine_type r_engine(42u);
+    // Cover full blocks, a partial block and an empty batch: the results
+    // must be bitwise identical to the scalar ones.
+    for (auto n_dvs : {0u, 1u, 8u, 21u}) {
+        vector_double dvs;
+        for (auto i = 0u; i < n_dvs; ++i) {
+            const auto dv = random_decision_vector(p.get_bounds(), r_engine);
+            dvs.insert(dvs.end(), dv.begin(), dv.end());
+        }
+        const auto fvs = p.batch_fitness(dvs);
+        BOOST_CHECK_EQUAL(fvs.size(), n_dvs);
+        for (auto i = 0u; i < n_dvs; ++i) {
+            BOOST_CHECK_EQUAL(fvs[i], p.fitness(vector_double(dvs.data() + i * 13u, dvs.data() + (i + 1u) * 13u))[0]);
+        }
+    }
+}
@@ -48,8 +48,10 @@ see https://www.gnu.org/licenses/. */
 #include <vector>
 
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
 #include <pagmo/algorithms/pso.hpp>
 #include <pagmo/archipelago.hpp>
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/island.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
@@ -408,6 +410,32 @@ BOOST_AUTO_TEST_CASE(archipelago_champion_tests)
     BOOST_CHECK_THROW(archi.get_champions_x(), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(archipelago_get_champions)
+{
+    archipelago archi;
+    BOOST_CHECK(archi.get_champions().empty());
+    archi.push_back(de{}, rosenbrock{}, 20u);
+    archi.push_back(de{}, rosenbrock{10}, 20u);
+    archi.push_back(nsga2{}, zdt{}, 20u);
+    archi.evolve(2);
+    archi.wait_check();
+    auto c = archi.get_champions();
+    BOOST_CHECK_EQUAL(c.size(), 3u);
+    for (auto i = 0u; i < 2u; ++i) {
+        BOOST_CHECK(c[i].has_champion);
+        BOOST_CHECK(c[i].n_evolve == 2u);
+        BOOST_CHECK(c[i].x == archi[i].get_population().champion_x());
+        BOOST_CHECK(c[i].f == archi[i].get_population().champion_f());
+    }
+    BOOST_CHECK(!c[2].has_champion);
+    BOOST_CHECK(c[2].n_evolve == 2u);
+    BOOST_CHECK(c[2].nd_f.empty());
+    c = archi.get_champions(true);
+    BOOST_CHECK(!c[2].nd_f.empty());
+    BOOST_CHECK(c[2].nd_f == archi[2].get_champion()->nd_f);
+    BOOST_CHECK(c[0].nd_f.empty());
+}
+
 BOOST_AUTO_TEST_CASE(archipelago_status)
 {
     flag.store(true);
@@ -475,3 +503,76 @@ BOOST_AUTO_TEST_CASE(archipelago_throw_on_ctor)
 {
     BOOST_CHECK_THROW((archipelago{100u, de{}, pthrower_00{}, 1u}), std::invalid_argument);
 }
+
+// An algorithm evaluating the population via a thread_bfe and evolving
+// a nested island, so that both nest into the pool running the evolution.
+struct nested_algo {
+    population evolve(population pop) const
+    {
+        auto p = pop.get_problem();
+        const auto fvs = thread_bfe{4u}(p, pop.get_x_data());
+        if (fvs != pop.get_f_data()) {
+            throw std::runtime_error("wrong batch evaluation");
+        }
+        island isl{de{}, population{rosenbrock{}, 10u}};
+        isl.evolve(2);
+        isl.wait_check();
+        return pop;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(archipelago_thread_pool)
+{
+    archipelago archi{10u, de{}, rosenbrock{}, 20u};
+    BOOST_CHECK(archi.get_n_threads() > 0u);
+    // A dedicated pool.
+    archi.set_n_threads(2u);
+    BOOST_CHECK_EQUAL(archi.get_n_threads(), 2u);
+    archi.push_back(de{}, rosenbrock{}, 20u);
+    archi.evolve(5);
+    archi.wait_check();
+    for (const auto &isl : archi) {
+        BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 5u);
+    }
+    // Copies share the pool, moves transfer it.
+    auto archi2(archi);
+    BOOST_CHECK_EQUAL(archi2.get_n_threads(), 2u);
+    archi2.evolve();
+    archi2.wait_check();
+    auto archi3(std::move(archi2));
+    BOOST_CHECK_EQUAL(archi3.get_n_threads(), 2u);
+    // Deserialisation keeps the pool of the target.
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(archi);
+    }
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(archi3);
+    }
+    BOOST_CHECK_EQUAL(archi3.get_n_threads(), 2u);
+    archi3.evolve();
+    archi3.wait_check();
+    // Back to the shared pool, waiting for ongoing evolutions.
+    archi.evolve(10);
+    archi.set_n_threads(0u);
+    BOOST_CHECK(archi.status() == evolve_status::idle);
+    BOOST_CHECK_EQUAL(archi.get_n_threads(), archipelago{}.get_n_threads());
+    // Many more islands than threads, each with several queued evolutions.
+    archipelago archi4{200u, de{}, rosenbrock{}, 10u};
+    archi4.set_n_threads(3u);
+    archi4.evolve(2);
+    archi4.evolve(3);
+    archi4.wait_check();
+    for (const auto &isl : archi4) {
+        BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 5u);
+    }
+    // Nested parallelism, on a single-threaded dedicated pool and on the shared pool.
+    for (auto n : {1u, 0u}) {
+        archipelago archi5{4u, nested_algo{}, rosenbrock{}, 20u};
+        archi5.set_n_threads(n);
+        archi5.evolve(3);
+        archi5.wait_check();
+    }
+}
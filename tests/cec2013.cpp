@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE cec2013_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <iostream>
 #include <stdexcept>
@@ -84,3 +85,50 @@ BOOST_AUTO_TEST_CASE(cec2013_serialization_test)
     auto after = boost::lexical_cast<std::string>(p);
     BOOST_CHECK_EQUAL(before, after);
 }
+
+BOOST_AUTO_TEST_CASE(cec2013_batch_test)
+{
+    std::mt19937 r_engine(32u);
+    // The batch fitness must give exactly the same results as the fitness, for any number of decision vectors
+    // (including batches which are not multiples of the rotation block size, and repeated decision vectors).
+    for (unsigned int i = 1u; i <= 28u; ++i) {
+        problem prob{cec2013{i, 10u}};
+        BOOST_CHECK(prob.has_batch_fitness());
+        for (auto n_dvs : {0u, 1u, 5u, 16u, 37u}) {
+            vector_double dvs;
+            for (auto j = 0u; j < n_dvs; ++j) {
+                auto x = random_decision_vector(prob.get_bounds(), r_engine);
+                dvs.insert(dvs.end(), x.begin(), x.end());
+            }
+            if (n_dvs > 1u) {
+                std::copy(dvs.begin(), dvs.begin() + 10, dvs.end() - 10);
+            }
+            auto fvs = prob.batch_fitness(dvs);
+            BOOST_CHECK_EQUAL(fvs.size(), n_dvs);
+            for (auto j = 0u; j < n_dvs; ++j) {
+                const vector_double x(dvs.data() + j * 10u, dvs.data() + (j + 1u) * 10u);
+                BOOST_CHECK_EQUAL(fvs[j], prob.fitness(x)[0]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cec2013_shared_data_test)
+{
+    // The problem data is reloaded on deserialization.
+    cec2013 a{21u, 10u};
+    problem p{a};
+    std::stringstream ss;
+    {
+        cereal::BinaryOutputArchive oarchive(ss);
+        oarchive(p);
+    }
+    p = problem{null_problem{}};
+    {
+        cereal::BinaryInputArchive iarchive(ss);
+        iarchive(p);
+    }
+    const vector_double x(10u, 1.);
+    BOOST_CHECK_EQUAL(p.fitness(x)[0], a.fitness(x)[0]);
+    BOOST_CHECK_EQUAL(p.fitness(x)[0], cec2013{a}.fitness(x)[0]);
+}
@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE cec2014_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <iostream>
 #include <stdexcept>
@@ -139,3 +140,55 @@ BOOST_AUTO_TEST_CASE(cec2014_serialization_test)
     auto after = boost::lexical_cast<std::string>(p);
     BOOST_CHECK_EQUAL(before, after);
 }
+
+BOOST_AUTO_TEST_CASE(cec2014_batch_test)
+{
+    std::mt19937 r_engine(32u);
+    // The batch fitness must give exactly the same results as the fitness, for any number of decision vectors
+    // (including batches which are not multiples of the rotation block size, and repeated decision vectors).
+    for (unsigned int i = 1u; i <= 30u; ++i) {
+        problem prob{cec2014{i, 10u}};
+        BOOST_CHECK(prob.has_batch_fitness());
+        for (auto n_dvs : {0u, 1u, 5u, 16u, 37u}) {
+            vector_double dvs;
+            for (auto j = 0u; j < n_dvs; ++j) {
+                auto x = random_decision_vector(prob.get_bounds(), r_engine);
+                dvs.insert(dvs.end(), x.begin(), x.end());
+            }
+            if (n_dvs > 1u) {
+                std::copy(dvs.begin(), dvs.begin() + 10, dvs.end() - 10);
+            }
+            auto fvs = prob.batch_fitness(dvs);
+            BOOST_CHECK_EQUAL(fvs.size(), n_dvs);
+            for (auto j = 0u; j < n_dvs; ++j) {
+                const vector_double x(dvs.data() + j * 10u, dvs.data() + (j + 1u) * 10u);
+                BOOST_CHECK_EQUAL(fvs[j], prob.fitness(x)[0]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cec2014_shared_data_test)
+{
+    // Copies and instances with the same id and dimension share the problem data.
+    cec2014 a{17u, 10u}, b{a}, c{17u, 10u}, d{17u, 20u};
+    BOOST_CHECK(&a.get_origin_shift() == &b.get_origin_shift());
+    BOOST_CHECK(&a.get_origin_shift() == &c.get_origin_shift());
+    BOOST_CHECK(&a.get_origin_shift() != &d.get_origin_shift());
+    BOOST_CHECK_EQUAL(d.get_origin_shift().size(), 2u * a.get_origin_shift().size());
+    // The data is reloaded on deserialization.
+    problem p{a};
+    std::stringstream ss;
+    {
+        cereal::BinaryOutputArchive oarchive(ss);
+        oarchive(p);
+    }
+    p = problem{null_problem{}};
+    {
+        cereal::BinaryInputArchive iarchive(ss);
+        iarchive(p);
+    }
+    BOOST_CHECK(&p.extract<cec2014>()->get_origin_shift() == &a.get_origin_shift());
+    const vector_double x(10u, 1.);
+    BOOST_CHECK_EQUAL(p.fitness(x)[0], a.fitness(x)[0]);
+}
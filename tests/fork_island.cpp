@@ -212,3 +212,161 @@ BOOST_AUTO_TEST_CASE(fork_island_recurse)
         });
     }
 }
+
+// Test the persistent worker mode.
+BOOST_AUTO_TEST_CASE(fork_island_persistent)
+{
+    {
+        fork_island fi_0(true, 3);
+        BOOST_CHECK(fi_0.is_persistent());
+        BOOST_CHECK_EQUAL(fi_0.get_max_tasks(), 3u);
+        BOOST_CHECK(fi_0.get_worker_pid() == pid_t(0));
+        BOOST_CHECK(boost::contains(fi_0.get_extra_info(), "Persistent worker: yes"));
+        BOOST_CHECK(boost::contains(fi_0.get_extra_info(), "Max tasks per worker: 3"));
+        fork_island fi_1(fi_0), fi_2(std::move(fi_0));
+        BOOST_CHECK(fi_1.is_persistent() && fi_2.is_persistent());
+        BOOST_CHECK_EQUAL(fi_1.get_max_tasks(), 3u);
+        BOOST_CHECK_EQUAL(fi_2.get_max_tasks(), 3u);
+        BOOST_CHECK(!fork_island{}.is_persistent());
+        BOOST_CHECK(boost::contains(fork_island(true).get_extra_info(), "Max tasks per worker: unlimited"));
+    }
+    {
+        // The worker survives across evolutions.
+        island fi_0(fork_island{true}, compass_search{100}, rosenbrock{}, 1, 0);
+        const auto old_cf = fi_0.get_population().champion_f();
+        fi_0.evolve();
+        fi_0.wait_check();
+        const auto wpid = fi_0.extract<fork_island>()->get_worker_pid();
+        BOOST_CHECK(wpid != pid_t(0));
+        BOOST_CHECK(boost::contains(fi_0.get_extra_info(), "Worker PID: " + std::to_string(wpid)));
+        fi_0.evolve(3);
+        fi_0.wait_check();
+        BOOST_CHECK(fi_0.extract<fork_island>()->get_worker_pid() == wpid);
+        BOOST_CHECK(fi_0.get_population().champion_f()[0] < old_cf[0]);
+        // Copies do not share the worker.
+        auto fi_1(fi_0);
+        BOOST_CHECK(fi_1.extract<fork_island>()->get_worker_pid() == pid_t(0));
+        BOOST_CHECK(fi_1.extract<fork_island>()->is_persistent());
+    }
+    {
+        // The state of the algorithm is kept by the worker, and changes
+        // made in the parent are forwarded to it.
+        island fi_0(fork_island{true}, stateful_algo{}, rosenbrock{}, 1, 0);
+        for (int i = 1; i <= 3; ++i) {
+            fi_0.evolve();
+            fi_0.wait_check();
+            BOOST_CHECK_EQUAL(fi_0.get_algorithm().extract<stateful_algo>()->n_evolve, i);
+        }
+        fi_0.set_algorithm(algorithm{stateful_algo{}});
+        const population pop{rosenbrock{}, 3, 42};
+        fi_0.set_population(pop);
+        fi_0.evolve();
+        fi_0.wait_check();
+        BOOST_CHECK_EQUAL(fi_0.get_algorithm().extract<stateful_algo>()->n_evolve, 1);
+        BOOST_CHECK(fi_0.get_population().get_x() == pop.get_x());
+    }
+    {
+        // Errors in the evolution are transported, and the worker remains usable.
+        island fi_0(fork_island{true}, de{1}, rosenbrock{}, 1);
+        fi_0.evolve();
+        BOOST_CHECK_EXCEPTION(fi_0.wait_check(), std::runtime_error, [](const std::runtime_error &re) {
+            return boost::contains(re.what(), "needs at least 5 individuals in the population");
+        });
+        const auto wpid = fi_0.extract<fork_island>()->get_worker_pid();
+        BOOST_CHECK(wpid != pid_t(0));
+        fi_0.set_population(population{rosenbrock{}, 10});
+        fi_0.evolve();
+        fi_0.wait_check();
+        BOOST_CHECK(fi_0.extract<fork_island>()->get_worker_pid() == wpid);
+    }
+    {
+        // Killing the worker raises an error, and a new worker is spawned
+        // by the next evolution.
+        island fi_0(fork_island{true}, de{200}, godot1{20}, 20);
+        fi_0.evolve();
+        pid_t child_pid;
+        while (!(child_pid = fi_0.extract<fork_island>()->get_child_pid())) {
+        }
+        BOOST_CHECK(fi_0.extract<fork_island>()->get_worker_pid() == child_pid);
+        kill(child_pid, SIGKILL);
+        BOOST_CHECK_THROW(fi_0.wait_check(), std::exception);
+        BOOST_CHECK(fi_0.extract<fork_island>()->get_worker_pid() == pid_t(0));
+        fi_0.set_algorithm(algorithm{compass_search{10}});
+        fi_0.set_population(population{rosenbrock{}, 1});
+        fi_0.evolve();
+        fi_0.wait_check();
+        const auto wpid = fi_0.extract<fork_island>()->get_worker_pid();
+        BOOST_CHECK(wpid != pid_t(0) && wpid != child_pid);
+    }
+    {
+        // Recycling after a fixed number of tasks.
+        island fi_0(fork_island{true, 2}, stateful_algo{}, rosenbrock{}, 1, 0);
+        fi_0.evolve();
+        fi_0.wait_check();
+        const auto wpid = fi_0.extract<fork_island>()->get_worker_pid();
+        BOOST_CHECK(wpid != pid_t(0));
+        fi_0.evolve();
+        fi_0.wait_check();
+        BOOST_CHECK(fi_0.extract<fork_island>()->get_worker_pid() == pid_t(0));
+        fi_0.evolve();
+        fi_0.wait_check();
+        const auto wpid2 = fi_0.extract<fork_island>()->get_worker_pid();
+        BOOST_CHECK(wpid2 != pid_t(0) && wpid2 != wpid);
+        // The state of the algorithm survives the recycling.
+        BOOST_CHECK_EQUAL(fi_0.get_algorithm().extract<stateful_algo>()->n_evolve, 3);
+    }
+}
+
+// An algorithm that adds an individual to the population.
+struct grow_algo {
+    population evolve(population pop) const
+    {
+        pop.push_back(vector_double(pop.get_problem().get_nx(), .5));
+        return pop;
+    }
+    template <typename Archive>
+    void serialize(Archive &)
+    {
+    }
+};
+
+PAGMO_REGISTER_ALGORITHM(grow_algo)
+
+// Check the transfer of the individuals via shared memory.
+BOOST_AUTO_TEST_CASE(fork_island_shm)
+{
+    for (auto persistent : {false, true}) {
+        {
+            // The population must be transferred exactly.
+            const population pop{rosenbrock{20}, 100, 42};
+            island fi_0(fork_island{persistent}, stateful_algo{}, pop);
+            fi_0.evolve();
+            fi_0.wait_check();
+            const auto new_pop = fi_0.get_population();
+            BOOST_CHECK(new_pop.get_ID() == pop.get_ID());
+            BOOST_CHECK(new_pop.get_x_data() == pop.get_x_data());
+            BOOST_CHECK(new_pop.get_f_data() == pop.get_f_data());
+            BOOST_CHECK(new_pop.get_x() == pop.get_x());
+            BOOST_CHECK(new_pop.champion_x() == pop.champion_x());
+            BOOST_CHECK(new_pop.champion_f() == pop.champion_f());
+            BOOST_CHECK_EQUAL(new_pop.get_seed(), pop.get_seed());
+            BOOST_CHECK_EQUAL(new_pop.get_problem().get_fevals(), pop.get_problem().get_fevals());
+            BOOST_CHECK(new_pop.random_decision_vector() == pop.random_decision_vector());
+        }
+        {
+            // A population which outgrows the shared memory region is sent through the pipe.
+            island fi_0(fork_island{persistent}, grow_algo{}, rosenbrock{}, 2, 0);
+            for (auto i = 3u; i < 6u; ++i) {
+                fi_0.evolve();
+                fi_0.wait_check();
+                BOOST_CHECK_EQUAL(fi_0.get_population().size(), i);
+            }
+            // An empty population.
+            fi_0.set_algorithm(algorithm{stateful_algo{}});
+            fi_0.set_population(population{rosenbrock{}});
+            fi_0.evolve();
+            fi_0.wait_check();
+            BOOST_CHECK_EQUAL(fi_0.get_population().size(), 0u);
+        }
+    }
+}
@@ -29,10 +29,15 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE generic_utilities_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <utility>
 
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
 #include <pagmo/rng.hpp>
 #include <pagmo/types.hpp>
 #include <pagmo/utils/gradients_and_hessians.hpp>
@@ -149,4 +154,257 @@ BOOST_AUTO_TEST_CASE(estimate_gradient_test)
     for (unsigned i = 0u; i < res.size(); ++i) {
         BOOST_CHECK_CLOSE(gh[i], res[i], 1e-11);
     }
-}
\ No newline at end of file
+}
+// A chained problem with a banded (tridiagonal) Jacobian, plus a dense objective.
+struct chained_problem {
+    vector_double fitness(const vector_double &dv) const
+    {
+        const auto n = dv.size();
+        vector_double retval(n + 1u, 0.);
+        for (decltype(dv.size()) i = 0; i < n; ++i) {
+            retval[0] += dv[i] * dv[i];
+            retval[i + 1u] = std::sin(dv[i]) * (i ? dv[i - 1u] : 1.) + (i + 1u < n ? dv[i + 1u] * dv[i + 1u] : 0.);
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(50u, -1.), vector_double(50u, 1.)};
+    }
+    vector_double::size_type get_nic() const
+    {
+        return 50u;
+    }
+    sparsity_pattern gradient_sparsity() const
+    {
+        sparsity_pattern retval;
+        for (vector_double::size_type j = 0; j < 50u; ++j) {
+            retval.emplace_back(0u, j);
+        }
+        for (vector_double::size_type i = 0; i < 50u; ++i) {
+            for (auto j = i ? i - 1u : 0u; j <= std::min<vector_double::size_type>(i + 1u, 49u); ++j) {
+                retval.emplace_back(i + 1u, j);
+            }
+        }
+        return retval;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(estimate_gradient_sparse_test)
+{
+    chained_problem udp;
+    vector_double x(50u);
+    for (decltype(x.size()) i = 0; i < x.size(); ++i) {
+        x[i] = 0.1 + 0.01 * static_cast<double>(i);
+    }
+    const auto f = [udp](const vector_double &y) { return udp.fitness(y); };
+    unsigned n_evals = 0;
+    const auto bf = [udp, &n_evals](const vector_double &dvs) {
+        vector_double retval;
+        for (decltype(dvs.size()) i = 0; i < dvs.size(); i += 50u) {
+            const auto fv = udp.fitness(vector_double(dvs.data() + i, dvs.data() + i + 50u));
+            retval.insert(retval.end(), fv.begin(), fv.end());
+            ++n_evals;
+        }
+        return retval;
+    };
+    // Compare with the dense estimate, both with the exact and with the estimated sparsity.
+    const auto dense = estimate_gradient(f, x);
+    for (const auto &sp : {udp.gradient_sparsity(), estimate_sparsity(f, x)}) {
+        n_evals = 0;
+        const auto g = estimate_gradient_sparse(bf, x, sp);
+        BOOST_CHECK_EQUAL(g.size(), sp.size());
+        for (decltype(g.size()) k = 0; k < g.size(); ++k) {
+            BOOST_CHECK_CLOSE(g[k], dense[sp[k].first * 50u + sp[k].second], 1e-4);
+        }
+        // The dense first row prevents sharing perturbations: one colour per column.
+        BOOST_CHECK_EQUAL(n_evals, 100u);
+    }
+    // Without the dense objective, the tridiagonal part needs only 3 colours.
+    sparsity_pattern sp_tri;
+    for (const auto &e : udp.gradient_sparsity()) {
+        if (e.first) {
+            sp_tri.push_back(e);
+        }
+    }
+    n_evals = 0;
+    const auto g_tri = estimate_gradient_sparse(bf, x, sp_tri);
+    BOOST_CHECK_EQUAL(n_evals, 6u);
+    for (decltype(g_tri.size()) k = 0; k < g_tri.size(); ++k) {
+        BOOST_CHECK_CLOSE(g_tri[k], dense[sp_tri[k].first * 50u + sp_tri[k].second], 1e-4);
+    }
+    // Empty pattern: no evaluations.
+    n_evals = 0;
+    BOOST_CHECK(estimate_gradient_sparse(bf, x, sparsity_pattern{}).empty());
+    BOOST_CHECK_EQUAL(n_evals, 0u);
+    // Invalid patterns.
+    BOOST_CHECK_THROW(estimate_gradient_sparse(bf, x, sparsity_pattern{{0u, 50u}}), std::invalid_argument);
+    BOOST_CHECK_THROW(estimate_gradient_sparse(bf, x, sparsity_pattern{{51u, 0u}}), std::invalid_argument);
+    BOOST_CHECK_THROW(estimate_gradient_sparse([](const vector_double &) { return vector_double{1.}; }, x, sp_tri),
+                      std::invalid_argument);
+    // Problem overload, evaluated in parallel.
+    problem p{udp};
+    thread_bfe tbfe{4u};
+    const auto gp = estimate_gradient_sparse(p, x, tbfe);
+    BOOST_CHECK_EQUAL(gp.size(), p.gradient_sparsity().size());
+    BOOST_CHECK_EQUAL(p.get_fevals(), 100u);
+    const auto sp = p.gradient_sparsity();
+    for (decltype(gp.size()) k = 0; k < gp.size(); ++k) {
+        BOOST_CHECK_CLOSE(gp[k], dense[sp[k].first * 50u + sp[k].second], 1e-4);
+    }
+    BOOST_CHECK_THROW(estimate_gradient_sparse(p, vector_double(3u), tbfe), std::invalid_argument);
+}
+
+// A problem with a banded hessian in the objective, an arrowhead hessian in the
+// constraint and a linear constraint.
+struct hess_problem {
+    vector_double fitness(const vector_double &dv) const
+    {
+        vector_double retval(3u, 0.);
+        for (decltype(dv.size()) i = 0; i + 1u < dv.size(); ++i) {
+            retval[0] += dv[i] * dv[i] * dv[i + 1u];
+        }
+        for (decltype(dv.size()) i = 1; i < dv.size(); ++i) {
+            retval[1] += dv[0] * dv[i] * dv[i];
+            retval[2] += dv[i];
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(20u, -1.), vector_double(20u, 1.)};
+    }
+    vector_double::size_type get_nec() const
+    {
+        return 1u;
+    }
+    vector_double::size_type get_nic() const
+    {
+        return 1u;
+    }
+    std::vector<vector_double> hessians(const vector_double &dv) const
+    {
+        std::vector<vector_double> retval(3u);
+        for (vector_double::size_type i = 0; i < 20u; ++i) {
+            retval[0].push_back(i + 1u < 20u ? 2. * dv[i + 1u] : 0.);
+            if (i + 1u < 20u) {
+                retval[0].push_back(2. * dv[i]);
+            }
+        }
+        retval[1].push_back(0.);
+        for (vector_double::size_type i = 1; i < 20u; ++i) {
+            retval[1].push_back(2. * dv[i]);
+            retval[1].push_back(2. * dv[0]);
+        }
+        return retval;
+    }
+    std::vector<sparsity_pattern> hessians_sparsity() const
+    {
+        std::vector<sparsity_pattern> retval(3u);
+        for (vector_double::size_type i = 0; i < 20u; ++i) {
+            retval[0].emplace_back(i, i);
+            if (i + 1u < 20u) {
+                retval[0].emplace_back(i + 1u, i);
+            }
+        }
+        retval[1].emplace_back(0u, 0u);
+        for (vector_double::size_type i = 1; i < 20u; ++i) {
+            retval[1].emplace_back(i, 0u);
+            retval[1].emplace_back(i, i);
+        }
+        return retval;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(estimate_hessians_test)
+{
+    hess_problem udp;
+    vector_double x(20u);
+    for (decltype(x.size()) i = 0; i < x.size(); ++i) {
+        x[i] = 0.3 - 0.02 * static_cast<double>(i);
+    }
+    unsigned n_evals = 0;
+    const auto bf = [udp, &n_evals](const vector_double &dvs) {
+        vector_double retval;
+        for (decltype(dvs.size()) i = 0; i < dvs.size(); i += 20u) {
+            const auto fv = udp.fitness(vector_double(dvs.data() + i, dvs.data() + i + 20u));
+            retval.insert(retval.end(), fv.begin(), fv.end());
+            ++n_evals;
+        }
+        return retval;
+    };
+    const auto exact = udp.hessians(x);
+    const auto check = [&exact](const std::vector<vector_double> &hs) {
+        BOOST_CHECK_EQUAL(hs.size(), exact.size());
+        for (decltype(hs.size()) i = 0; i < hs.size(); ++i) {
+            BOOST_CHECK_EQUAL(hs[i].size(), exact[i].size());
+            for (decltype(hs[i].size()) k = 0; k < hs[i].size(); ++k) {
+                BOOST_CHECK_SMALL(hs[i][k] - exact[i][k], 1e-5);
+            }
+        }
+    };
+    const auto h = estimate_hessians(bf, x, udp.hessians_sparsity());
+    check(h);
+    // The dense objective gradient needs one perturbation per variable, but the
+    // symmetric colouring of the banded/arrowhead hessians needs only a few colours.
+    BOOST_CHECK(n_evals < 4u * 5u * 20u);
+    // Banded hessian only.
+    n_evals = 0;
+    std::vector<sparsity_pattern> hs_band{udp.hessians_sparsity()[0], {}, {}};
+    const auto h_band = estimate_hessians(bf, x, hs_band);
+    BOOST_CHECK(n_evals <= 4u * 3u * 20u);
+    for (decltype(h_band[0].size()) k = 0; k < h_band[0].size(); ++k) {
+        BOOST_CHECK_SMALL(h_band[0][k] - exact[0][k], 1e-5);
+    }
+    BOOST_CHECK(h_band[1].empty() && h_band[2].empty());
+    // Arrowhead hessian only: two colours suffice.
+    n_evals = 0;
+    std::vector<sparsity_pattern> hs_arrow{{}, udp.hessians_sparsity()[1], {}};
+    const auto h_arrow = estimate_hessians(bf, x, hs_arrow);
+    BOOST_CHECK_EQUAL(n_evals, 4u * 2u * 20u);
+    for (decltype(h_arrow[1].size()) k = 0; k < h_arrow[1].size(); ++k) {
+        BOOST_CHECK_SMALL(h_arrow[1][k] - exact[1][k], 1e-5);
+    }
+    // Dense patterns are estimated correctly as well.
+    std::vector<sparsity_pattern> hs_dense(3u);
+    for (vector_double::size_type i = 0; i < 20u; ++i) {
+        for (vector_double::size_type j = 0; j <= i; ++j) {
+            hs_dense[0].emplace_back(i, j);
+            hs_dense[1].emplace_back(i, j);
+        }
+    }
+    const auto h_dense = estimate_hessians(bf, x, hs_dense);
+    const auto sp = udp.hessians_sparsity();
+    for (decltype(hs_dense[0].size()) k = 0; k < hs_dense[0].size(); ++k) {
+        for (auto i : {0u, 1u}) {
+            const auto it = std::find(sp[i].begin(), sp[i].end(), hs_dense[i][k]);
+            const auto val = (it == sp[i].end()) ? 0. : exact[i][static_cast<unsigned>(it - sp[i].begin())];
+            BOOST_CHECK_SMALL(h_dense[i][k] - val, 1e-5);
+        }
+    }
+    // Empty patterns: no evaluations.
+    n_evals = 0;
+    const auto h_empty = estimate_hessians(bf, x, std::vector<sparsity_pattern>(3u));
+    BOOST_CHECK_EQUAL(n_evals, 0u);
+    BOOST_CHECK((h_empty == std::vector<vector_double>(3u)));
+    // Invalid patterns.
+    BOOST_CHECK_THROW(estimate_hessians(bf, x, std::vector<sparsity_pattern>{{{0u, 1u}}, {}, {}}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(estimate_hessians(bf, x, std::vector<sparsity_pattern>{{{20u, 0u}}, {}, {}}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(estimate_hessians(bf, x, std::vector<sparsity_pattern>{{{0u, 0u}}}), std::invalid_argument);
+    // Problem overload, evaluated in parallel.
+    problem p{udp};
+    thread_bfe tbfe{4u};
+    check(estimate_hessians(p, x, tbfe));
+    BOOST_CHECK(p.get_fevals() > 0u);
+    BOOST_CHECK_THROW(estimate_hessians(p, vector_double(3u), tbfe), std::invalid_argument);
+}
@@ -31,25 +31,41 @@ see https://www.gnu.org/licenses/. */
 
 #include <atomic>
 #include <boost/lexical_cast.hpp>
+#include <chrono>
 #include <initializer_list>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <pagmo/algorithms/bee_colony.hpp>
+#include <pagmo/algorithms/cmaes.hpp>
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/algorithms/de1220.hpp>
+#include <pagmo/algorithms/ihs.hpp>
+#include <pagmo/algorithms/moead.hpp>
+#include <pagmo/algorithms/nsga2.hpp>
+#include <pagmo/algorithms/pso.hpp>
+#include <pagmo/algorithms/pso_gen.hpp>
+#include <pagmo/algorithms/sade.hpp>
+#include <pagmo/algorithms/sga.hpp>
+#include <pagmo/algorithms/xnes.hpp>
 #include <pagmo/config.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/island.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
 #include <pagmo/serialization.hpp>
+#include <pagmo/stop_token.hpp>
 #include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
+#include <pagmo/utils/multi_objective.hpp>
 
 using namespace pagmo;
 
@@ -449,3 +465,196 @@ BOOST_AUTO_TEST_CASE(island_extract)
     BOOST_CHECK(isl.is<udi_01>());
     BOOST_CHECK(isl.extract<const udi_01>() == nullptr);
 }
+
+BOOST_AUTO_TEST_CASE(island_snapshots)
+{
+    island isl{de{}, rosenbrock{}, 27, 123};
+    // Snapshots do not copy, and they are not affected by later modifications of the island.
+    auto pop_s = isl.get_population_snapshot();
+    auto algo_s = isl.get_algorithm_snapshot();
+    BOOST_CHECK(pop_s == isl.get_population_snapshot());
+    BOOST_CHECK(algo_s == isl.get_algorithm_snapshot());
+    const auto old_x = pop_s->get_x();
+    BOOST_CHECK(pop_s->size() == 27u);
+    BOOST_CHECK(algo_s->is<de>());
+    isl.set_population(population{rosenbrock{}, 10});
+    isl.set_algorithm(algorithm{sade{}});
+    BOOST_CHECK(pop_s != isl.get_population_snapshot());
+    BOOST_CHECK(pop_s->size() == 27u);
+    BOOST_CHECK(pop_s->get_x() == old_x);
+    BOOST_CHECK(algo_s->is<de>());
+    // Visitor API.
+    BOOST_CHECK(isl.read_population([](const population &p) { return p.size(); }) == 10u);
+    BOOST_CHECK(isl.read_algorithm([](const algorithm &a) { return a.is<sade>(); }));
+    const auto cf = isl.read_population([](const population &p) { return p.champion_f(); });
+    BOOST_CHECK((std::is_same<decltype(cf), const vector_double>::value));
+    BOOST_CHECK(cf == isl.get_population().champion_f());
+    auto n = 0;
+    isl.read_population([&n](const population &p) { n = static_cast<int>(p.size()); });
+    BOOST_CHECK(n == 10);
+    // Evolution publishes a new population, leaving old snapshots alone.
+    pop_s = isl.get_population_snapshot();
+    const auto old_f = pop_s->get_f();
+    isl.evolve(3);
+    isl.wait_check();
+    BOOST_CHECK(pop_s != isl.get_population_snapshot());
+    BOOST_CHECK(pop_s->get_f() == old_f);
+    // Concurrent readers and writers.
+    std::atomic<bool> ok(true);
+    auto thread_func = [&isl, &ok]() {
+        for (auto i = 0; i < 100; ++i) {
+            auto s = isl.get_population_snapshot();
+            if (isl.read_population([](const population &p) { return p.size(); }) != 10u) {
+                ok.store(false);
+            }
+            isl.set_population(*s);
+            isl.read_algorithm([](const algorithm &a) { return a.get_name(); });
+        }
+    };
+    isl.evolve(10);
+    std::thread t1(thread_func), t2(thread_func), t3(thread_func);
+    t1.join();
+    t2.join();
+    t3.join();
+    isl.wait_check();
+    BOOST_CHECK(ok.load());
+}
+
+BOOST_AUTO_TEST_CASE(island_champion_record)
+{
+    island isl{de{}, rosenbrock{}, 20, 123};
+    auto c0 = isl.get_champion();
+    BOOST_CHECK(c0->has_champion);
+    BOOST_CHECK(c0->n_evolve == 0u);
+    BOOST_CHECK(c0->x == isl.get_population().champion_x());
+    BOOST_CHECK(c0->f == isl.get_population().champion_f());
+    BOOST_CHECK(c0->nd_x.empty() && c0->nd_f.empty());
+    isl.evolve(3);
+    isl.wait_check();
+    auto c1 = isl.get_champion();
+    BOOST_CHECK(c1->n_evolve == 3u);
+    BOOST_CHECK(c1->timestamp >= c0->timestamp);
+    BOOST_CHECK(c1->f == isl.get_population().champion_f());
+    BOOST_CHECK(c1->f[0] <= c0->f[0]);
+    // Old records are not modified.
+    BOOST_CHECK(c0->n_evolve == 0u);
+    // set_population() publishes a new record, keeping the counter.
+    isl.set_population(population{rosenbrock{5}, 10});
+    auto c2 = isl.get_champion();
+    BOOST_CHECK(c2->n_evolve == 3u);
+    BOOST_CHECK(c2->x.size() == 5u);
+    BOOST_CHECK(c2->x == isl.get_population().champion_x());
+    // Multi-objective.
+    isl.set_population(population{zdt{1, 5}, 30});
+    auto c3 = isl.get_champion();
+    BOOST_CHECK(!c3->has_champion);
+    BOOST_CHECK(c3->x.empty() && c3->f.empty());
+    BOOST_CHECK(!c3->nd_x.empty());
+    BOOST_CHECK(c3->nd_x.size() == c3->nd_f.size());
+    const auto pop = isl.get_population();
+    const auto front = std::get<0>(fast_non_dominated_sorting(pop.get_f()))[0];
+    BOOST_CHECK(front.size() == c3->nd_f.size());
+    for (const auto &f : c3->nd_f) {
+        for (const auto &g : pop.get_f()) {
+            BOOST_CHECK(!pareto_dominance(g, f));
+        }
+    }
+    // Copies and deserialised islands restart the counter.
+    island isl2(isl);
+    BOOST_CHECK(isl2.get_champion()->n_evolve == 0u);
+    BOOST_CHECK(isl2.get_champion()->nd_f == c3->nd_f);
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(isl);
+    }
+    island isl3;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(isl3);
+    }
+    BOOST_CHECK(isl3.get_champion()->nd_f == c3->nd_f);
+    // Empty population.
+    isl.set_population(population{rosenbrock{}});
+    BOOST_CHECK(isl.get_champion()->has_champion);
+    BOOST_CHECK(isl.get_champion()->x.empty());
+}
+
+// An algorithm which runs until a stop is requested.
+struct wait_stop_algo {
+    population evolve(const population &pop) const
+    {
+        ++n_started;
+        while (!stop_requested()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return pop;
+    }
+    static std::atomic<unsigned> n_started;
+};
+
+std::atomic<unsigned> wait_stop_algo::n_started{0};
+
+BOOST_AUTO_TEST_CASE(island_cancel)
+{
+    BOOST_CHECK(!stop_requested());
+    island isl(thread_island{}, wait_stop_algo{}, rosenbrock{}, 10);
+    // Cancel the running task and the pending ones.
+    isl.evolve(3);
+    isl.evolve();
+    while (!wait_stop_algo::n_started.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    isl.cancel();
+    BOOST_CHECK_NO_THROW(isl.wait_check());
+    BOOST_CHECK_EQUAL(wait_stop_algo::n_started.load(), 1u);
+    BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 1u);
+    BOOST_CHECK(!stop_requested());
+    // The tasks enqueued after the cancellation are not affected.
+    isl.set_algorithm(algorithm{de{1}});
+    isl.evolve(2);
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 3u);
+    // Cancelling an idle island does nothing.
+    isl.cancel();
+    isl.evolve();
+    isl.wait_check();
+    BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 4u);
+}
+
+BOOST_AUTO_TEST_CASE(island_evolve_for)
+{
+    {
+        // run_evolve() is called repeatedly until the deadline.
+        island isl(thread_island{}, de{1}, rosenbrock{}, 10);
+        isl.evolve_for(std::chrono::milliseconds(50));
+        isl.wait_check();
+        BOOST_CHECK(isl.get_champion()->n_evolve > 0u);
+        // No evolution after the deadline.
+        isl.evolve_for(std::chrono::milliseconds(-1));
+        const auto n = isl.get_champion()->n_evolve;
+        isl.wait_check();
+        BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, n);
+    }
+    // The generation loops of the algorithms support cooperative cancellation.
+    const auto gen = 1000000000u;
+    const std::vector<std::pair<algorithm, problem>> algos{
+        {algorithm{de{gen}}, problem{rosenbrock{10}}},        {algorithm{sade{gen}}, problem{rosenbrock{10}}},
+        {algorithm{de1220{gen}}, problem{rosenbrock{10}}},    {algorithm{pso{gen}}, problem{rosenbrock{10}}},
+        {algorithm{pso_gen{gen}}, problem{rosenbrock{10}}},   {algorithm{cmaes{gen}}, problem{rosenbrock{10}}},
+        {algorithm{xnes{gen}}, problem{rosenbrock{10}}},      {algorithm{sga{gen}}, problem{rosenbrock{10}}},
+        {algorithm{bee_colony{gen}}, problem{rosenbrock{10}}}, {algorithm{ihs{gen}}, problem{rosenbrock{10}}},
+        {algorithm{nsga2{gen}}, problem{zdt{1, 10}}},         {algorithm{moead{gen}}, problem{zdt{1, 10}}}};
+    for (const auto &p : algos) {
+        island isl(thread_island{}, p.first, p.second, 20);
+        const auto old_fevals = isl.get_population().get_problem().get_fevals();
+        const auto start = std::chrono::steady_clock::now();
+        isl.evolve_for(std::chrono::milliseconds(20));
+        isl.wait_check();
+        BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(60));
+        BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 1u);
+        // The best-so-far population was inserted into the island.
+        BOOST_CHECK(isl.get_population().get_problem().get_fevals() >= old_fevals);
+        BOOST_CHECK_EQUAL(isl.get_population().size(), 20u);
+    }
+}
@@ -0,0 +1,169 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE latency_histogram_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <pagmo/latency_histogram.hpp>
+#include <pagmo/serialization.hpp>
+
+using namespace pagmo;
+using ns = latency_histogram::duration;
+
+BOOST_AUTO_TEST_CASE(latency_histogram_basic_test)
+{
+    const std::size_t n_buckets = latency_histogram::n_buckets;
+    latency_histogram h;
+    BOOST_CHECK_EQUAL(h.get_count(), 0u);
+    BOOST_CHECK(h.get_total() == ns(0));
+    for (auto c : h.get_counts()) {
+        BOOST_CHECK_EQUAL(c, 0u);
+    }
+    BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(h), "Number of calls: 0");
+    // Bucket bounds.
+    BOOST_CHECK(latency_histogram::get_bucket_bounds(0) == std::make_pair(ns(0), ns(2)));
+    BOOST_CHECK(latency_histogram::get_bucket_bounds(1) == std::make_pair(ns(2), ns(4)));
+    BOOST_CHECK(latency_histogram::get_bucket_bounds(10) == std::make_pair(ns(1024), ns(2048)));
+    BOOST_CHECK(latency_histogram::get_bucket_bounds(n_buckets - 1u).second == ns::max());
+    BOOST_CHECK_THROW(latency_histogram::get_bucket_bounds(n_buckets), std::out_of_range);
+    // Recording.
+    h.record(ns(0));
+    h.record(ns(-5));
+    h.record(ns(1));
+    h.record(ns(2));
+    h.record(ns(3), 2u);
+    h.record(ns(1500));
+    h.record(std::chrono::hours(1));
+    auto counts = h.get_counts();
+    BOOST_CHECK_EQUAL(counts[0], 3u);
+    BOOST_CHECK_EQUAL(counts[1], 3u);
+    BOOST_CHECK_EQUAL(counts[10], 1u);
+    BOOST_CHECK_EQUAL(counts[n_buckets - 1u], 1u);
+    BOOST_CHECK_EQUAL(h.get_count(), 8u);
+    BOOST_CHECK(h.get_total() == ns(1 + 2 + 6 + 1500) + std::chrono::hours(1));
+    const auto str = boost::lexical_cast<std::string>(h);
+    BOOST_CHECK(str.find("Number of calls: 8") != std::string::npos);
+    BOOST_CHECK(str.find("[1024, 2048) ns: 1") != std::string::npos);
+    BOOST_CHECK(str.find("inf) ns: 1") != std::string::npos);
+    // Copy and reset.
+    auto h2(h);
+    BOOST_CHECK(h2.get_counts() == h.get_counts());
+    h.reset();
+    BOOST_CHECK_EQUAL(h.get_count(), 0u);
+    BOOST_CHECK_EQUAL(h2.get_count(), 8u);
+    h = h2;
+    BOOST_CHECK(h.get_counts() == counts);
+    BOOST_CHECK(h.get_total() == h2.get_total());
+}
+
+BOOST_AUTO_TEST_CASE(latency_histogram_concurrency_test)
+{
+    latency_histogram h;
+    std::atomic<bool> stop(false);
+    // Read while recording.
+    std::thread reader([&h, &stop]() {
+        while (!stop.load()) {
+            const auto c = h.get_count();
+            (void)c;
+        }
+    });
+    std::vector<std::thread> writers;
+    for (auto i = 0; i < 4; ++i) {
+        writers.emplace_back([&h, i]() {
+            for (auto j = 0; j < 10000; ++j) {
+                h.record(ns(1 << i));
+            }
+        });
+    }
+    for (auto &t : writers) {
+        t.join();
+    }
+    stop.store(true);
+    reader.join();
+    BOOST_CHECK_EQUAL(h.get_count(), 40000u);
+    const auto counts = h.get_counts();
+    for (auto i = 0; i < 4; ++i) {
+        BOOST_CHECK_EQUAL(counts[static_cast<std::size_t>(i)], 10000u);
+    }
+    BOOST_CHECK(h.get_total() == ns(150000));
+}
+
+// Same archive layout as a latency histogram, but with a wrong number of buckets.
+struct wrong_hist {
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_counts, m_count, m_total);
+    }
+    std::vector<unsigned long long> m_counts = std::vector<unsigned long long>(3u);
+    unsigned long long m_count = 1u;
+    unsigned long long m_total = 1u;
+};
+
+BOOST_AUTO_TEST_CASE(latency_histogram_serialization_test)
+{
+    latency_histogram h;
+    h.record(ns(7));
+    h.record(ns(123456), 3u);
+    const auto counts = h.get_counts();
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(h);
+    }
+    h.reset();
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(h);
+    }
+    BOOST_CHECK(h.get_counts() == counts);
+    BOOST_CHECK_EQUAL(h.get_count(), 4u);
+    BOOST_CHECK(h.get_total() == ns(7 + 3 * 123456));
+    // Wrong number of buckets.
+    std::stringstream ss2;
+    {
+        cereal::JSONOutputArchive oarchive(ss2);
+        oarchive(wrong_hist{});
+    }
+    {
+        cereal::JSONInputArchive iarchive(ss2);
+        BOOST_CHECK_THROW(iarchive(h), std::invalid_argument);
+    }
+    BOOST_CHECK_EQUAL(h.get_count(), 4u);
+}
@@ -0,0 +1,270 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE memoize_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/memoize.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A simple UDP which counts (in a non thread-safe way) its own fitness and batch fitness calls.
+struct count_p {
+    vector_double fitness(const vector_double &x) const
+    {
+        ++n_calls;
+        return {x[0] + 2. * x[1]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-10., -10.}, {10., 10.}};
+    }
+    void set_seed(unsigned s)
+    {
+        m_seed = s;
+    }
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_seed);
+    }
+    mutable unsigned n_calls = 0;
+    unsigned m_seed = 0;
+};
+
+PAGMO_REGISTER_PROBLEM(count_p)
+
+// Same as above, with batch fitness.
+struct count_bp : count_p {
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        ++n_batch_calls;
+        vector_double retval;
+        for (decltype(dvs.size()) i = 0; i < dvs.size(); i += 2u) {
+            retval.push_back(fitness({dvs[i], dvs[i + 1u]})[0]);
+        }
+        return retval;
+    }
+    mutable unsigned n_batch_calls = 0;
+};
+
+BOOST_AUTO_TEST_CASE(memoize_construction_test)
+{
+    problem p0{memoize{}};
+    problem p1{memoize{null_problem{}}};
+    BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(p0), boost::lexical_cast<std::string>(p1));
+    BOOST_CHECK(p0.get_name() == "Null problem [memoized]");
+    memoize m{rosenbrock{3u}, 10u, .5};
+    BOOST_CHECK_EQUAL(m.get_capacity(), 10u);
+    BOOST_CHECK_EQUAL(m.get_quantum(), .5);
+    BOOST_CHECK_EQUAL(m.get_cache_size(), 0u);
+    BOOST_CHECK_EQUAL(m.get_hits(), 0u);
+    BOOST_CHECK_EQUAL(m.get_misses(), 0u);
+    BOOST_CHECK(m.get_inner_problem().is<rosenbrock>());
+    // Copy of a non-const lvalue does not wrap again.
+    memoize m2(m);
+    BOOST_CHECK(m2.get_inner_problem().is<rosenbrock>());
+    // Construction from a problem.
+    problem p2{memoize{problem{hock_schittkowsky_71{}}}};
+    BOOST_CHECK(p2.extract<memoize>()->get_inner_problem().is<hock_schittkowsky_71>());
+    BOOST_CHECK_EQUAL(p2.get_nec(), 1u);
+    BOOST_CHECK_EQUAL(p2.get_nic(), 1u);
+    BOOST_CHECK(p2.has_gradient());
+    BOOST_CHECK(p2.has_hessians());
+    BOOST_CHECK(p2.has_batch_fitness());
+    BOOST_CHECK(p2.get_thread_safety() == thread_safety::basic);
+    BOOST_CHECK(p2.get_extra_info().find("Cache capacity: 1000") != std::string::npos);
+    // Invalid arguments.
+    BOOST_CHECK_THROW((memoize{rosenbrock{}, 0u}), std::invalid_argument);
+    BOOST_CHECK_THROW((memoize{rosenbrock{}, 10u, -1.}), std::invalid_argument);
+    BOOST_CHECK_THROW((memoize{rosenbrock{}, 10u, std::numeric_limits<double>::infinity()}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW((memoize{rosenbrock{}, 10u, std::numeric_limits<double>::quiet_NaN()}),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(memoize_fitness_test)
+{
+    problem p{memoize{count_p{}, 2u}};
+    auto &inner = *p.extract<memoize>()->get_inner_problem().extract<count_p>();
+    BOOST_CHECK(p.fitness({1., 2.}) == vector_double{5.});
+    BOOST_CHECK(p.fitness({1., 2.}) == vector_double{5.});
+    BOOST_CHECK_EQUAL(inner.n_calls, 1u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_inner_problem().get_fevals(), 1u);
+    p.fitness({2., 2.});
+    BOOST_CHECK_EQUAL(inner.n_calls, 2u);
+    // Touch {1, 2}, so that {2, 2} becomes the least recently used entry.
+    p.fitness({1., 2.});
+    p.fitness({3., 2.});
+    BOOST_CHECK_EQUAL(inner.n_calls, 3u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_cache_size(), 2u);
+    p.fitness({1., 2.});
+    BOOST_CHECK_EQUAL(inner.n_calls, 3u);
+    p.fitness({2., 2.});
+    BOOST_CHECK_EQUAL(inner.n_calls, 4u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_hits(), 3u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_misses(), 4u);
+    // NaNs are cached as well.
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    BOOST_CHECK(std::isnan(p.fitness({nan, 1.})[0]));
+    BOOST_CHECK(std::isnan(p.fitness({nan, 1.})[0]));
+    BOOST_CHECK_EQUAL(inner.n_calls, 5u);
+    // Clearing the cache keeps the statistics.
+    p.extract<memoize>()->clear_cache();
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_cache_size(), 0u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_misses(), 5u);
+    p.fitness({1., 2.});
+    BOOST_CHECK_EQUAL(inner.n_calls, 6u);
+    // Setting the seed clears the cache.
+    BOOST_CHECK(p.is_stochastic());
+    p.set_seed(42u);
+    BOOST_CHECK_EQUAL(inner.m_seed, 42u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_cache_size(), 0u);
+    // The gradient and hessians bypass the cache.
+    problem p2{memoize{hock_schittkowsky_71{}}};
+    BOOST_CHECK(p2.gradient({1., 2., 3., 4.}) == hock_schittkowsky_71{}.gradient({1., 2., 3., 4.}));
+    BOOST_CHECK(p2.hessians({1., 2., 3., 4.}) == hock_schittkowsky_71{}.hessians({1., 2., 3., 4.}));
+    BOOST_CHECK(p2.gradient_sparsity() == problem{hock_schittkowsky_71{}}.gradient_sparsity());
+    BOOST_CHECK(p2.hessians_sparsity() == problem{hock_schittkowsky_71{}}.hessians_sparsity());
+    BOOST_CHECK_EQUAL(p2.extract<memoize>()->get_cache_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(memoize_quantum_test)
+{
+    problem p{memoize{count_p{}, 10u, .1}};
+    auto &inner = *p.extract<memoize>()->get_inner_problem().extract<count_p>();
+    const auto f0 = p.fitness({1., 1.});
+    BOOST_CHECK(p.fitness({1.01, 0.99}) == f0);
+    BOOST_CHECK_EQUAL(inner.n_calls, 1u);
+    BOOST_CHECK(p.fitness({1.2, 1.}) != f0);
+    BOOST_CHECK_EQUAL(inner.n_calls, 2u);
+    BOOST_CHECK(p.get_extra_info().find("Key quantum") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(memoize_batch_test)
+{
+    problem p{memoize{count_bp{}, 3u}};
+    auto &inner = *p.extract<memoize>()->get_inner_problem().extract<count_bp>();
+    p.fitness({1., 1.});
+    // One cached entry, one duplicate within the batch and two new entries.
+    const auto fvs = p.batch_fitness({1., 1., 2., 0., 2., 0., 0., 3.});
+    BOOST_CHECK((fvs == vector_double{3., 2., 2., 6.}));
+    BOOST_CHECK_EQUAL(inner.n_batch_calls, 1u);
+    BOOST_CHECK_EQUAL(inner.n_calls, 3u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_hits(), 2u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_misses(), 3u);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 5u);
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_inner_problem().get_fevals(), 3u);
+    // All cached now: no call to the inner problem.
+    BOOST_CHECK((p.batch_fitness({0., 3., 2., 0.}) == vector_double{6., 2.}));
+    BOOST_CHECK_EQUAL(inner.n_batch_calls, 1u);
+    // The capacity is honoured.
+    p.batch_fitness({4., 0., 5., 0., 6., 0., 7., 0.});
+    BOOST_CHECK_EQUAL(p.extract<memoize>()->get_cache_size(), 3u);
+    BOOST_CHECK_EQUAL(inner.n_batch_calls, 2u);
+    // The last entries of the batch are the most recently used ones.
+    p.batch_fitness({5., 0., 6., 0., 7., 0.});
+    BOOST_CHECK_EQUAL(inner.n_batch_calls, 2u);
+    // Inner problem without batch fitness.
+    problem p2{memoize{count_p{}}};
+    BOOST_CHECK((p2.batch_fitness({1., 1., 1., 1., 0., 1.}) == vector_double{3., 3., 2.}));
+    BOOST_CHECK_EQUAL(p2.extract<memoize>()->get_inner_problem().extract<count_p>()->n_calls, 2u);
+    BOOST_CHECK((p2.batch_fitness({}) == vector_double{}));
+}
+
+BOOST_AUTO_TEST_CASE(memoize_copy_test)
+{
+    memoize m{count_p{}, 3u};
+    m.fitness({1., 1.});
+    m.fitness({2., 1.});
+    m.fitness({3., 1.});
+    m.fitness({1., 1.});
+    auto m2(m);
+    BOOST_CHECK_EQUAL(m2.get_cache_size(), 3u);
+    BOOST_CHECK_EQUAL(m2.get_hits(), 1u);
+    // The LRU order is preserved: {2, 1} is evicted first.
+    m2.fitness({4., 1.});
+    m2.fitness({1., 1.});
+    m2.fitness({3., 1.});
+    BOOST_CHECK_EQUAL(m2.get_misses(), 4u);
+    m2.fitness({2., 1.});
+    BOOST_CHECK_EQUAL(m2.get_misses(), 5u);
+    // The original is unaffected.
+    BOOST_CHECK_EQUAL(m.get_misses(), 3u);
+    m2 = m;
+    BOOST_CHECK_EQUAL(m2.get_misses(), 3u);
+    auto m3(std::move(m2));
+    m3.fitness({2., 1.});
+    BOOST_CHECK_EQUAL(m3.get_misses(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(memoize_serialization_test)
+{
+    problem p{memoize{count_p{}, 3u, .5}};
+    p.fitness({1., 1.});
+    p.fitness({2., 1.});
+    p.fitness({3., 1.});
+    p.fitness({1., 1.});
+    std::stringstream ss;
+    auto before = boost::lexical_cast<std::string>(p);
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(p);
+    }
+    p = problem{null_problem{}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(p);
+    }
+    auto after = boost::lexical_cast<std::string>(p);
+    BOOST_CHECK_EQUAL(before, after);
+    auto &m = *p.extract<memoize>();
+    BOOST_CHECK_EQUAL(m.get_quantum(), .5);
+    BOOST_CHECK_EQUAL(m.get_cache_size(), 3u);
+    // The LRU order survives the round trip.
+    m.fitness({4., 1.});
+    m.fitness({1., 1.});
+    m.fitness({3., 1.});
+    BOOST_CHECK_EQUAL(m.get_misses(), 4u);
+}
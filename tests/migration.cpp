@@ -0,0 +1,300 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE migration_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de.hpp>
+#include <pagmo/archipelago.hpp>
+#include <pagmo/island.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problems/hock_schittkowsky_71.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/r_policies/fair_replace.hpp>
+#include <pagmo/r_policy.hpp>
+#include <pagmo/s_policies/select_best.hpp>
+#include <pagmo/s_policy.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/topologies/free_form.hpp>
+#include <pagmo/topologies/fully_connected.hpp>
+#include <pagmo/topologies/ring.hpp>
+#include <pagmo/topology.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A UDSP returning malformed groups.
+struct bad_select {
+    individuals_group_t select(const population &) const
+    {
+        return individuals_group_t{{1u}, {}, {}};
+    }
+};
+
+// A UDSP selecting nothing.
+struct select_none {
+    individuals_group_t select(const population &) const
+    {
+        return {};
+    }
+};
+
+// A UDT connecting every vertex to a nonexistent one.
+struct udt_out_of_range {
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t) const
+    {
+        return {{100u}, {1.}};
+    }
+    void push_back() {}
+};
+
+// A UDA which does nothing, used to observe migration in isolation.
+struct no_evolve {
+    population evolve(const population &pop) const
+    {
+        return pop;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(s_policy_basic)
+{
+    BOOST_CHECK(is_udsp<select_best>::value);
+    BOOST_CHECK(!is_udsp<fair_replace>::value);
+    BOOST_CHECK(!is_udsp<int>::value);
+    BOOST_CHECK_THROW(select_best{-1}, std::invalid_argument);
+    BOOST_CHECK_THROW(select_best{1.5}, std::invalid_argument);
+    s_policy s;
+    BOOST_CHECK(s.is<select_best>());
+    BOOST_CHECK_EQUAL(s.get_name(), "Select best");
+    population pop{rosenbrock{4u}, 20u, 1u};
+    // Absolute rate.
+    auto g = s_policy{select_best{3u}}.select(pop);
+    BOOST_CHECK_EQUAL(std::get<0>(g).size(), 3u);
+    BOOST_CHECK(std::get<1>(g)[0] == pop.champion_x());
+    BOOST_CHECK(std::get<2>(g)[0] <= std::get<2>(g)[1] && std::get<2>(g)[1] <= std::get<2>(g)[2]);
+    BOOST_CHECK_EQUAL(std::get<0>(g)[0], pop.get_ID()[pop.best_idx()]);
+    // Fractional rate.
+    BOOST_CHECK_EQUAL(std::get<0>(s_policy{select_best{.5}}.select(pop)).size(), 10u);
+    BOOST_CHECK_EQUAL(std::get<0>(s_policy{select_best{100}}.select(pop)).size(), 20u);
+    BOOST_CHECK(std::get<0>(s_policy{select_best{0.}}.select(pop)).empty());
+    // Constrained and multi-objective.
+    population cpop{hock_schittkowsky_71{}, 10u, 2u};
+    BOOST_CHECK_EQUAL(std::get<0>(s_policy{select_best{2u}}.select(cpop)).size(), 2u);
+    population mpop{zdt{1u}, 10u, 3u};
+    BOOST_CHECK_EQUAL(std::get<0>(s_policy{select_best{4u}}.select(mpop)).size(), 4u);
+    // Output checks.
+    BOOST_CHECK_THROW(s_policy{bad_select{}}.select(pop), std::invalid_argument);
+    // Streaming and serialization.
+    std::ostringstream oss;
+    oss << s_policy{select_best{.25}};
+    BOOST_CHECK(oss.str().find("Fractional migration rate") != std::string::npos);
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(s_policy{select_best{.25}});
+    }
+    s_policy s2{select_best{1u}};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(s2);
+    }
+    BOOST_CHECK_EQUAL(std::get<0>(s2.select(pop)).size(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(r_policy_basic)
+{
+    BOOST_CHECK(is_udrp<fair_replace>::value);
+    BOOST_CHECK(!is_udrp<select_best>::value);
+    BOOST_CHECK_THROW(fair_replace{-2}, std::invalid_argument);
+    r_policy r;
+    BOOST_CHECK(r.is<fair_replace>());
+    BOOST_CHECK_EQUAL(r.get_name(), "Fair replace");
+    population pop{rosenbrock{4u}, 20u, 1u}, other{rosenbrock{4u}, 20u, 2u};
+    // Immigrants worse than everybody: nothing changes.
+    const auto worst = select_best{20u}.select(pop);
+    individuals_group_t bad{{std::get<0>(worst).back()}, {std::get<1>(worst).back()}, {{1E12}}};
+    auto pop2(pop);
+    r_policy{fair_replace{5u}}.replace(pop2, bad);
+    BOOST_CHECK(pop2.get_f() == pop.get_f());
+    // Immigrants better than everybody: at most 3 replacements, which remove the worst individuals.
+    individuals_group_t good{{1u, 2u, 3u, 4u}, {vector_double(4u, 1.), vector_double(4u, 1.), vector_double(4u, 1.),
+                             vector_double(4u, 1.)}, {{0.}, {0.}, {0.}, {0.}}};
+    pop2 = pop;
+    r_policy{fair_replace{3u}}.replace(pop2, good);
+    BOOST_CHECK_EQUAL(std::count(pop2.get_f().begin(), pop2.get_f().end(), vector_double{0.}), 3);
+    BOOST_CHECK(pop2.get_f()[pop.worst_idx()] == vector_double{0.});
+    BOOST_CHECK(pop2.champion_f() == vector_double{0.});
+    // IDs are preserved.
+    BOOST_CHECK(pop2.get_ID() == pop.get_ID());
+    // Mixed immigrants.
+    pop2 = pop;
+    r_policy{fair_replace{1.}}.replace(pop2, select_best{20u}.select(other));
+    auto merged = pop.get_f();
+    merged.insert(merged.end(), other.get_f().begin(), other.get_f().end());
+    std::sort(merged.begin(), merged.end());
+    merged.resize(20u);
+    auto fs = pop2.get_f();
+    std::sort(fs.begin(), fs.end());
+    BOOST_CHECK(fs == merged);
+    // Multi-objective: the population never gets worse.
+    population mpop{zdt{1u}, 10u, 3u}, mother{zdt{1u}, 10u, 4u};
+    r_policy{fair_replace{.5}}.replace(mpop, select_best{5u}.select(mother));
+    BOOST_CHECK_EQUAL(mpop.size(), 10u);
+    // Input checks.
+    BOOST_CHECK_THROW(r.replace(pop2, individuals_group_t{{1u}, {vector_double(3u, 1.)}, {{0.}}}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(r.replace(pop2, individuals_group_t{{1u}, {vector_double(4u, 1.)}, {}}),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_migration_async)
+{
+    archipelago archi{5u, de{10u}, rosenbrock{10u}, 20u, 7u};
+    BOOST_CHECK(archi.get_topology().is<unconnected>());
+    // No migration with the default topology.
+    archi.evolve(2);
+    archi.wait_check();
+    for (const auto &g : archi.get_migrants_db()) {
+        BOOST_CHECK(std::get<0>(g).empty());
+    }
+    archi.set_topology(topology{ring{}});
+    BOOST_CHECK_EQUAL(archi.get_topology().extract<ring>()->num_vertices(), 5u);
+    archi.push_back(de{10u}, rosenbrock{10u}, 20u);
+    BOOST_CHECK_EQUAL(archi.get_topology().extract<ring>()->num_vertices(), 6u);
+    for (auto &isl : archi) {
+        isl.set_s_policy(s_policy{select_best{2u}});
+        isl.set_r_policy(r_policy{fair_replace{2u}});
+    }
+    archi.evolve(10);
+    archi.wait_check();
+    for (const auto &g : archi.get_migrants_db()) {
+        BOOST_CHECK_EQUAL(std::get<0>(g).size(), 2u);
+    }
+    // Copy, stream and serialization preserve the topology and the policies.
+    archipelago archi2{archi};
+    BOOST_CHECK(archi2.get_topology().is<ring>());
+    BOOST_CHECK_EQUAL(archi2.get_topology().extract<ring>()->num_vertices(), 6u);
+    BOOST_CHECK(archi2[3].get_s_policy().get_extra_info() == s_policy{select_best{2u}}.get_extra_info());
+    std::ostringstream oss;
+    oss << archi2;
+    BOOST_CHECK(oss.str().find("Topology: Ring") != std::string::npos);
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(archi);
+    }
+    archipelago archi3;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(archi3);
+    }
+    BOOST_CHECK(archi3.get_topology().is<ring>());
+    BOOST_CHECK(archi3[5].get_r_policy().get_extra_info() == r_policy{fair_replace{2u}}.get_extra_info());
+    archi3.evolve(3);
+    archi3.wait_check();
+    // Errors in the policies are reported via wait_check().
+    archi3[0].set_s_policy(s_policy{bad_select{}});
+    archi3.evolve();
+    BOOST_CHECK_THROW(archi3.wait_check(), std::invalid_argument);
+    // A topology which does not match the archipelago.
+    archipelago archi4{2u, de{}, rosenbrock{}, 10u};
+    archi4.set_topology(topology{udt_out_of_range{}});
+    archi4.evolve();
+    BOOST_CHECK_THROW(archi4.wait_check(), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_migration_sync)
+{
+    // A one-way chain 0 -> 1 -> 2 -> 3 of islands which do not evolve: in synchronous mode,
+    // the champion of island 0 travels exactly one hop per round.
+    const population pop0{rosenbrock{3u}, 10u, 1u};
+    archipelago archi;
+    for (auto i = 0u; i < 4u; ++i) {
+        // The other islands contain only individuals worse than the champion of island 0.
+        population pop{rosenbrock{3u}};
+        for (auto j = 0u; j < 10u; ++j) {
+            pop.push_back(vector_double(3u, 5.), {1E6 + i + j});
+        }
+        archi.push_back(no_evolve{}, i ? pop : pop0);
+    }
+    free_form chain;
+    chain.add_edge(0, 1);
+    chain.add_edge(1, 2);
+    chain.add_edge(2, 3);
+    archi.set_topology(topology{chain});
+    const auto champ0 = pop0.champion_f();
+    // In the first round, the islands have nothing to import.
+    archi.evolve(2, migration_mode::synchronous);
+    archi.wait_check();
+    BOOST_CHECK(archi[1].get_population().champion_f() == champ0);
+    BOOST_CHECK(archi[2].get_population().champion_f() != champ0);
+    archi.evolve(1, migration_mode::synchronous);
+    archi.wait_check();
+    BOOST_CHECK(archi[2].get_population().champion_f() == champ0);
+    BOOST_CHECK(archi[3].get_population().champion_f() != champ0);
+    archi.evolve(1, migration_mode::synchronous);
+    archi.wait_check();
+    BOOST_CHECK(archi[3].get_population().champion_f() == champ0);
+    for (const auto &isl : archi) {
+        BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 4u);
+    }
+    // Zero rounds.
+    archi.evolve(0, migration_mode::synchronous);
+    archi.wait_check();
+    BOOST_CHECK(archi.status() == evolve_status::idle);
+    // Errors: the failing island skips the remaining rounds, the others complete them.
+    archi[1].set_s_policy(s_policy{bad_select{}});
+    archi.evolve(3, migration_mode::synchronous);
+    BOOST_CHECK_THROW(archi.wait_check(), std::invalid_argument);
+    BOOST_CHECK_EQUAL(archi[0].get_champion()->n_evolve, 7u);
+    BOOST_CHECK_EQUAL(archi[1].get_champion()->n_evolve, 5u);
+    // Many rounds on a larger, fully connected archipelago with a dedicated pool.
+    archipelago archi2{10u, de{5u}, rosenbrock{5u}, 20u, 3u};
+    archi2.set_topology(topology{fully_connected{}});
+    archi2.set_n_threads(3u);
+    for (auto &isl : archi2) {
+        isl.set_s_policy(s_policy{select_none{}});
+    }
+    archi2.evolve(20, migration_mode::synchronous);
+    archi2.evolve(5);
+    archi2.wait_check();
+    for (const auto &isl : archi2) {
+        BOOST_CHECK_EQUAL(isl.get_champion()->n_evolve, 25u);
+    }
+}
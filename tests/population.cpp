@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <type_traits>
 
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/hock_schittkowsky_71.hpp>
@@ -385,4 +386,104 @@ BOOST_AUTO_TEST_CASE(population_cout_test)
     BOOST_CHECK_NO_THROW(std::cout << pop);
     BOOST_CHECK_NO_THROW(std::cout << pop_sto);
     BOOST_CHECK_NO_THROW(std::cout << pop_mo);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(population_views_test)
+{
+    population pop{problem{zdt{1u, 5u}}, 7u, 23u};
+    const auto nx = pop.get_problem().get_nx(), nf = pop.get_problem().get_nf();
+    // The contiguous storage and the views agree with the vectors of vectors.
+    BOOST_CHECK_EQUAL(pop.get_x_data().size(), 7u * nx);
+    BOOST_CHECK_EQUAL(pop.get_f_data().size(), 7u * nf);
+    for (population::size_type i = 0u; i < pop.size(); ++i) {
+        BOOST_CHECK(pop.get_x_row(i).to_vector() == pop.get_x()[i]);
+        BOOST_CHECK(pop.get_f_row(i).to_vector() == pop.get_f()[i]);
+        BOOST_CHECK_EQUAL(pop.get_x_row(i).size(), nx);
+        BOOST_CHECK(pop.get_x_row(i).data() == pop.get_x_data().data() + i * nx);
+        BOOST_CHECK_EQUAL(pop.get_f_row(i)[1], pop.get_f()[i][1]);
+    }
+    for (vector_double::size_type j = 0u; j < nx; ++j) {
+        auto col = pop.get_x_column(j);
+        BOOST_CHECK_EQUAL(col.size(), 7u);
+        BOOST_CHECK_EQUAL(col.stride(), nx);
+        for (population::size_type i = 0u; i < pop.size(); ++i) {
+            BOOST_CHECK_EQUAL(col[i], pop.get_x()[i][j]);
+        }
+    }
+    BOOST_CHECK(pop.get_f_column(0u).to_vector().size() == 7u);
+    BOOST_CHECK_EQUAL(pop.get_f_column(1u)[3], pop.get_f()[3][1]);
+    BOOST_CHECK_THROW(pop.get_x_row(7u), std::invalid_argument);
+    BOOST_CHECK_THROW(pop.get_f_row(7u), std::invalid_argument);
+    BOOST_CHECK_THROW(pop.get_x_column(nx), std::invalid_argument);
+    BOOST_CHECK_THROW(pop.get_f_column(nf), std::invalid_argument);
+    // References returned by get_x()/get_f() are kept up to date by the modifiers.
+    const auto &x = pop.get_x();
+    const auto &f = pop.get_f();
+    pop.set_xf(2u, vector_double(nx, 0.5), {1., 2.});
+    BOOST_CHECK(x[2] == vector_double(nx, 0.5));
+    BOOST_CHECK((f[2] == vector_double{1., 2.}));
+    BOOST_CHECK_EQUAL(pop.get_x_column(3u)[2], 0.5);
+    pop.push_back(vector_double(nx, 0.25), {3., 4.});
+    BOOST_CHECK_EQUAL(x.size(), 8u);
+    BOOST_CHECK((f.back() == vector_double{3., 4.}));
+    BOOST_CHECK_EQUAL(pop.get_f_row(7u)[1], 4.);
+    // After assignment, the vectors of vectors are rebuilt on access.
+    pop = population{problem{zdt{1u, 5u}}, 3u, 24u};
+    BOOST_CHECK_EQUAL(pop.get_x().size(), 3u);
+    BOOST_CHECK(&pop.get_x() == &x);
+    BOOST_CHECK(x[1] == pop.get_x_row(1u).to_vector());
+    // Copies are independent.
+    auto pop2(pop);
+    pop2.set_xf(0u, vector_double(nx, 0.75), {5., 6.});
+    BOOST_CHECK(pop.get_x()[0] != pop2.get_x()[0]);
+    BOOST_CHECK(pop2.get_x()[0] == vector_double(nx, 0.75));
+}
+
+BOOST_AUTO_TEST_CASE(population_append_test)
+{
+    auto same = [](const population &a, const population &b) {
+        return a.get_ID() == b.get_ID() && a.get_x_data() == b.get_x_data() && a.get_f_data() == b.get_f_data();
+    };
+    for (const auto &prob : {problem{rosenbrock{4u}}, problem{hock_schittkowsky_71{}}, problem{zdt{1u, 4u}}}) {
+        // The parallel constructor gives the same population as the serial one.
+        population pop{prob, 50u, 42u}, pop_bfe{prob, 50u, thread_bfe{3u}, 42u};
+        BOOST_CHECK(same(pop, pop_bfe));
+        BOOST_CHECK_EQUAL(pop_bfe.get_problem().get_fevals(), 50u);
+        if (prob.get_nobj() == 1u) {
+            BOOST_CHECK(pop.champion_x() == pop_bfe.champion_x());
+            BOOST_CHECK(pop.champion_f() == pop_bfe.champion_f());
+        }
+        // Appending a batch is the same as a sequence of push_back().
+        population pop0{prob, 0u, 43u}, pop1{prob, 0u, 43u}, pop2{prob, 0u, 43u}, pop3{prob, 0u, 43u},
+            pop_rnd{prob, 0u, 44u};
+        vector_double dvs;
+        for (auto i = 0; i < 20; ++i) {
+            const auto x = pop_rnd.random_decision_vector();
+            dvs.insert(dvs.end(), x.begin(), x.end());
+            pop0.push_back(x);
+        }
+        pop1.append(dvs);
+        pop2.append(dvs, thread_bfe{});
+        pop3.append(dvs, prob.batch_fitness(dvs));
+        BOOST_CHECK(same(pop0, pop1));
+        BOOST_CHECK(same(pop0, pop2));
+        BOOST_CHECK(same(pop0, pop3));
+        if (prob.get_nobj() == 1u) {
+            BOOST_CHECK(pop0.champion_x() == pop1.champion_x());
+            BOOST_CHECK(pop0.champion_f() == pop3.champion_f());
+        }
+        // The vector of vectors representation is kept up to date.
+        const auto &x = pop1.get_x();
+        pop1.append(vector_double(dvs.begin(), dvs.begin() + static_cast<std::ptrdiff_t>(prob.get_nx())));
+        BOOST_CHECK_EQUAL(x.size(), 21u);
+        BOOST_CHECK(x.back() == x[0]);
+        // Empty batches.
+        pop1.append(vector_double{});
+        BOOST_CHECK_EQUAL(pop1.size(), 21u);
+        // Errors leave the population untouched.
+        BOOST_CHECK_THROW(pop1.append(vector_double(prob.get_nx() + 1u, 1.)), std::invalid_argument);
+        BOOST_CHECK_THROW(pop1.append(dvs, vector_double(prob.get_nf() * 20u + 1u)), std::invalid_argument);
+        BOOST_CHECK_THROW(pop1.append(dvs, vector_double(prob.get_nf() * 19u)), std::invalid_argument);
+        BOOST_CHECK_EQUAL(pop1.size(), 21u);
+        BOOST_CHECK_EQUAL(pop1.get_x_data().size(), 21u * prob.get_nx());
+    }
+}
@@ -33,14 +33,17 @@ see https://www.gnu.org/licenses/. */
 
 #include <boost/lexical_cast.hpp>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <pagmo/exceptions.hpp>
+#include <pagmo/latency_histogram.hpp>
 #include <pagmo/serialization.hpp>
 #include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
@@ -537,6 +540,162 @@ BOOST_AUTO_TEST_CASE(problem_fitness_test)
     BOOST_CHECK((p1.fitness({3, 3}) == vector_double{12, 13, 14, 15, 16, 17}));
 }
 
+// A problem whose fitness is the sum and the product of the decision vector,
+// optionally implementing batch fitness evaluation.
+struct bf_p {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + x[1], x[0] * x[1]};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0, 0}, {1, 1}};
+    }
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        vector_double retval;
+        for (decltype(dvs.size()) i = 0; i < dvs.size(); i += 2u) {
+            retval.push_back(dvs[i] + dvs[i + 1u]);
+            retval.push_back(dvs[i] * dvs[i + 1u]);
+        }
+        if (m_wrong_size) {
+            retval.push_back(0.);
+        }
+        ++*m_counter;
+        return retval;
+    }
+    bool has_batch_fitness() const
+    {
+        return m_has_batch_fitness;
+    }
+    bool m_has_batch_fitness = true;
+    bool m_wrong_size = false;
+    std::shared_ptr<int> m_counter = std::make_shared<int>(0);
+};
+
+// A problem implementing also the raw fitness() overload.
+struct rf_p {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + x[1], x[0] * x[1]};
+    }
+    void fitness(const double *x, double *f) const
+    {
+        f[0] = x[0] + x[1];
+        f[1] = x[0] * x[1];
+        ++*m_counter;
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0, 0}, {1, 1}};
+    }
+    std::shared_ptr<int> m_counter = std::make_shared<int>(0);
+};
+
+BOOST_AUTO_TEST_CASE(problem_raw_fitness_test)
+{
+    rf_p udp;
+    problem p0{udp};
+    // The vector-returning version uses the raw overload.
+    BOOST_CHECK((p0.fitness({2, 3}) == vector_double{5, 6}));
+    BOOST_CHECK_EQUAL(*udp.m_counter, 1);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 1u);
+    // In-place version, with and without enough capacity in the output.
+    vector_double f;
+    p0.fitness({2, 4}, f);
+    BOOST_CHECK((f == vector_double{6, 8}));
+    const auto f_data = f.data();
+    p0.fitness({3, 4}, f);
+    BOOST_CHECK((f == vector_double{7, 12}));
+    BOOST_CHECK(f.data() == f_data);
+    BOOST_CHECK_EQUAL(*udp.m_counter, 3);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 3u);
+    BOOST_CHECK_THROW(p0.fitness({1, 2, 3}, f), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 3u);
+    // Batch version.
+    BOOST_CHECK((p0.batch_fitness({1, 2, 3, 4}) == vector_double{3, 2, 7, 12}));
+    BOOST_CHECK_EQUAL(*udp.m_counter, 5);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 5u);
+    // In-place batch version: no reallocation if the capacity is large enough.
+    vector_double fvs(4);
+    const auto fvs_data = fvs.data();
+    p0.batch_fitness({3, 4, 1, 2}, fvs);
+    BOOST_CHECK((fvs == vector_double{7, 12, 3, 2}));
+    BOOST_CHECK(fvs.data() == fvs_data);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 7u);
+
+    // In-place version for a UDP without the raw overload.
+    problem p1{base_p{2, 2, 2, {12, 13, 14, 15, 16, 17}, {5, 5}, {10, 10}}};
+    p1.fitness({1, 2}, f);
+    BOOST_CHECK((f == vector_double{12, 13, 14, 15, 16, 17}));
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 1u);
+    problem p1_wrong_retval{base_p{2, 2, 2, {1, 1, 1}, {5, 5}, {10, 10}}};
+    BOOST_CHECK_THROW(p1_wrong_retval.fitness({3, 3}, f), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p1_wrong_retval.get_fevals(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(problem_batch_fitness_test)
+{
+    BOOST_CHECK(problem{bf_p{}}.has_batch_fitness());
+    BOOST_CHECK(!problem{base_p{}}.has_batch_fitness());
+    bf_p udp;
+    udp.m_has_batch_fitness = false;
+    BOOST_CHECK(!problem{udp}.has_batch_fitness());
+
+    // Batch evaluation via the UDP.
+    bf_p udp0;
+    problem p0{udp0};
+    BOOST_CHECK((p0.batch_fitness({1, 2, 3, 4, 5, 6}) == vector_double{3, 2, 7, 12, 11, 30}));
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 3u);
+    BOOST_CHECK_EQUAL(*udp0.m_counter, 1);
+    BOOST_CHECK(p0.batch_fitness({}).empty());
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 3u);
+    BOOST_CHECK_EQUAL(*udp0.m_counter, 2);
+
+    // Fallback on fitness() if batch evaluation is disabled.
+    problem p1{udp};
+    BOOST_CHECK((p1.batch_fitness({1, 2, 3, 4, 5, 6}) == vector_double{3, 2, 7, 12, 11, 30}));
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 3u);
+    BOOST_CHECK_EQUAL(*udp.m_counter, 0);
+
+    // Fallback on fitness() if batch evaluation is not implemented.
+    problem p2{base_p{2, 2, 2, {12, 13, 14, 15, 16, 17}, {5, 5}, {10, 10}}};
+    BOOST_CHECK((p2.batch_fitness({1, 2, 3, 4}) == vector_double{12, 13, 14, 15, 16, 17, 12, 13, 14, 15, 16, 17}));
+    BOOST_CHECK_EQUAL(p2.get_fevals(), 2u);
+
+    // In-place evaluation, via the UDP and via the fallback.
+    vector_double fvs{1, 2};
+    p0.batch_fitness({1, 2, 3, 4, 5, 6}, fvs);
+    BOOST_CHECK((fvs == vector_double{3, 2, 7, 12, 11, 30}));
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 6u);
+    p1.batch_fitness({1, 2, 3, 4}, fvs);
+    BOOST_CHECK((fvs == vector_double{3, 2, 7, 12}));
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 5u);
+    p1.batch_fitness({}, fvs);
+    BOOST_CHECK(fvs.empty());
+
+    // Error checking.
+    BOOST_CHECK_THROW(p0.batch_fitness({1, 2, 3}), std::invalid_argument);
+    BOOST_CHECK_THROW(p0.batch_fitness({1, 2, 3}, fvs), std::invalid_argument);
+    BOOST_CHECK_THROW(p2.batch_fitness({1}), std::invalid_argument);
+    problem p2_wrong_retval{base_p{2, 2, 2, {1, 1, 1}, {5, 5}, {10, 10}}};
+    BOOST_CHECK_THROW(p2_wrong_retval.batch_fitness({1, 2}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p2_wrong_retval.get_fevals(), 0u);
+    bf_p udp_wrong;
+    udp_wrong.m_wrong_size = true;
+    problem p0_wrong_retval{udp_wrong};
+    BOOST_CHECK_THROW(p0_wrong_retval.batch_fitness({1, 2}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p0_wrong_retval.get_fevals(), 0u);
+}
+
 BOOST_AUTO_TEST_CASE(problem_gradient_test)
 {
     problem p1{grad_p{1, 0, 0, {12}, {5, 5}, {10, 10}, {12, 13}, {{0, 0}, {0, 1}}}};
@@ -745,6 +904,104 @@ BOOST_AUTO_TEST_CASE(problem_serialization_test)
     BOOST_CHECK(p.extract<full_p>()->m_ub == p2.extract<full_p>()->m_ub);
 }
 
+BOOST_AUTO_TEST_CASE(problem_concurrent_counters_test)
+{
+    // The counters must be exact when the same problem is used from multiple threads.
+    problem p{full_p{}};
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&p]() {
+            for (auto j = 0; j < 1000; ++j) {
+                p.fitness({1.});
+                p.batch_fitness({1., 1.});
+                p.gradient({1.});
+                p.hessians({1.});
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(p.get_fevals(), 12000u);
+    BOOST_CHECK_EQUAL(p.get_gevals(), 4000u);
+    BOOST_CHECK_EQUAL(p.get_hevals(), 4000u);
+}
+
+BOOST_AUTO_TEST_CASE(problem_latency_tracking_test)
+{
+    problem p{full_p{}};
+    BOOST_CHECK(!p.get_latency_tracking());
+    p.fitness({1.});
+    BOOST_CHECK_EQUAL(p.get_fitness_latency().get_count(), 0u);
+    BOOST_CHECK(boost::lexical_cast<std::string>(p).find("latency") == std::string::npos);
+    p.set_latency_tracking(true);
+    BOOST_CHECK(p.get_latency_tracking());
+    p.fitness({1.});
+    vector_double f;
+    p.fitness({1.}, f);
+    p.batch_fitness({1., 1., 1.});
+    p.gradient({1.});
+    p.hessians({1.});
+    p.hessians({1.});
+    BOOST_CHECK_EQUAL(p.get_fitness_latency().get_count(), 5u);
+    BOOST_CHECK_EQUAL(p.get_gradient_latency().get_count(), 1u);
+    BOOST_CHECK_EQUAL(p.get_hessians_latency().get_count(), 2u);
+    BOOST_CHECK(boost::lexical_cast<std::string>(p).find("Fitness latency: Number of calls: 5") != std::string::npos);
+    // Failed evaluations are recorded as well.
+    problem p_wrong{base_p{1, 0, 0, {1, 1}}};
+    p_wrong.set_latency_tracking(true);
+    BOOST_CHECK_THROW(p_wrong.fitness({1}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p_wrong.get_fitness_latency().get_count(), 1u);
+    BOOST_CHECK_EQUAL(p_wrong.get_fevals(), 0u);
+    // Enabling again has no effect.
+    p.set_latency_tracking(true);
+    BOOST_CHECK_EQUAL(p.get_fitness_latency().get_count(), 5u);
+    // Copy, move and serialization.
+    auto p2(p);
+    BOOST_CHECK(p2.get_latency_tracking());
+    BOOST_CHECK_EQUAL(p2.get_hessians_latency().get_count(), 2u);
+    p2.fitness({1.});
+    BOOST_CHECK_EQUAL(p2.get_fitness_latency().get_count(), 6u);
+    BOOST_CHECK_EQUAL(p.get_fitness_latency().get_count(), 5u);
+    auto p3(std::move(p2));
+    BOOST_CHECK_EQUAL(p3.get_fitness_latency().get_count(), 6u);
+    p2 = p;
+    BOOST_CHECK_EQUAL(p2.get_fitness_latency().get_count(), 5u);
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(p3);
+    }
+    problem p4;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(p4);
+    }
+    BOOST_CHECK(p4.get_latency_tracking());
+    BOOST_CHECK_EQUAL(p4.get_fevals(), 7u);
+    BOOST_CHECK_EQUAL(p4.get_fitness_latency().get_count(), 6u);
+    BOOST_CHECK(p4.get_fitness_latency().get_counts() == p3.get_fitness_latency().get_counts());
+    BOOST_CHECK(p4.get_fitness_latency().get_total() == p3.get_fitness_latency().get_total());
+    BOOST_CHECK_EQUAL(p4.get_gradient_latency().get_count(), 1u);
+    // Disabling discards the data.
+    p4.set_latency_tracking(false);
+    BOOST_CHECK(!p4.get_latency_tracking());
+    BOOST_CHECK_EQUAL(p4.get_fitness_latency().get_count(), 0u);
+    p4.set_latency_tracking(true);
+    BOOST_CHECK_EQUAL(p4.get_fitness_latency().get_count(), 0u);
+    // A problem without latency tracking round-trips as well.
+    std::stringstream ss2;
+    {
+        cereal::JSONOutputArchive oarchive(ss2);
+        oarchive(problem{full_p{}});
+    }
+    {
+        cereal::JSONInputArchive iarchive(ss2);
+        iarchive(p4);
+    }
+    BOOST_CHECK(!p4.get_latency_tracking());
+}
+
 // Full minimal problems to test constraints number
 // Only equality
 struct c_01 {
@@ -1332,4 +1589,97 @@ BOOST_AUTO_TEST_CASE(minlp_test)
     BOOST_CHECK((problem{minlp{3u}}.get_ncx() == 0u));
     BOOST_CHECK((problem{minlp{3u}}.get_nx() == 3u));
     BOOST_CHECK_THROW(problem{minlp{5u}}, std::invalid_argument);
-}
\ No newline at end of file
+}
+struct cow_p {
+    cow_p() = default;
+    cow_p(const cow_p &other) : m_seed(other.m_seed)
+    {
+        ++n_copies;
+    }
+    cow_p(cow_p &&) = default;
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + m_seed};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    void set_seed(unsigned seed)
+    {
+        m_seed = seed;
+    }
+    template <typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(m_seed);
+    }
+    unsigned m_seed = 0;
+    static unsigned n_copies;
+};
+
+unsigned cow_p::n_copies = 0;
+
+PAGMO_REGISTER_PROBLEM(cow_p)
+
+BOOST_AUTO_TEST_CASE(copy_on_write_test)
+{
+    problem p{cow_p{}};
+    BOOST_CHECK(!p.get_copy_on_write());
+    cow_p::n_copies = 0;
+    // Without copy-on-write, copies clone the UDP.
+    problem p0{p};
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 1u);
+    BOOST_CHECK(p0.extract<cow_p>() != p.extract<cow_p>());
+    // With copy-on-write, copies share the UDP.
+    p.set_copy_on_write(true);
+    cow_p::n_copies = 0;
+    problem p1{p}, p2;
+    p2 = p1;
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 0u);
+    BOOST_CHECK(p1.get_copy_on_write());
+    BOOST_CHECK(static_cast<const problem &>(p1).extract<cow_p>() == static_cast<const problem &>(p).extract<cow_p>());
+    BOOST_CHECK(static_cast<const problem &>(p2).extract<cow_p>() == static_cast<const problem &>(p).extract<cow_p>());
+    // Counters are per-copy.
+    p1.fitness({0.5});
+    p1.fitness({0.5});
+    p2.fitness({0.5});
+    BOOST_CHECK_EQUAL(p.get_fevals(), 0u);
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 2u);
+    BOOST_CHECK_EQUAL(p2.get_fevals(), 1u);
+    // Mutation clones the UDP, and only the mutated problem sees the change.
+    p1.set_seed(3u);
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 1u);
+    BOOST_CHECK_EQUAL(p1.fitness({0.5})[0], 3.5);
+    BOOST_CHECK_EQUAL(p2.fitness({0.5})[0], 0.5);
+    BOOST_CHECK_EQUAL(p.fitness({0.5})[0], 0.5);
+    BOOST_CHECK(static_cast<const problem &>(p2).extract<cow_p>() == static_cast<const problem &>(p).extract<cow_p>());
+    // Mutable extraction clones as well.
+    p2.extract<cow_p>()->m_seed = 4u;
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 2u);
+    BOOST_CHECK_EQUAL(p2.fitness({0.5})[0], 4.5);
+    BOOST_CHECK_EQUAL(p.fitness({0.5})[0], 0.5);
+    // An unshared UDP is not cloned on mutation.
+    p1.set_seed(5u);
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 2u);
+    // Disabling copy-on-write stops the sharing.
+    problem p3{p};
+    p3.set_copy_on_write(false);
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 3u);
+    BOOST_CHECK(static_cast<const problem &>(p3).extract<cow_p>() != static_cast<const problem &>(p).extract<cow_p>());
+    problem p4{p3};
+    BOOST_CHECK_EQUAL(cow_p::n_copies, 4u);
+    // The flag is serialized.
+    std::stringstream ss;
+    {
+        cereal::BinaryOutputArchive oarchive(ss);
+        oarchive(p);
+    }
+    problem p5;
+    {
+        cereal::BinaryInputArchive iarchive(ss);
+        iarchive(p5);
+    }
+    BOOST_CHECK(p5.get_copy_on_write());
+    BOOST_CHECK_EQUAL(p5.fitness({0.5})[0], 0.5);
+}
@@ -75,6 +75,93 @@ BOOST_AUTO_TEST_CASE(has_fitness_test)
     BOOST_CHECK((has_fitness<f_05>::value));
 }
 
+struct rf_00 {
+};
+
+// The good one.
+struct rf_01 {
+    void fitness(const double *, double *) const;
+};
+
+struct rf_02 {
+    void fitness(const double *, double *);
+};
+
+struct rf_03 {
+    void fitness(double *, double *) const;
+};
+
+struct rf_04 {
+    double fitness(const double *, double *) const;
+};
+
+struct rf_05 {
+    vector_double fitness(const vector_double &) const;
+};
+
+BOOST_AUTO_TEST_CASE(has_raw_fitness_test)
+{
+    BOOST_CHECK((!has_raw_fitness<rf_00>::value));
+    BOOST_CHECK((has_raw_fitness<rf_01>::value));
+    BOOST_CHECK((!has_raw_fitness<rf_02>::value));
+    BOOST_CHECK((!has_raw_fitness<rf_03>::value));
+    BOOST_CHECK((!has_raw_fitness<rf_04>::value));
+    BOOST_CHECK((!has_raw_fitness<rf_05>::value));
+}
+
+struct bf_00 {
+};
+
+// The good one.
+struct bf_01 {
+    vector_double batch_fitness(const vector_double &) const;
+};
+
+struct bf_02 {
+    vector_double batch_fitness(const vector_double &);
+};
+
+struct bf_03 {
+    vector_double batch_fitness(vector_double &) const;
+};
+
+struct bf_04 {
+    void batch_fitness(const vector_double &) const;
+};
+
+BOOST_AUTO_TEST_CASE(has_batch_fitness_test)
+{
+    BOOST_CHECK((!has_batch_fitness<bf_00>::value));
+    BOOST_CHECK((has_batch_fitness<bf_01>::value));
+    BOOST_CHECK((!has_batch_fitness<bf_02>::value));
+    BOOST_CHECK((!has_batch_fitness<bf_03>::value));
+    BOOST_CHECK((!has_batch_fitness<bf_04>::value));
+}
+
+struct ov_bf_00 {
+};
+
+// The good one.
+struct ov_bf_01 {
+    bool has_batch_fitness() const;
+};
+
+struct ov_bf_02 {
+    bool has_batch_fitness();
+};
+
+struct ov_bf_03 {
+    void has_batch_fitness() const;
+};
+
+BOOST_AUTO_TEST_CASE(override_has_batch_fitness_test)
+{
+    BOOST_CHECK((!override_has_batch_fitness<ov_bf_00>::value));
+    BOOST_CHECK((override_has_batch_fitness<ov_bf_01>::value));
+    BOOST_CHECK((!override_has_batch_fitness<ov_bf_02>::value));
+    BOOST_CHECK((!override_has_batch_fitness<ov_bf_03>::value));
+}
+
 // No fitness.
 struct no_00 {
 };
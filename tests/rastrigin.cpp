@@ -37,7 +37,9 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/rastrigin.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/types.hpp>
+#include <pagmo/utils/generic.hpp>
 
 using namespace pagmo;
 
@@ -54,6 +56,13 @@ BOOST_AUTO_TEST_CASE(rastrigin_test)
     // Fitness test
     BOOST_CHECK((ras1.fitness(x1) == vector_double{1.}));
     BOOST_CHECK((ras5.fitness(x5) == vector_double{5.}));
+    // Raw fitness test
+    vector_double y5 = {.1, -.2, .3, -.4, 4.5}, f(1);
+    ras5.fitness(y5.data(), f.data());
+    BOOST_CHECK((f == ras5.fitness(y5)));
+    BOOST_CHECK((problem{ras5}.batch_fitness(y5) == ras5.fitness(y5)));
+    // The vector overload works on the size of its input.
+    BOOST_CHECK((ras5.fitness({.1, -.2}) == rastrigin{2u}.fitness({.1, -.2})));
     // Gradient test
     auto g1 = ras1.gradient(x1);
     auto g5 = ras5.gradient(x5);
@@ -108,3 +117,24 @@ BOOST_AUTO_TEST_CASE(rastrigin_serialization_test)
     auto after = boost::lexical_cast<std::string>(p);
     BOOST_CHECK_EQUAL(before, after);
 }
+
+BOOST_AUTO_TEST_CASE(rastrigin_batch_test)
+{
+    problem p{rastrigin{13u}};
+    BOOST_CHECK(p.has_batch_fitness());
+    detail::random_engine_type r_engine(42u);
+    // Cover full blocks, a partial block and an empty batch: the results
+    // must be bitwise identical to the scalar ones.
+    for (auto n_dvs : {0u, 1u, 8u, 21u}) {
+        vector_double dvs;
+        for (auto i = 0u; i < n_dvs; ++i) {
+            const auto dv = random_decision_vector(p.get_bounds(), r_engine);
+            dvs.insert(dvs.end(), dv.begin(), dv.end());
+        }
+        const auto fvs = p.batch_fitness(dvs);
+        BOOST_CHECK_EQUAL(fvs.size(), n_dvs);
+        for (auto i = 0u; i < n_dvs; ++i) {
+            BOOST_CHECK_EQUAL(fvs[i], p.fitness(vector_double(dvs.data() + i * 13u, dvs.data() + (i + 1u) * 13u))[0]);
+        }
+    }
+}
@@ -37,7 +37,9 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/types.hpp>
+#include <pagmo/utils/generic.hpp>
 
 using namespace pagmo;
 
@@ -55,6 +57,11 @@ BOOST_AUTO_TEST_CASE(rosenbrock_test)
     // Fitness test
     BOOST_CHECK((ros2.fitness({1., 1.}) == vector_double{0.}));
     BOOST_CHECK((ros5.fitness({1., 1., 1., 1., 1.}) == vector_double{0.}));
+    // Raw fitness test
+    vector_double y5 = {.1, -.2, .3, -.4, 4.5}, f(1);
+    ros5.fitness(y5.data(), f.data());
+    BOOST_CHECK((f == ros5.fitness(y5)));
+    BOOST_CHECK((problem{ros5}.batch_fitness(y5) == ros5.fitness(y5)));
     // Bounds Test
     BOOST_CHECK((ros2.get_bounds() == std::pair<vector_double, vector_double>{{-5., -5.}, {10., 10.}}));
     // Name and extra info tests
@@ -96,3 +103,24 @@ BOOST_AUTO_TEST_CASE(rosenbrock_serialization_test)
     auto after = boost::lexical_cast<std::string>(p);
     BOOST_CHECK_EQUAL(before, after);
 }
+
+BOOST_AUTO_TEST_CASE(rosenbrock_batch_test)
+{
+    problem p{rosenbrock{13u}};
+    BOOST_CHECK(p.has_batch_fitness());
+    detail::random_engine_type r_engine(42u);
+    // Cover full blocks, a partial block and an empty batch: the results
+    // must be bitwise identical to the scalar ones.
+    for (auto n_dvs : {0u, 1u, 8u, 21u}) {
+        vector_double dvs;
+        for (auto i = 0u; i < n_dvs; ++i) {
+            const auto dv = random_decision_vector(p.get_bounds(), r_engine);
+            dvs.insert(dvs.end(), dv.begin(), dv.end());
+        }
+        const auto fvs = p.batch_fitness(dvs);
+        BOOST_CHECK_EQUAL(fvs.size(), n_dvs);
+        for (auto i = 0u; i < n_dvs; ++i) {
+            BOOST_CHECK_EQUAL(fvs[i], p.fitness(vector_double(dvs.data() + i * 13u, dvs.data() + (i + 1u) * 13u))[0]);
+        }
+    }
+}
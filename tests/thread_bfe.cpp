@@ -0,0 +1,261 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE thread_bfe_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/serialization.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/generic.hpp>
+
+using namespace pagmo;
+
+// Generate n random decision vectors for the problem p, concatenated.
+static vector_double random_dvs(const problem &p, vector_double::size_type n, unsigned seed)
+{
+    detail::random_engine_type r_engine(seed);
+    vector_double retval;
+    for (decltype(n) i = 0; i < n; ++i) {
+        const auto dv = random_decision_vector(p.get_bounds(), r_engine);
+        retval.insert(retval.end(), dv.begin(), dv.end());
+    }
+    return retval;
+}
+
+// A problem with batch fitness evaluation.
+struct bf_p {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + x[1], x[0] * x[1]};
+    }
+    vector_double batch_fitness(const vector_double &dvs) const
+    {
+        vector_double retval;
+        for (decltype(dvs.size()) i = 0; i < dvs.size(); i += 2u) {
+            const auto f = fitness({dvs[i], dvs[i + 1u]});
+            retval.insert(retval.end(), f.begin(), f.end());
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1., -1.}, {1., 1.}};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+};
+
+// A problem recording the threads it is evaluated from.
+struct tid_p {
+    vector_double fitness(const vector_double &x) const
+    {
+        if (std::this_thread::get_id() != s_main_id) {
+            ++s_n_other;
+        }
+        if (x[0] < 0.) {
+            throw std::runtime_error("negative input");
+        }
+        return {x[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return m_ts;
+    }
+    thread_safety m_ts = thread_safety::basic;
+    static std::thread::id s_main_id;
+    static std::atomic<unsigned> s_n_other;
+};
+
+std::thread::id tid_p::s_main_id;
+std::atomic<unsigned> tid_p::s_n_other(0u);
+
+BOOST_AUTO_TEST_CASE(thread_bfe_construction_test)
+{
+    BOOST_CHECK(thread_bfe{}.get_n_threads() > 0u);
+    BOOST_CHECK_EQUAL(thread_bfe{3u}.get_n_threads(), 3u);
+    BOOST_CHECK(thread_bfe{}.get_name().find("Multi-threaded") != std::string::npos);
+    BOOST_CHECK(thread_bfe{5u}.get_extra_info().find("5") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(thread_bfe_evaluation_test)
+{
+    // Parallel results must match the serial ones exactly, for any number of threads
+    // (including more threads than decision vectors).
+    for (auto prob : {problem{rosenbrock{10u}}, problem{zdt{1u, 30u}}}) {
+        for (auto n_dvs : {0u, 1u, 2u, 7u, 100u}) {
+            const auto dvs = random_dvs(prob, n_dvs, 42u);
+            problem p_serial{prob};
+            const auto serial = p_serial.batch_fitness(dvs);
+            for (auto n_threads : {1u, 2u, 3u, 8u, 200u}) {
+                problem p{prob};
+                BOOST_CHECK(thread_bfe{n_threads}(p, dvs) == serial);
+                BOOST_CHECK_EQUAL(p.get_fevals(), n_dvs);
+            }
+        }
+    }
+
+    // In-place evaluation, for problems with and without batch fitness and raw fitness.
+    for (auto prob : {problem{rosenbrock{10u}}, problem{zdt{1u, 30u}}, problem{bf_p{}}}) {
+        const auto dvs = random_dvs(prob, 37u, 42u);
+        problem p_serial{prob};
+        const auto serial = p_serial.batch_fitness(dvs);
+        problem p{prob};
+        vector_double fvs{1., 2., 3.};
+        thread_bfe{4u}(p, dvs, fvs);
+        BOOST_CHECK(fvs == serial);
+        BOOST_CHECK_EQUAL(p.get_fevals(), 37u);
+    }
+
+    // Check which threads are used for the evaluation.
+    tid_p::s_main_id = std::this_thread::get_id();
+    tid_p udp;
+    problem p0{udp};
+    BOOST_CHECK((thread_bfe{4u}(p0, {.1, .2, .3, .4}) == vector_double{.1, .2, .3, .4}));
+    // NOTE: the calling thread takes part in the evaluation, thus, depending
+    // on the load of the pool, it might evaluate more than one chunk.
+    BOOST_CHECK(tid_p::s_n_other.load() <= 3u);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 4u);
+    // A thread-unsafe problem is evaluated in the calling thread.
+    tid_p::s_n_other.store(0u);
+    udp.m_ts = thread_safety::none;
+    problem p1{udp};
+    BOOST_CHECK((thread_bfe{4u}(p1, {.1, .2, .3, .4}) == vector_double{.1, .2, .3, .4}));
+    BOOST_CHECK_EQUAL(tid_p::s_n_other.load(), 0u);
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 4u);
+
+    // Error handling.
+    BOOST_CHECK_THROW(thread_bfe{4u}(p0, {.1, .2, -.3, .4}), std::runtime_error);
+    // NOTE: the first decision vector was successfully evaluated in the calling thread.
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 5u);
+    BOOST_CHECK_THROW(thread_bfe{4u}(p0, {-.1, .2, .3, .4}), std::runtime_error);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 5u);
+    BOOST_CHECK_THROW(thread_bfe{4u}(p1, {.1, .2, -.3, .4}), std::runtime_error);
+    BOOST_CHECK_EQUAL(p1.get_fevals(), 4u);
+    problem p2{rosenbrock{3u}};
+    BOOST_CHECK_THROW(thread_bfe{4u}(p2, {1., 2., 3., 4.}), std::invalid_argument);
+}
+
+// A problem whose fitness depends on its state.
+struct state_p {
+    vector_double fitness(const vector_double &x) const
+    {
+        return {x[0] + m_offset};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {10.}};
+    }
+    void set_seed(unsigned seed)
+    {
+        m_offset = seed;
+    }
+    double m_offset = 0.;
+};
+
+BOOST_AUTO_TEST_CASE(thread_bfe_pool_test)
+{
+    // The same evaluator is used repeatedly: the copies of the problem held
+    // by the pool must be refreshed whenever the problem changes.
+    thread_bfe bfe{3u};
+    problem p{state_p{}};
+    const vector_double dvs{1., 2., 3., 4., 5., 6.};
+    BOOST_CHECK(bfe(p, dvs) == dvs);
+    BOOST_CHECK(bfe(p, dvs) == dvs);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 12u);
+    p.extract<state_p>()->m_offset = 10.;
+    BOOST_CHECK((bfe(p, dvs) == vector_double{11., 12., 13., 14., 15., 16.}));
+    p.set_seed(20u);
+    BOOST_CHECK((bfe(p, dvs) == vector_double{21., 22., 23., 24., 25., 26.}));
+    // A copy of the problem can use the cached copies.
+    problem p_copy{p};
+    BOOST_CHECK((bfe(p_copy, dvs) == vector_double{21., 22., 23., 24., 25., 26.}));
+    // A different problem.
+    state_p udp;
+    udp.m_offset = 30.;
+    problem p2{udp};
+    BOOST_CHECK((bfe(p2, dvs) == vector_double{31., 32., 33., 34., 35., 36.}));
+    BOOST_CHECK_EQUAL(p2.get_fevals(), 6u);
+    // Copies of the evaluator start with a fresh pool.
+    auto bfe_copy(bfe);
+    BOOST_CHECK_EQUAL(bfe_copy.get_n_threads(), 3u);
+    BOOST_CHECK(bfe_copy(p, dvs) == bfe(p, dvs));
+    // Concurrent invocations on the same evaluator.
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> n_ok(0u);
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&bfe, &p2, &dvs, &n_ok]() {
+            problem p_local{p2};
+            for (auto j = 0; j < 20; ++j) {
+                if (bfe(p_local, dvs) == vector_double{31., 32., 33., 34., 35., 36.}) {
+                    ++n_ok;
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(n_ok.load(), 80u);
+}
+
+BOOST_AUTO_TEST_CASE(thread_bfe_serialization_test)
+{
+    thread_bfe bfe{7u};
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(bfe);
+    }
+    bfe = thread_bfe{};
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(bfe);
+    }
+    BOOST_CHECK_EQUAL(bfe.get_n_threads(), 7u);
+}
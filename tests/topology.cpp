@@ -0,0 +1,224 @@
+/* Copyright 2017-2018 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE topology_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/serialization.hpp>
+#include <pagmo/topologies/free_form.hpp>
+#include <pagmo/topologies/fully_connected.hpp>
+#include <pagmo/topologies/k_regular.hpp>
+#include <pagmo/topologies/ring.hpp>
+#include <pagmo/topology.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+struct udt_bad_sizes {
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t) const
+    {
+        return {{0u, 1u}, {1.}};
+    }
+    void push_back() {}
+};
+
+struct udt_bad_weight {
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t) const
+    {
+        return {{0u}, {1.5}};
+    }
+    void push_back() {}
+};
+
+struct no_push_back {
+    std::pair<std::vector<std::size_t>, vector_double> get_connections(std::size_t) const
+    {
+        return {};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(topology_type_traits)
+{
+    BOOST_CHECK(is_udt<unconnected>::value);
+    BOOST_CHECK(is_udt<ring>::value);
+    BOOST_CHECK(is_udt<fully_connected>::value);
+    BOOST_CHECK(is_udt<free_form>::value);
+    BOOST_CHECK(is_udt<k_regular>::value);
+    BOOST_CHECK(is_udt<udt_bad_sizes>::value);
+    BOOST_CHECK(!is_udt<no_push_back>::value);
+    BOOST_CHECK(!is_udt<const ring>::value);
+    BOOST_CHECK(!is_udt<int>::value);
+}
+
+BOOST_AUTO_TEST_CASE(topology_basic)
+{
+    topology t;
+    BOOST_CHECK(t.is<unconnected>());
+    BOOST_CHECK(!t.is<ring>());
+    BOOST_CHECK_EQUAL(t.get_name(), "Unconnected");
+    BOOST_CHECK(t.get_connections(42).first.empty());
+    t = topology{ring{3u, .5}};
+    BOOST_CHECK(t.is<ring>());
+    BOOST_CHECK_EQUAL(t.extract<ring>()->num_vertices(), 3u);
+    t.push_back(2u);
+    BOOST_CHECK_EQUAL(t.extract<ring>()->num_vertices(), 5u);
+    auto t2(t);
+    BOOST_CHECK(t2.is<ring>());
+    BOOST_CHECK_EQUAL(t2.get_extra_info(), t.get_extra_info());
+    std::ostringstream oss;
+    oss << t;
+    BOOST_CHECK(oss.str().find("Ring") != std::string::npos);
+    BOOST_CHECK(oss.str().find("Number of vertices: 5") != std::string::npos);
+    // Checks on the output of the UDT.
+    BOOST_CHECK_THROW(topology{udt_bad_sizes{}}.get_connections(0), std::invalid_argument);
+    BOOST_CHECK_THROW(topology{udt_bad_weight{}}.get_connections(0), std::invalid_argument);
+    // Serialization.
+    std::stringstream ss;
+    {
+        cereal::JSONOutputArchive oarchive(ss);
+        oarchive(t);
+    }
+    topology t3;
+    {
+        cereal::JSONInputArchive iarchive(ss);
+        iarchive(t3);
+    }
+    BOOST_CHECK(t3.is<ring>());
+    BOOST_CHECK_EQUAL(t3.get_extra_info(), t.get_extra_info());
+}
+
+BOOST_AUTO_TEST_CASE(topology_ring)
+{
+    BOOST_CHECK_THROW(ring(0u, -1.), std::invalid_argument);
+    BOOST_CHECK_THROW(ring(0u, 2.), std::invalid_argument);
+    ring r;
+    BOOST_CHECK_THROW(r.get_connections(0), std::invalid_argument);
+    r.push_back();
+    BOOST_CHECK(r.get_connections(0).first.empty());
+    r.push_back();
+    BOOST_CHECK((r.get_connections(0).first == std::vector<std::size_t>{1u}));
+    r.push_back();
+    r.push_back();
+    BOOST_CHECK((r.get_connections(0).first == std::vector<std::size_t>{3u, 1u}));
+    BOOST_CHECK((r.get_connections(2).first == std::vector<std::size_t>{1u, 3u}));
+    BOOST_CHECK((r.get_connections(3).first == std::vector<std::size_t>{2u, 0u}));
+    BOOST_CHECK((r.get_connections(3).second == vector_double{1., 1.}));
+}
+
+BOOST_AUTO_TEST_CASE(topology_fully_connected)
+{
+    fully_connected fc{4u, .25};
+    BOOST_CHECK((fc.get_connections(2).first == std::vector<std::size_t>{0u, 1u, 3u}));
+    BOOST_CHECK((fc.get_connections(2).second == vector_double{.25, .25, .25}));
+    BOOST_CHECK_THROW(fc.get_connections(4), std::invalid_argument);
+    fc.push_back();
+    BOOST_CHECK_EQUAL(fc.get_connections(4).first.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(topology_free_form)
+{
+    free_form ff{3u};
+    BOOST_CHECK(ff.get_connections(0).first.empty());
+    ff.add_edge(1, 0);
+    ff.add_edge(2, 0, .5);
+    BOOST_CHECK((ff.get_connections(0).first == std::vector<std::size_t>{1u, 2u}));
+    BOOST_CHECK((ff.get_connections(0).second == vector_double{1., .5}));
+    BOOST_CHECK(ff.get_connections(1).first.empty());
+    BOOST_CHECK_THROW(ff.add_edge(1, 0), std::invalid_argument);
+    BOOST_CHECK_THROW(ff.add_edge(1, 1), std::invalid_argument);
+    BOOST_CHECK_THROW(ff.add_edge(0, 1, -.1), std::invalid_argument);
+    BOOST_CHECK_THROW(ff.get_connections(3), std::invalid_argument);
+    // Edges between vertices which have not been added yet.
+    ff.add_edge(3, 1);
+    ff.add_edge(1, 4);
+    BOOST_CHECK(ff.get_connections(1).first.empty());
+    ff.push_back();
+    BOOST_CHECK((ff.get_connections(1).first == std::vector<std::size_t>{3u}));
+    BOOST_CHECK(ff.get_connections(3).first.empty());
+    ff.push_back();
+    BOOST_CHECK((ff.get_connections(4).first == std::vector<std::size_t>{1u}));
+    BOOST_CHECK_EQUAL(ff.num_vertices(), 5u);
+    BOOST_CHECK(topology{ff}.get_extra_info().find("Number of edges: 4") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(topology_k_regular)
+{
+    for (auto k : {0u, 1u, 2u, 5u, 20u}) {
+        for (auto n : {1u, 2u, 7u, 10u}) {
+            k_regular kr{n, k, 1., 42u};
+            const auto deg = std::min<std::size_t>(k, n - 1u);
+            std::vector<std::size_t> out_deg(n, 0u);
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto c = kr.get_connections(i);
+                BOOST_CHECK_EQUAL(c.first.size(), deg);
+                // No self-loops, no duplicate edges.
+                std::set<std::size_t> srcs(c.first.begin(), c.first.end());
+                BOOST_CHECK_EQUAL(srcs.size(), deg);
+                BOOST_CHECK(srcs.count(i) == 0u);
+                for (auto s : c.first) {
+                    ++out_deg[s];
+                }
+            }
+            for (auto d : out_deg) {
+                BOOST_CHECK_EQUAL(d, deg);
+            }
+        }
+    }
+    // Determinism and push_back().
+    k_regular kr1{5u, 2u, 1., 3u}, kr2{5u, 2u, 1., 3u};
+    for (std::size_t i = 0; i < 5u; ++i) {
+        BOOST_CHECK(kr1.get_connections(i) == kr2.get_connections(i));
+    }
+    kr1.push_back();
+    BOOST_CHECK_EQUAL(kr1.num_vertices(), 6u);
+    BOOST_CHECK_EQUAL(kr1.get_connections(5).first.size(), 2u);
+    // Serialization preserves the graph.
+    topology t{kr1};
+    std::stringstream ss;
+    {
+        cereal::BinaryOutputArchive oarchive(ss);
+        oarchive(t);
+    }
+    topology t2;
+    {
+        cereal::BinaryInputArchive iarchive(ss);
+        iarchive(t2);
+    }
+    for (std::size_t i = 0; i < 6u; ++i) {
+        BOOST_CHECK(t.get_connections(i) == t2.get_connections(i));
+    }
+}